@@ -0,0 +1,82 @@
+"""
+Compares the time taken to load a spike file with the original line-by-line\
+parser, the chunked text parser and the binary spike file format
+"""
+import os
+import shutil
+import tempfile
+import time
+import unittest
+import numpy
+from spynnaker.pyNN.utilities import spike_file
+
+N_NEURONS = 1000
+N_SPIKES = 1000000
+RUN_TIME = 10000.0
+
+
+def read_spikes_line_by_line(file_path, min_atom, max_atom, min_time,
+                             max_time, split_value="\t"):
+    """ The original parser, which evaluates each value of each line
+    """
+    with open(file_path, 'r') as fsource:
+        read_data = fsource.readlines()
+
+    data = dict()
+    for line in read_data:
+        if not line.startswith('#'):
+            values = line.split(split_value)
+            time_value = float(eval(values[0]))
+            neuron_id = int(eval(values[1]))
+            if (min_atom <= neuron_id < max_atom and
+                    min_time <= time_value < max_time):
+                if neuron_id not in data:
+                    data[neuron_id] = list()
+                data[neuron_id].append(time_value)
+    return [data.get(neuron_id, list()) for neuron_id in range(max_atom)]
+
+
+class TestSpikeFileLoading(unittest.TestCase):
+
+    def test_spike_file_loading(self):
+        directory = tempfile.mkdtemp()
+        try:
+            text_path = os.path.join(directory, "spikes.txt")
+            binary_path = os.path.join(directory, "spikes.bin")
+            times = numpy.random.uniform(0, RUN_TIME, N_SPIKES)
+            neurons = numpy.random.randint(0, N_NEURONS, N_SPIKES)
+            numpy.savetxt(
+                text_path, numpy.column_stack((times, neurons)),
+                fmt=["%.1f", "%d"], delimiter="\t")
+
+            args = (0, N_NEURONS // 2, 0.0, RUN_TIME / 2)
+            start = time.time()
+            expected = read_spikes_line_by_line(text_path, *args)
+            print "line by line: {:.2f}s".format(time.time() - start)
+
+            start = time.time()
+            from_text = spike_file.read_spikes(text_path, *args)
+            print "chunked text: {:.2f}s".format(time.time() - start)
+
+            start = time.time()
+            spike_file.convert_spike_file_to_binary(text_path, binary_path)
+            print "conversion to binary: {:.2f}s".format(time.time() - start)
+
+            start = time.time()
+            from_binary = spike_file.read_spikes(binary_path, *args)
+            print "binary: {:.2f}s".format(time.time() - start)
+
+            print "file sizes: text {} bytes, binary {} bytes".format(
+                os.path.getsize(text_path), os.path.getsize(binary_path))
+
+            for neuron_id in range(N_NEURONS // 2):
+                self.assertEqual(
+                    list(from_text[neuron_id]), expected[neuron_id])
+                self.assertEqual(
+                    list(from_binary[neuron_id]), expected[neuron_id])
+        finally:
+            shutil.rmtree(directory)
+
+
+if __name__ == '__main__':
+    unittest.main()
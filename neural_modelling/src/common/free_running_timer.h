@@ -0,0 +1,42 @@
+/*! \file
+ *
+ *  \brief use of timer 2 as a free-running counter for measuring times in
+ *         CPU clock cycles
+ *
+ *  \details Timer 1 is used by the spin1 API for the timer tick, which leaves
+ *           timer 2 free.  It is set to count down from UINT32_MAX, wrapping
+ *           around, so the number of cycles between two reads is always the
+ *           earlier value minus the later value, as long as they are less
+ *           than 2^32 cycles apart.
+ */
+
+#ifndef _FREE_RUNNING_TIMER_H_
+#define _FREE_RUNNING_TIMER_H_
+
+#include <spin1_api.h>
+
+//! Control value for timer 2: enabled, free-running, 32-bit, no prescale
+#define FREE_RUNNING_TIMER_CONTROL 0x82
+
+//! \brief starts timer 2 counting; it is safe to call this more than once
+static inline void free_running_timer_start() {
+    if (tc[T2_CONTROL] != FREE_RUNNING_TIMER_CONTROL) {
+        tc[T2_LOAD] = UINT32_MAX;
+        tc[T2_CONTROL] = FREE_RUNNING_TIMER_CONTROL;
+    }
+}
+
+//! \brief reads the current value of the timer
+//! \return the current timer value
+static inline uint32_t free_running_timer_now() {
+    return tc[T2_COUNT];
+}
+
+//! \brief gets the number of cycles since an earlier timer value
+//! \param[in] start The earlier timer value
+//! \return The number of cycles since the timer had the value start
+static inline uint32_t free_running_timer_elapsed(uint32_t start) {
+    return start - tc[T2_COUNT];
+}
+
+#endif // _FREE_RUNNING_TIMER_H_
@@ -1,41 +1,146 @@
+/*! \file
+ *
+ *  \brief the buffer of spikes received and waiting to be processed
+ *
+ *  \details The buffer is a single-producer, single-consumer ring: spikes are
+ *  only added by the packet received callback, which can interrupt the
+ *  consumer, and only taken by the spike processing callbacks, which can't
+ *  interrupt the producer.  Each side only writes its own index, and the
+ *  producer makes a spike visible by advancing the input index after
+ *  writing it, so neither side needs to disable interrupts.
+ *
+ *  The indices run freely and are masked to index the buffer, whose size is
+ *  a power of two; the number of spikes in the buffer is the difference of
+ *  the indices, so the whole buffer can be used.
+ */
+
 #ifndef _IN_SPIKES_H_
 #define _IN_SPIKES_H_
 
 #include "neuron-typedefs.h"
-#include <circular_buffer.h>
+#include <debug.h>
+#include <spin1_api.h>
+
+//! Stops the compiler from moving memory accesses across this point
+#define in_spikes_barrier() __asm__ volatile("" ::: "memory")
+
+typedef struct in_spikes_ring_t {
+
+    //! The number of spikes ever added; only written by the producer
+    volatile uint32_t input;
+
+    //! The number of spikes ever taken; only written by the consumer
+    volatile uint32_t output;
 
-static circular_buffer buffer;
+    //! The size of the buffer, a power of two, and the mask of an index
+    uint32_t size;
+    uint32_t mask;
+
+    //! The number of spikes that could not be added; only written by the
+    //! producer
+    uint32_t n_overflows;
+
+    spike_t *buffer;
+} in_spikes_ring_t;
+
+static in_spikes_ring_t in_spikes_ring;
 
 // initialize_spike_buffer
 //
-// This function initializes the input spike buffer.
-// It configures:
-//    buffer:     the buffer to hold the spikes (initialized with size spaces)
-//    input:      index for next spike inserted into buffer
-//    output:     index for next spike extracted from buffer
-//    overflows:  a counter for the number of times the buffer overflows
-//    underflows: a counter for the number of times the buffer underflows
-//
-// If underflows is ever non-zero, then there is a problem with this code.
+// This function initializes the input spike buffer, which holds at least
+// size spikes, rounded up to a power of two.
 static inline bool in_spikes_initialize_spike_buffer(uint32_t size) {
-    buffer = circular_buffer_initialize(size);
-    return buffer != 0;
+    uint32_t ring_size = 1;
+    while (ring_size < size) {
+        ring_size <<= 1;
+    }
+    in_spikes_ring.buffer = (spike_t *) spin1_malloc(
+        ring_size * sizeof(spike_t));
+    if (in_spikes_ring.buffer == NULL) {
+        return false;
+    }
+    in_spikes_ring.input = 0;
+    in_spikes_ring.output = 0;
+    in_spikes_ring.size = ring_size;
+    in_spikes_ring.mask = ring_size - 1;
+    in_spikes_ring.n_overflows = 0;
+    return true;
 }
 
+//! \brief adds a spike to the buffer; only to be called by the producer
+//! \return True if the spike was added, False if the buffer was full
 static inline bool in_spikes_add_spike(spike_t spike) {
-    return circular_buffer_add(buffer, spike);
+    uint32_t input = in_spikes_ring.input;
+    if ((input - in_spikes_ring.output) >= in_spikes_ring.size) {
+        in_spikes_ring.n_overflows += 1;
+        return false;
+    }
+    in_spikes_ring.buffer[input & in_spikes_ring.mask] = spike;
+
+    // The spike must be written before the consumer can see it
+    in_spikes_barrier();
+    in_spikes_ring.input = input + 1;
+    return true;
 }
 
+//! \brief takes the next spike from the buffer; only to be called by the
+//!        consumer
+//! \return True if there was a spike, False if the buffer was empty
 static inline bool in_spikes_get_next_spike(spike_t* spike) {
-    return circular_buffer_get_next(buffer, spike);
+    uint32_t output = in_spikes_ring.output;
+    if (output == in_spikes_ring.input) {
+        return false;
+    }
+
+    // The spike must not be read before the input index that shows it
+    in_spikes_barrier();
+    *spike = in_spikes_ring.buffer[output & in_spikes_ring.mask];
+
+    // The spike must be read before the producer can overwrite it
+    in_spikes_barrier();
+    in_spikes_ring.output = output + 1;
+    return true;
 }
 
+//! \brief takes the next spike from the buffer if it is equal to the given
+//!        spike; only to be called by the consumer
+//! \return True if the next spike was equal and has been taken
 static inline bool in_spikes_is_next_spike_equal(spike_t spike) {
-    return circular_buffer_advance_if_next_equals(buffer, spike);
+    uint32_t output = in_spikes_ring.output;
+    if (output == in_spikes_ring.input) {
+        return false;
+    }
+    in_spikes_barrier();
+    if (in_spikes_ring.buffer[output & in_spikes_ring.mask] != spike) {
+        return false;
+    }
+    in_spikes_barrier();
+    in_spikes_ring.output = output + 1;
+    return true;
+}
+
+//! \brief gets the number of spikes ever added to the buffer
+static inline uint32_t in_spikes_get_n_added() {
+    return in_spikes_ring.input;
+}
+
+//! \brief gets the number of spikes ever taken from the buffer
+static inline uint32_t in_spikes_get_n_taken() {
+    return in_spikes_ring.output;
+}
+
+//! \brief gets the number of spikes in the buffer
+static inline uint32_t in_spikes_get_n_spikes() {
+    return in_spikes_ring.input - in_spikes_ring.output;
+}
+
+//! \brief determines if the buffer is empty
+static inline bool in_spikes_is_empty() {
+    return in_spikes_ring.output == in_spikes_ring.input;
 }
 
 static inline counter_t in_spikes_get_n_buffer_overflows() {
-    return circular_buffer_get_n_buffer_overflows(buffer);
+    return in_spikes_ring.n_overflows;
 }
 
 static inline counter_t in_spikes_get_n_buffer_underflows() {
@@ -43,7 +148,12 @@ static inline counter_t in_spikes_get_n_buffer_underflows() {
 }
 
 static inline void in_spikes_print_buffer() {
-    circular_buffer_print_buffer(buffer);
+    uint32_t output = in_spikes_ring.output;
+    uint32_t input = in_spikes_ring.input;
+    log_info("In spikes: %u of %u", input - output, in_spikes_ring.size);
+    for (; output != input; output++) {
+        log_info("0x%08x", in_spikes_ring.buffer[output & in_spikes_ring.mask]);
+    }
 }
 
 #endif // _IN_SPIKES_H_
@@ -0,0 +1,59 @@
+/*! \file
+ *
+ *  \brief compact histograms with power-of-two sized bins, used to record
+ *         distributions of times in provenance data
+ *
+ *  \details Bin 0 counts values of 0, bin n counts values in the range
+ *           [2^(n-1), 2^n) and the last bin also counts anything bigger.  The
+ *           bin is found with a single count-leading-zeros instruction, so
+ *           adding a value is cheap enough to do in the inner loops.
+ */
+
+#ifndef _LOG2_HISTOGRAM_H_
+#define _LOG2_HISTOGRAM_H_
+
+#include <common-typedefs.h>
+
+//! The number of bins in each histogram
+#define LOG2_HISTOGRAM_N_BINS 16
+
+typedef struct log2_histogram_t {
+    uint32_t bins[LOG2_HISTOGRAM_N_BINS];
+} log2_histogram_t;
+
+//! \brief clears all the bins of a histogram
+//! \param[in] histogram The histogram to clear
+static inline void log2_histogram_clear(log2_histogram_t *histogram) {
+    for (uint32_t i = 0; i < LOG2_HISTOGRAM_N_BINS; i++) {
+        histogram->bins[i] = 0;
+    }
+}
+
+//! \brief adds a value to a histogram
+//! \param[in] histogram The histogram to add to
+//! \param[in] value The value to count
+static inline void log2_histogram_add(
+        log2_histogram_t *histogram, uint32_t value) {
+    uint32_t bin = 0;
+    if (value != 0) {
+        bin = 32 - __builtin_clz(value);
+        if (bin >= LOG2_HISTOGRAM_N_BINS) {
+            bin = LOG2_HISTOGRAM_N_BINS - 1;
+        }
+    }
+    histogram->bins[bin] += 1;
+}
+
+//! \brief copies the bins of a histogram to memory (e.g. provenance data)
+//! \param[in] histogram The histogram to copy
+//! \param[in] address The address to copy the bins to
+//! \return The address following the copied bins
+static inline address_t log2_histogram_write(
+        log2_histogram_t *histogram, address_t address) {
+    for (uint32_t i = 0; i < LOG2_HISTOGRAM_N_BINS; i++) {
+        address[i] = histogram->bins[i];
+    }
+    return &(address[LOG2_HISTOGRAM_N_BINS]);
+}
+
+#endif // _LOG2_HISTOGRAM_H_
@@ -18,6 +18,11 @@
 #include "neuron.h"
 #include "synapses.h"
 #include "spike_processing.h"
+#include "tick_profile.h"
+#include "spike_latency.h"
+#include "row_cache.h"
+#include "input_buffer_policy.h"
+#include "weight_recording.h"
 #include "population_table/population_table.h"
 #include "plasticity/synapse_dynamics.h"
 
@@ -44,7 +49,10 @@ typedef enum regions_e{
     BUFFERING_OUT_POTENTIAL_RECORDING_REGION,
     BUFFERING_OUT_GSYN_RECORDING_REGION,
     BUFFERING_OUT_CONTROL_REGION,
-    PROVENANCE_DATA_REGION
+    PROVENANCE_DATA_REGION,
+    INPUT_BUFFER_REGION,
+    WEIGHT_RECORDING_REGION,
+    BUFFERING_OUT_WEIGHT_RECORDING_REGION
 } regions_e;
 
 typedef enum extra_provenance_data_region_entries{
@@ -52,6 +60,23 @@ typedef enum extra_provenance_data_region_entries{
     SYNAPTIC_WEIGHT_SATURATION_COUNT = 1,
     INPUT_BUFFER_OVERFLOW_COUNT = 2,
     CURRENT_TIMER_TICK = 3,
+    MAX_OUT_SPIKE_QUEUE_DEPTH = 4,
+    SEND_STALL_TIME = 5,
+    DIRECT_ROW_COUNT = 6,
+    ROW_DMA_COUNT = 7,
+    ROW_CACHE_HIT_COUNT = 8,
+    MERGED_SPIKE_COUNT = 9,
+    LATE_SPIKE_COUNT = 10,
+    LATE_ROW_COUNT = 11,
+    TICKS_WITH_LATE_ROWS = 12,
+    MAX_LATE_ROWS_IN_A_TICK = 13,
+    PLASTIC_BYTES_WRITTEN = 14,
+    PLASTIC_BYTES_SKIPPED = 15,
+    INPUT_BUFFER_START = 16,
+    TICK_PROFILE_START = INPUT_BUFFER_START + INPUT_BUFFER_N_PROVENANCE_WORDS,
+    SPIKE_LATENCY_START = TICK_PROFILE_START + TICK_PROFILE_N_PROVENANCE_WORDS,
+    WEIGHT_RECORDING_START =
+        SPIKE_LATENCY_START + SPIKE_LATENCY_N_PROVENANCE_WORDS
 } extra_provenance_data_region_entries;
 
 //! values for the priority for each callback
@@ -60,7 +85,7 @@ typedef enum callback_priorities{
 } callback_priorities;
 
 //! The number of regions that are to be used for recording
-#define NUMBER_OF_REGIONS_TO_RECORD 3
+#define NUMBER_OF_REGIONS_TO_RECORD 4
 
 // Globals
 
@@ -86,7 +111,8 @@ static bool initialise_recording(){
     regions_e regions_to_record[] = {
         BUFFERING_OUT_SPIKE_RECORDING_REGION,
         BUFFERING_OUT_POTENTIAL_RECORDING_REGION,
-        BUFFERING_OUT_GSYN_RECORDING_REGION
+        BUFFERING_OUT_GSYN_RECORDING_REGION,
+        BUFFERING_OUT_WEIGHT_RECORDING_REGION
     };
     uint8_t n_regions_to_record = NUMBER_OF_REGIONS_TO_RECORD;
     uint32_t *recording_flags_from_system_conf =
@@ -111,6 +137,30 @@ void c_main_store_provenance_data(address_t provenance_region){
     provenance_region[INPUT_BUFFER_OVERFLOW_COUNT] =
         spike_processing_get_buffer_overflows();
     provenance_region[CURRENT_TIMER_TICK] = time;
+    provenance_region[MAX_OUT_SPIKE_QUEUE_DEPTH] =
+        neuron_get_max_out_spike_queue_depth();
+    provenance_region[SEND_STALL_TIME] = neuron_get_send_stall_time();
+    provenance_region[DIRECT_ROW_COUNT] = spike_processing_get_n_direct_rows();
+    provenance_region[ROW_DMA_COUNT] = spike_processing_get_n_row_dmas();
+    provenance_region[ROW_CACHE_HIT_COUNT] = row_cache_get_n_hits();
+    provenance_region[MERGED_SPIKE_COUNT] =
+        spike_processing_get_n_merged_spikes();
+    provenance_region[LATE_SPIKE_COUNT] = spike_processing_get_n_late_spikes();
+    provenance_region[LATE_ROW_COUNT] = synapses_get_n_late_rows();
+    provenance_region[TICKS_WITH_LATE_ROWS] =
+        synapses_get_n_ticks_with_late_rows();
+    provenance_region[MAX_LATE_ROWS_IN_A_TICK] =
+        synapses_get_max_late_rows_in_a_tick();
+    provenance_region[PLASTIC_BYTES_WRITTEN] =
+        spike_processing_get_n_plastic_bytes_written();
+    provenance_region[PLASTIC_BYTES_SKIPPED] =
+        spike_processing_get_n_plastic_bytes_skipped();
+    input_buffer_policy_store_provenance(
+        &provenance_region[INPUT_BUFFER_START]);
+    tick_profile_store_provenance(&provenance_region[TICK_PROFILE_START]);
+    spike_latency_store_provenance(&provenance_region[SPIKE_LATENCY_START]);
+    weight_recording_store_provenance(
+        &provenance_region[WEIGHT_RECORDING_START]);
     log_debug("finished other provenance data");
 }
 
@@ -168,6 +218,12 @@ static bool initialise(uint32_t *timer_period) {
     }
     neuron_set_input_buffers(input_buffers);
 
+    // Copy the rows chosen for caching to DTCM
+    if (!row_cache_initialise(
+            data_specification_get_region(SYNAPTIC_MATRIX_REGION, address))) {
+        return false;
+    }
+
     // Set up the population table
     uint32_t row_max_n_words;
     if (!population_table_initialise(
@@ -189,6 +245,22 @@ static bool initialise(uint32_t *timer_period) {
             incoming_spike_buffer_size)) {
         return false;
     }
+
+    // Set up what to do when the input spike buffer fills
+    if (!input_buffer_policy_initialise(
+            data_specification_get_region(INPUT_BUFFER_REGION, address),
+            incoming_spike_buffer_size)) {
+        return false;
+    }
+    // Set up the recording of the weights of the selected projections
+    if (!weight_recording_initialise(
+            data_specification_get_region(WEIGHT_RECORDING_REGION, address),
+            indirect_synapses_address, recording_flags)) {
+        return false;
+    }
+    spike_processing_set_drain_guard(
+        input_buffer_policy_get_drain_guard_us() * sv->cpu_clk);
+    tick_profile_initialise(*timer_period);
     log_info("Initialise: finished");
     return true;
 }
@@ -210,6 +282,9 @@ void timer_callback(uint timer_count, uint unused) {
     use(timer_count);
     use(unused);
 
+    // Count the input spikes lost during the tick that has ended
+    input_buffer_policy_end_tick(time);
+
     time++;
 
     log_debug("Timer tick %u \n", time);
@@ -225,6 +300,7 @@ void timer_callback(uint timer_count, uint unused) {
         // amounts of samples recorded to SDRAM
         if (recording_flags > 0) {
             log_info("updating recording regions");
+            weight_recording_flush();
             recording_finalise();
         }
 
@@ -233,14 +309,27 @@ void timer_callback(uint timer_count, uint unused) {
         time -= 1;
         return;
     }
+    // Mark the spikes that arrive from now on as arriving in this tick
+    spike_processing_start_tick(time);
+    tick_profile_start_tick(spike_processing_is_busy());
+
+    // Give the spikes of earlier ticks a chance to be processed before their
+    // input is needed
+    spike_processing_drain_earlier_ticks();
+
     // otherwise do synapse and neuron time step updates
     synapses_do_timestep_update(time);
+    tick_profile_end_phase(TICK_PROFILE_SYNAPSES);
     neuron_do_timestep_update(time);
+    tick_profile_end_phase(TICK_PROFILE_NEURONS);
 
     // trigger buffering_out_mechanism
     if (recording_flags > 0) {
+        weight_recording_do_timestep_update();
         recording_do_timestep_update(time);
     }
+    tick_profile_end_phase(TICK_PROFILE_RECORDING);
+    tick_profile_end_tick();
 }
 
 //! \brief The entry point for this model.
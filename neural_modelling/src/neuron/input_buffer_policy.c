@@ -0,0 +1,175 @@
+/*! \file
+ *
+ * \brief implementation of the input_buffer_policy.h interface.
+ *
+ */
+
+#include "input_buffer_policy.h"
+#include <spin1_api.h>
+#include <debug.h>
+
+typedef struct key_range_t {
+    uint32_t key;
+    uint32_t mask;
+    uint32_t priority;
+} key_range_t;
+
+//! The layout of the input buffer region
+typedef struct input_buffer_config_t {
+    uint32_t policy;
+    uint32_t high_water;
+    uint32_t drain_guard_us;
+    uint32_t n_key_ranges;
+    key_range_t key_ranges[];
+} input_buffer_config_t;
+
+static key_range_t *key_ranges;
+
+static uint32_t n_key_ranges = 0;
+
+static input_buffer_policy_e policy = INPUT_BUFFER_DROP_NEWEST;
+
+//! The number of spikes waiting above which spikes are dropped early
+static uint32_t high_water;
+
+//! The priority of the ranges whose spikes are never dropped early
+static uint32_t max_priority = 0;
+
+static uint32_t input_buffer_size;
+
+static uint32_t drain_guard_us = 0;
+
+//! The losses by key range, with the losses of other keys at the end; one
+//! array is written by the packet received callback and one by spike
+//! processing
+static uint32_t overflow_losses[INPUT_BUFFER_N_REPORTED_RANGES + 1];
+static uint32_t early_drop_losses[INPUT_BUFFER_N_REPORTED_RANGES + 1];
+
+static uint32_t n_overflows = 0;
+
+static uint32_t n_early_drops = 0;
+
+//! The losses counted up to the end of the last tick
+static uint32_t n_losses_at_last_tick = 0;
+
+static uint32_t n_ticks_with_losses = 0;
+
+static uint32_t max_losses_in_a_tick = 0;
+
+static uint32_t tick_of_max_losses = 0;
+
+static uint32_t first_tick_with_losses = 0xFFFFFFFF;
+
+//! \brief finds the key range of a key
+//! \return The index of the range, or n_key_ranges if there is none
+static inline uint32_t _find_key_range(spike_t key) {
+    uint32_t i = 0;
+    for (; i < n_key_ranges; i++) {
+        if ((key & key_ranges[i].mask) == key_ranges[i].key) {
+            break;
+        }
+    }
+    return i;
+}
+
+//! \brief gets the index of the loss counter of a key range
+static inline uint32_t _loss_index(uint32_t key_range) {
+    if (key_range < INPUT_BUFFER_N_REPORTED_RANGES) {
+        return key_range;
+    }
+    return INPUT_BUFFER_N_REPORTED_RANGES;
+}
+
+bool input_buffer_policy_initialise(address_t address, uint32_t buffer_size) {
+    input_buffer_config_t *config = (input_buffer_config_t *) address;
+    policy = config->policy;
+    high_water = config->high_water;
+    drain_guard_us = config->drain_guard_us;
+    n_key_ranges = config->n_key_ranges;
+    input_buffer_size = buffer_size;
+
+    if (n_key_ranges > 0) {
+        key_ranges = (key_range_t *) spin1_malloc(
+            n_key_ranges * sizeof(key_range_t));
+        if (key_ranges == NULL) {
+            log_error("Not enough memory to allocate the input key ranges");
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < n_key_ranges; i++) {
+        key_ranges[i] = config->key_ranges[i];
+        if (key_ranges[i].priority > max_priority) {
+            max_priority = key_ranges[i].priority;
+        }
+    }
+    for (uint32_t i = 0; i <= INPUT_BUFFER_N_REPORTED_RANGES; i++) {
+        overflow_losses[i] = 0;
+        early_drop_losses[i] = 0;
+    }
+    log_info(
+        "Input buffer policy %u, high water %u of %u, %u key ranges",
+        policy, high_water, buffer_size, n_key_ranges);
+    return true;
+}
+
+uint32_t input_buffer_policy_get_drain_guard_us() {
+    return drain_guard_us;
+}
+
+void input_buffer_policy_overflowed(spike_t key) {
+    overflow_losses[_loss_index(_find_key_range(key))] += 1;
+    n_overflows += 1;
+}
+
+bool input_buffer_policy_should_drop(spike_t key, uint32_t n_waiting) {
+    if (policy == INPUT_BUFFER_DROP_NEWEST || n_waiting <= high_water) {
+        return false;
+    }
+    uint32_t key_range = _find_key_range(key);
+    if (policy == INPUT_BUFFER_PRIORITY) {
+
+        // Keys that are in no range have the lowest priority
+        uint32_t priority = 0;
+        if (key_range < n_key_ranges) {
+            priority = key_ranges[key_range].priority;
+        }
+        if (priority == max_priority) {
+            return false;
+        }
+    }
+    early_drop_losses[_loss_index(key_range)] += 1;
+    n_early_drops += 1;
+    return true;
+}
+
+void input_buffer_policy_end_tick(uint32_t time) {
+
+    // The counters only ever increase, so the losses of this tick are the
+    // difference from the last tick, whatever interrupts in between
+    uint32_t n_losses = n_overflows + n_early_drops;
+    uint32_t n_tick_losses = n_losses - n_losses_at_last_tick;
+    n_losses_at_last_tick = n_losses;
+    if (n_tick_losses == 0) {
+        return;
+    }
+    if (n_ticks_with_losses == 0) {
+        first_tick_with_losses = time;
+    }
+    n_ticks_with_losses += 1;
+    if (n_tick_losses > max_losses_in_a_tick) {
+        max_losses_in_a_tick = n_tick_losses;
+        tick_of_max_losses = time;
+    }
+}
+
+void input_buffer_policy_store_provenance(address_t provenance_region) {
+    provenance_region[0] = input_buffer_size;
+    provenance_region[1] = n_early_drops;
+    provenance_region[2] = n_ticks_with_losses;
+    provenance_region[3] = max_losses_in_a_tick;
+    provenance_region[4] = tick_of_max_losses;
+    provenance_region[5] = first_tick_with_losses;
+    for (uint32_t i = 0; i <= INPUT_BUFFER_N_REPORTED_RANGES; i++) {
+        provenance_region[6 + i] = overflow_losses[i] + early_drop_losses[i];
+    }
+}
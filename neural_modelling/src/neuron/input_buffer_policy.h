@@ -0,0 +1,87 @@
+/*! \file
+ *
+ *  \brief what to do when the input spike buffer fills, and where the spikes
+ *  that are lost come from
+ *
+ *  \details The host writes the policy, the high water mark of the buffer,
+ *  the drain guard and the key ranges of the incoming projections with their
+ *  priorities to the input buffer region.  The policy is one of:
+ *    - drop newest: spikes are only lost when they arrive to a full buffer
+ *    - drop oldest: once more than the high water mark of spikes are
+ *      waiting, spikes are dropped as they are taken from the buffer, so
+ *      that the newer spikes behind them are processed on time
+ *    - priority: as drop oldest, but only spikes from key ranges of a lower
+ *      priority than the highest are dropped
+ *
+ *  Losses are counted by key range, so that the projection flooding the core
+ *  can be found, and by timer tick.  Spikes lost when the buffer is full are
+ *  counted by the packet received callback and those dropped early by the
+ *  spike processing callbacks, in separate counters so that each only has
+ *  one writer.
+ *
+ *  The API contains:
+ *    - input_buffer_policy_initialise(address, buffer_size):
+ *         reads the policy and key ranges
+ *    - input_buffer_policy_get_drain_guard_us():
+ *         gets how long to wait for the spikes of earlier ticks
+ *    - input_buffer_policy_overflowed(key):
+ *         counts a spike lost because the buffer was full
+ *    - input_buffer_policy_should_drop(key, n_waiting):
+ *         decides whether to drop a spike taken from the buffer
+ *    - input_buffer_policy_end_tick(time):
+ *         updates the losses per tick
+ *    - input_buffer_policy_store_provenance(provenance_region):
+ *         writes the losses to provenance
+ */
+
+#ifndef _INPUT_BUFFER_POLICY_H_
+#define _INPUT_BUFFER_POLICY_H_
+
+#include "../common/neuron-typedefs.h"
+
+//! The number of key ranges whose losses are reported separately; the
+//! losses of any other keys are reported together
+#define INPUT_BUFFER_N_REPORTED_RANGES 8
+
+//! buffer size, early drops, ticks with losses, max losses in a tick, the
+//! tick of the max, the first tick with losses, the losses of each reported
+//! range and the losses of other keys
+#define INPUT_BUFFER_N_PROVENANCE_WORDS (7 + INPUT_BUFFER_N_REPORTED_RANGES)
+
+typedef enum input_buffer_policy_e {
+    INPUT_BUFFER_DROP_NEWEST, INPUT_BUFFER_DROP_OLDEST, INPUT_BUFFER_PRIORITY
+} input_buffer_policy_e;
+
+//! \brief reads the policy and key ranges written by the host
+//! \param[in] address The address of the input buffer region
+//! \param[in] buffer_size The number of spikes the input buffer holds
+//! \return True if successful, False if there was not enough DTCM
+bool input_buffer_policy_initialise(address_t address, uint32_t buffer_size);
+
+//! \brief gets the longest time to wait at the start of a tick for the spikes
+//!        that arrived in earlier ticks to be processed
+//! \return The time in microseconds, or 0 not to wait
+uint32_t input_buffer_policy_get_drain_guard_us();
+
+//! \brief counts a spike that was lost because the buffer was full; only to
+//!        be called by the packet received callback
+//! \param[in] key The key of the spike
+void input_buffer_policy_overflowed(spike_t key);
+
+//! \brief decides whether to drop a spike taken from the buffer, and counts
+//!        it if so; only to be called by the spike processing callbacks
+//! \param[in] key The key of the spike
+//! \param[in] n_waiting The number of spikes still in the buffer
+//! \return True if the spike should not be processed
+bool input_buffer_policy_should_drop(spike_t key, uint32_t n_waiting);
+
+//! \brief updates the losses per tick with the losses since the last call
+//! \param[in] time The tick that has ended
+void input_buffer_policy_end_tick(uint32_t time);
+
+//! \brief writes the losses to the provenance region
+//! \param[in] provenance_region Where to write the
+//!                              INPUT_BUFFER_N_PROVENANCE_WORDS words
+void input_buffer_policy_store_provenance(address_t provenance_region);
+
+#endif // _INPUT_BUFFER_POLICY_H_
@@ -14,6 +14,7 @@
 #include "../common/out_spikes.h"
 #include "recording.h"
 #include <debug.h>
+#include <spin1_api.h>
 #include <string.h>
 
 #define SPIKE_RECORDING_CHANNEL 0
@@ -45,6 +46,24 @@ static bool use_key;
 //! The number of neurons on the core
 static uint32_t n_neurons;
 
+//! The keys of the spikes generated this timestep, waiting to be sent
+static key_t *out_spike_queue;
+
+//! The number of spikes currently in the outgoing spike queue
+static uint32_t n_out_spikes_queued;
+
+//! The largest number of spikes queued for sending in any one timestep
+static uint32_t max_out_spike_queue_depth = 0;
+
+//! The number of microseconds spent waiting for the router to accept a spike
+static uint32_t send_stall_time_us = 0;
+
+//! The number of clock ticks to leave between sending each spike
+static uint32_t time_between_spikes;
+
+//! The expected current clock tick of timer_1 to wait for
+static uint32_t expected_time;
+
 //! The recording flags
 static uint32_t recording_flags;
 
@@ -63,7 +82,8 @@ uint32_t input_size;
 //! readable form
 typedef enum parmeters_in_neuron_parameter_data_region {
     HAS_KEY, TRANSMISSION_KEY, N_NEURONS_TO_SIMULATE,
-    INCOMING_SPIKE_BUFFER_SIZE, START_OF_GLOBAL_PARAMETERS,
+    INCOMING_SPIKE_BUFFER_SIZE, TIME_BETWEEN_SPIKES,
+    START_OF_GLOBAL_PARAMETERS,
 } parmeters_in_neuron_parameter_data_region;
 
 
@@ -129,6 +149,9 @@ bool neuron_initialise(address_t address, uint32_t recording_flags_param,
     // Read the size of the incoming spike buffer to use
     *incoming_spike_buffer_size = address[INCOMING_SPIKE_BUFFER_SIZE];
 
+    // Read the time between sending spikes (in microseconds)
+    time_between_spikes = address[TIME_BETWEEN_SPIKES] * sv->cpu_clk;
+
     uint32_t next = START_OF_GLOBAL_PARAMETERS;
 
     // Read the global parameter details
@@ -150,6 +173,7 @@ bool neuron_initialise(address_t address, uint32_t recording_flags_param,
         "input type size = %u, threshold size = %u", n_neurons,
         *incoming_spike_buffer_size, sizeof(neuron_t),
         sizeof(input_type_t), sizeof(threshold_type_t));
+    log_info("\t time_between_spikes = %u", time_between_spikes);
 
     // Allocate DTCM for neuron array and copy block of data
     if (sizeof(neuron_t) != 0) {
@@ -206,6 +230,17 @@ bool neuron_initialise(address_t address, uint32_t recording_flags_param,
         return false;
     }
 
+    // Set up the queue of spikes to send; each neuron can spike at most once
+    // per timestep, so this never needs to be bigger than the neuron count
+    if (use_key) {
+        out_spike_queue = (key_t *) spin1_malloc(n_neurons * sizeof(key_t));
+        if (out_spike_queue == NULL) {
+            log_error("Unable to allocate outgoing spike queue - Out of DTCM");
+            return false;
+        }
+    }
+    n_out_spikes_queued = 0;
+
     // Set up the neuron model
     neuron_model_set_global_neuron_params(global_parameters);
 
@@ -221,6 +256,54 @@ bool neuron_initialise(address_t address, uint32_t recording_flags_param,
     return true;
 }
 
+//! \brief sends the spikes queued during the update of the neurons, spacing
+//!        them out by time_between_spikes to avoid flooding the router
+//!
+//! The first spike is sent at once.  The spacing is reduced if spacing the
+//! rest by time_between_spikes would take more than half of what is left of
+//! the tick, so that the wait is bounded and the rest of the tick is left
+//! for processing the spikes that arrive.
+static inline void _send_queued_spikes() {
+
+    if (n_out_spikes_queued > max_out_spike_queue_depth) {
+        max_out_spike_queue_depth = n_out_spikes_queued;
+    }
+    if (n_out_spikes_queued == 0) {
+        return;
+    }
+
+    // Timer 1 counts down to the end of the tick, so its count is the number
+    // of clock ticks left in the tick
+    uint32_t spacing = time_between_spikes;
+    if (n_out_spikes_queued > 1) {
+        uint32_t max_spacing =
+            (tc[T1_COUNT] >> 1) / (n_out_spikes_queued - 1);
+        if (spacing > max_spacing) {
+            spacing = max_spacing;
+        }
+    }
+
+    expected_time = tc[T1_COUNT];
+    for (uint32_t i = 0; i < n_out_spikes_queued; i++) {
+
+        // Wait until the expected time to send each spike after the first
+        if (i > 0) {
+            expected_time -= spacing;
+            while (tc[T1_COUNT] > expected_time) {
+
+                // Do Nothing
+            }
+        }
+
+        // Send the spike, accounting for any time waiting for the router
+        while (!spin1_send_mc_packet(out_spike_queue[i], 0, NO_PAYLOAD)) {
+            spin1_delay_us(1);
+            send_stall_time_us += 1;
+        }
+    }
+    n_out_spikes_queued = 0;
+}
+
 //! \setter for the internal input buffers
 //! \param[in] input_buffers_value the new input buffers
 void neuron_set_input_buffers(input_t *input_buffers_value) {
@@ -302,10 +385,9 @@ void neuron_do_timestep_update(timer_t time) {
             // Record the spike
             out_spikes_set_spike(neuron_index);
 
-            // Send the spike
-            while (use_key &&
-                   !spin1_send_mc_packet(key | neuron_index, 0, NO_PAYLOAD)) {
-                spin1_delay_us(1);
+            // Queue the spike to be sent once all neurons are updated
+            if (use_key) {
+                out_spike_queue[n_out_spikes_queued++] = key | neuron_index;
             }
         } else {
             log_debug("the neuron %d has been determined to not spike",
@@ -313,6 +395,9 @@ void neuron_do_timestep_update(timer_t time) {
         }
     }
 
+    // Send the spikes generated during this update
+    _send_queued_spikes();
+
     // record neuron state (membrane potential) if needed
     if (recording_is_channel_enabled(recording_flags, V_RECORDING_CHANNEL)) {
         voltages->time = time;
@@ -337,3 +422,16 @@ void neuron_do_timestep_update(timer_t time) {
     }
     out_spikes_reset();
 }
+
+//! \brief returns the largest number of spikes queued to be sent in a single
+//!        timestep
+//! \return the maximum depth of the outgoing spike queue
+uint32_t neuron_get_max_out_spike_queue_depth() {
+    return max_out_spike_queue_depth;
+}
+
+//! \brief returns the time spent waiting for the router to accept spikes
+//! \return the total send stall time in microseconds
+uint32_t neuron_get_send_stall_time() {
+    return send_stall_time_us;
+}
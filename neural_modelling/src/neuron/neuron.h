@@ -11,6 +11,10 @@
  *    - neuron_do_timestep_update(time):
  *         executes all the updates to neural parameters when a given timer
  *         period has occurred.
+ *    - neuron_get_max_out_spike_queue_depth():
+ *         the largest number of spikes sent in a single timer period
+ *    - neuron_get_send_stall_time():
+ *         the time spent waiting for the router to accept spikes
  */
 
 #ifndef _NEURON_H_
@@ -45,4 +49,13 @@ void neuron_set_input_buffers(input_t *input_buffers_value);
 //! \return nothing
 void neuron_do_timestep_update(uint32_t time);
 
+//! \brief returns the largest number of spikes queued to be sent in a single
+//!        timestep
+//! \return the maximum depth of the outgoing spike queue
+uint32_t neuron_get_max_out_spike_queue_depth();
+
+//! \brief returns the time spent waiting for the router to accept spikes
+//! \return the total send stall time in microseconds
+uint32_t neuron_get_send_stall_time();
+
 #endif // _NEURON_H_
@@ -0,0 +1,142 @@
+/*! \file
+ *
+ *  \brief exponential decays e^(-t / tau) over any range of times, from a
+ *         fine lookup table composed with a coarse one
+ *
+ *  \details As e^(-(a + b) / tau) = e^(-a / tau) * e^(-b / tau), a time is
+ *  split into a coarse part, the time in steps of the whole fine table, and a
+ *  fine part, the time within a step.  The decay is the product of the
+ *  entries of the two tables, so a long time constant needs a few more coarse
+ *  entries rather than a longer or coarser single table.
+ *
+ *  The host chooses the shift and sizes of the tables for each time constant
+ *  and writes them before the entries:
+ *    - the fine shift: the time is shifted down by this before indexing the
+ *      fine table, for time constants too long for the coarse table alone
+ *    - the fine size, a power of two
+ *    - the coarse size, including a last entry of zero
+ *    - the fine entries, padded to a whole number of words
+ *    - the coarse entries, padded to a whole number of words
+ *
+ *  Both tables hold EXP_DECAY_FIXED_POINT fixed-point values, so that their
+ *  product is a single 16x16 multiply, which is rounded to the STDP fixed
+ *  point.  Coarse indices past the end are clamped to the last entry,
+ *  which is zero, so that times past the range decay to zero without a
+ *  branch.
+ */
+
+#ifndef _EXP_DECAY_H_
+#define _EXP_DECAY_H_
+
+#include "maths.h"
+#include "stdp_typedefs.h"
+#include <debug.h>
+
+#ifdef SYNAPSE_BENCHMARK
+#include "../../../common/free_running_timer.h"
+#endif  // SYNAPSE_BENCHMARK
+
+//! The fixed point of the entries of both tables
+#define EXP_DECAY_FIXED_POINT 14
+
+//! The shift from the product of two entries to the STDP fixed point
+#define EXP_DECAY_PRODUCT_SHIFT ((2 * EXP_DECAY_FIXED_POINT) - STDP_FIXED_POINT)
+
+//! Half of the last place of the STDP fixed point in the product, to round
+#define EXP_DECAY_PRODUCT_ROUND (1 << (EXP_DECAY_PRODUCT_SHIFT - 1))
+
+//! The number of lookups timed by the benchmark
+#define EXP_DECAY_BENCHMARK_N_LOOKUPS 1024
+
+typedef struct exp_decay_lut_t {
+    uint32_t fine_shift;
+    uint32_t fine_mask;
+    uint32_t coarse_shift;
+    uint32_t coarse_last;
+    int16_t *fine;
+    int16_t *coarse;
+} exp_decay_lut_t;
+
+//! The layout of the tables written by the host
+typedef struct exp_decay_lut_config_t {
+    uint32_t fine_shift;
+    uint32_t fine_size;
+    uint32_t coarse_size;
+    uint32_t entries[];
+} exp_decay_lut_config_t;
+
+//! \brief gets the decay of a time
+//! \param[in] time The time since the trace was last updated
+//! \param[in] lut The tables of the time constant
+//! \return The decay in the STDP fixed point
+static inline int32_t exp_decay_lookup(
+        uint32_t time, const exp_decay_lut_t *lut) {
+    uint32_t coarse_index = MIN(time >> lut->coarse_shift, lut->coarse_last);
+    uint32_t fine_index = (time >> lut->fine_shift) & lut->fine_mask;
+    int32_t product = maths_smulbb(
+        lut->coarse[coarse_index], lut->fine[fine_index]);
+    return (product + EXP_DECAY_PRODUCT_ROUND) >> EXP_DECAY_PRODUCT_SHIFT;
+}
+
+#ifdef SYNAPSE_BENCHMARK
+//! \brief logs the cycles taken by lookups of the composed tables, and by the
+//!        single table lookups that they replace
+static inline void _exp_decay_benchmark(const exp_decay_lut_t *lut) {
+    free_running_timer_start();
+    volatile int32_t sink = 0;
+
+    uint32_t start = free_running_timer_now();
+    for (uint32_t t = 0; t < EXP_DECAY_BENCHMARK_N_LOOKUPS; t++) {
+        sink += exp_decay_lookup(t, lut);
+    }
+    uint32_t composed_cycles = free_running_timer_elapsed(start);
+
+    start = free_running_timer_now();
+    for (uint32_t t = 0; t < EXP_DECAY_BENCHMARK_N_LOOKUPS; t++) {
+        sink += maths_lut_exponential_decay(
+            t, lut->fine_shift, lut->fine_mask + 1, lut->fine);
+    }
+    uint32_t single_cycles = free_running_timer_elapsed(start);
+
+    log_info(
+        "\t%u decay lookups: %u cycles composed, %u cycles single table",
+        EXP_DECAY_BENCHMARK_N_LOOKUPS, composed_cycles, single_cycles);
+}
+#endif  // SYNAPSE_BENCHMARK
+
+//! \brief copies the tables written by the host
+//! \param[in] address The address of the shift, sizes and tables
+//! \param[out] lut The tables to fill in
+//! \return The address after the tables, or NULL if there was not enough
+//!         DTCM
+static inline address_t exp_decay_lut_initialise(
+        address_t address, exp_decay_lut_t *lut) {
+    exp_decay_lut_config_t *config = (exp_decay_lut_config_t *) address;
+    uint32_t fine_size = config->fine_size;
+    uint32_t coarse_size = config->coarse_size;
+    lut->fine = (int16_t *) spin1_malloc(fine_size * sizeof(int16_t));
+    lut->coarse = (int16_t *) spin1_malloc(coarse_size * sizeof(int16_t));
+    if (lut->fine == NULL || lut->coarse == NULL) {
+        log_error("Not enough memory to allocate the exponential decay LUTs");
+        return NULL;
+    }
+
+    lut->fine_shift = config->fine_shift;
+    lut->fine_mask = fine_size - 1;
+    lut->coarse_shift = config->fine_shift + __builtin_ctz(fine_size);
+    lut->coarse_last = coarse_size - 1;
+    address_t next = maths_copy_int16_lut(
+        config->entries, fine_size, lut->fine);
+    next = maths_copy_int16_lut(next, coarse_size, lut->coarse);
+    log_info(
+        "\tdecay LUTs: fine shift %u, %u fine entries, %u coarse entries",
+        lut->fine_shift, fine_size, coarse_size);
+
+#ifdef SYNAPSE_BENCHMARK
+    _exp_decay_benchmark(lut);
+#endif  // SYNAPSE_BENCHMARK
+
+    return next;
+}
+
+#endif  // _EXP_DECAY_H_
@@ -10,6 +10,57 @@
 #define MIN(X,Y) ((X) < (Y) ? (X) : (Y))
 #define MAX(X,Y) ((X) > (Y) ? (X) : (Y))
 
+//---------------------------------------
+// 16x16 multiplies
+//---------------------------------------
+// Each multiplies one 16-bit half of each operand, the bottom (b) or the top
+// (t), which lets a pair of 16-bit values packed into a word be used in place
+// without unpacking it; smulwb multiplies the whole word (w) of the first by
+// the bottom of the second, keeping the top 32 bits of the 48-bit product.
+// These are single instructions on ARM; the portable versions let the maths
+// be checked bit-for-bit on the host.
+#ifdef __arm__
+#define maths_smulbb(a, b) __smulbb(a, b)
+#define maths_smulbt(a, b) __smulbt(a, b)
+#define maths_smulwb(a, b) __smulwb(a, b)
+#define maths_smlabb(a, b, c) __smlabb(a, b, c)
+#else
+static inline int32_t maths_smulbb(int32_t a, int32_t b) {
+    return (int32_t) (int16_t) a * (int32_t) (int16_t) b;
+}
+
+static inline int32_t maths_smulbt(int32_t a, int32_t b) {
+    return (int32_t) (int16_t) a * (b >> 16);
+}
+
+static inline int32_t maths_smulwb(int32_t a, int32_t b) {
+    return (int32_t) (((int64_t) a * (int16_t) b) >> 16);
+}
+
+static inline int32_t maths_smlabb(int32_t a, int32_t b, int32_t c) {
+    return maths_smulbb(a, b) + c;
+}
+#endif  // __arm__
+
+//---------------------------------------
+// Pairs of 16-bit values packed into a word
+//---------------------------------------
+// The first value is in the bottom half and the second in the top, as a
+// structure of two int16_t is laid out in memory
+typedef uint32_t maths_pair16_t;
+
+static inline maths_pair16_t maths_pair16_pack(int32_t bottom, int32_t top) {
+    return (((uint32_t) bottom) & 0xFFFF) | (((uint32_t) top) << 16);
+}
+
+static inline int32_t maths_pair16_bottom(maths_pair16_t pair) {
+    return (int16_t) pair;
+}
+
+static inline int32_t maths_pair16_top(maths_pair16_t pair) {
+    return ((int32_t) pair) >> 16;
+}
+
 //---------------------------------------
 // Plasticity maths function inline implementation
 //---------------------------------------
@@ -59,12 +110,38 @@ static inline int32_t maths_fixed_mul16(
         int32_t a, int32_t b, const int32_t fixed_point_position) {
 
     // Multiply lower 16-bits of a and b together
-    int32_t mul = __smulbb(a, b);
+    int32_t mul = maths_smulbb(a, b);
 
     // Shift down
     return (mul >> fixed_point_position);
 }
 
+//---------------------------------------
+// **NOTE** the same as maths_fixed_mul16 but with all 32 bits of a, for
+// values such as sums of many 16-bit values; a is shifted up so that the top
+// of the product is shifted down by the fixed point, which is exact while a
+// fits in 32 - (16 - fixed_point_position) bits
+static inline int32_t maths_fixed_mul32x16(
+        int32_t a, int32_t b, const int32_t fixed_point_position) {
+    return maths_smulwb(a << (16 - fixed_point_position), b);
+}
+
+//---------------------------------------
+// **NOTE** the same as maths_fixed_mul16 of a and the top 16-bits of b
+static inline int32_t maths_fixed_mul16_top(
+        int32_t a, maths_pair16_t b, const int32_t fixed_point_position) {
+    return (maths_smulbt(a, b) >> fixed_point_position);
+}
+
+//---------------------------------------
+// **NOTE** the same as maths_fixed_mul16 of a and b plus c, as c is shifted
+// up by the fixed point before it is added, so the shift does not round it
+static inline int32_t maths_fixed_mul16_add(
+        int32_t a, int32_t b, int32_t c, const int32_t fixed_point_position) {
+    return (maths_smlabb(a, b, c << fixed_point_position)
+            >> fixed_point_position);
+}
+
 //---------------------------------------
 static inline int32_t maths_fixed_mul32(
         int32_t a, int32_t b, const int32_t fixed_point_position) {
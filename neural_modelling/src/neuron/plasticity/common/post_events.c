@@ -0,0 +1,9 @@
+#include "post_events.h"
+
+#ifdef POST_EVENTS_COMPACT
+//---------------------------------------
+// Globals
+//---------------------------------------
+// The events of the last compact history whose window was found, in full
+post_event_buffer_t post_event_buffer;
+#endif  // POST_EVENTS_COMPACT
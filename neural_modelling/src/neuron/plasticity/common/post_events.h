@@ -17,13 +17,51 @@
 //---------------------------------------
 // Structures
 //---------------------------------------
+// The events of a neuron, with the time and trace of each; the first entry is
+// a placeholder at time 0 with the initial trace
 typedef struct {
     uint32_t count_minus_one;
 
     uint32_t times[MAX_POST_SYNAPTIC_EVENTS];
     post_trace_t traces[MAX_POST_SYNAPTIC_EVENTS];
+} post_event_buffer_t;
+
+#ifdef POST_EVENTS_COMPACT
+// The compact history of a neuron keeps the time of each event as an offset
+// from an epoch of the neuron, and only the traces of the first and last
+// events and of every POST_EVENTS_CHECKPOINT_INTERVAL'th event; the trace of
+// each event is the trace of the one before with the spike added, so the
+// others are found from the checkpoint before them when a window is needed.
+// The epoch moves up when a new event is too far from it for an offset to
+// hold, forgetting events that are more than half the range of an offset
+// old.
+#define POST_EVENTS_CHECKPOINT_INTERVAL 8
+
+// Enough checkpoints that a checkpoint is only replaced once the event it
+// holds has been dropped from the history
+#define POST_EVENTS_N_CHECKPOINTS \
+    (MAX_POST_SYNAPTIC_EVENTS / POST_EVENTS_CHECKPOINT_INTERVAL)
+
+typedef struct {
+    uint32_t epoch;
+    uint16_t count_minus_one;
+
+    // The number of the first event of the history, counting every event
+    // added, from which the checkpoint of each event is found
+    uint16_t first_event;
+    uint16_t times[MAX_POST_SYNAPTIC_EVENTS];
+    post_trace_t first_trace;
+    post_trace_t last_trace;
+    post_trace_t checkpoints[POST_EVENTS_N_CHECKPOINTS];
 } post_event_history_t;
 
+// The events of the last history whose window was found, in full from the
+// event before the window (post_events.c)
+extern post_event_buffer_t post_event_buffer;
+#else
+typedef post_event_buffer_t post_event_history_t;
+#endif  // POST_EVENTS_COMPACT
+
 typedef struct {
     post_trace_t prev_trace;
     uint32_t prev_time;
@@ -54,15 +92,118 @@ static inline post_event_history_t *post_events_init_buffers(
 
         // Add initial placeholder entry to buffer
         post_event_history[n].times[0] = 0;
+#ifdef POST_EVENTS_COMPACT
+        post_event_history[n].epoch = 0;
+        post_event_history[n].first_event = 0;
+#else
         post_event_history[n].traces[0] = timing_get_initial_post_trace();
+#endif  // POST_EVENTS_COMPACT
         post_event_history[n].count_minus_one = 0;
     }
 
     return post_event_history;
 }
 
-static inline post_event_window_t post_events_get_window(
+#ifdef POST_EVENTS_COMPACT
+//---------------------------------------
+//! \brief finds the trace of an event of a compact history, from the last
+//!        checkpoint at or before it, or from the first event if that has
+//!        been dropped
+static inline post_trace_t _post_events_trace(
+        const post_event_history_t *events, uint32_t index) {
+    const uint16_t number = events->first_event + index - 1;
+    const uint32_t n_after_checkpoint =
+        number % POST_EVENTS_CHECKPOINT_INTERVAL;
+    uint32_t e = 1;
+    post_trace_t trace = events->first_trace;
+    if (n_after_checkpoint < index) {
+        e = index - n_after_checkpoint;
+        trace = events->checkpoints[
+            (number / POST_EVENTS_CHECKPOINT_INTERVAL) %
+            POST_EVENTS_N_CHECKPOINTS];
+    }
+    for (; e < index; e++) {
+        trace = timing_add_post_spike(
+            events->epoch + events->times[e + 1],
+            events->epoch + events->times[e], trace);
+    }
+    return trace;
+}
+
+//---------------------------------------
+//! \brief expands the events of a compact history from the last event at or
+//!        before the start of a window, as the window functions look no
+//!        further back than this
+static inline const post_event_buffer_t *_post_events_buffer(
         const post_event_history_t *events, uint32_t begin_time) {
+    post_event_buffer_t *buffer = &post_event_buffer;
+    const uint32_t count = events->count_minus_one + 1;
+    buffer->count_minus_one = events->count_minus_one;
+    buffer->times[0] = 0;
+    buffer->traces[0] = timing_get_initial_post_trace();
+
+    uint32_t first = events->count_minus_one;
+    while (first > 1 && (events->epoch + events->times[first]) > begin_time) {
+        first--;
+    }
+    if (first == 0) {
+        return buffer;
+    }
+    buffer->times[first] = events->epoch + events->times[first];
+    buffer->traces[first] = _post_events_trace(events, first);
+
+    // Find the trace of each later event from the one before it
+    for (uint32_t e = first + 1; e < count; e++) {
+        buffer->times[e] = events->epoch + events->times[e];
+        buffer->traces[e] = timing_add_post_spike(
+            buffer->times[e], buffer->times[e - 1], buffer->traces[e - 1]);
+    }
+    return buffer;
+}
+
+//---------------------------------------
+static inline uint32_t post_events_last_time(
+        const post_event_history_t *events) {
+    if (events->count_minus_one == 0) {
+        return 0;
+    }
+    return events->epoch + events->times[events->count_minus_one];
+}
+
+//---------------------------------------
+static inline post_trace_t post_events_last_trace(
+        const post_event_history_t *events) {
+    if (events->count_minus_one == 0) {
+        return timing_get_initial_post_trace();
+    }
+    return events->last_trace;
+}
+#else
+//---------------------------------------
+static inline const post_event_buffer_t *_post_events_buffer(
+        const post_event_history_t *events, uint32_t begin_time) {
+    use(begin_time);
+    return events;
+}
+
+//---------------------------------------
+static inline uint32_t post_events_last_time(
+        const post_event_history_t *events) {
+    return events->times[events->count_minus_one];
+}
+
+//---------------------------------------
+static inline post_trace_t post_events_last_trace(
+        const post_event_history_t *events) {
+    return events->traces[events->count_minus_one];
+}
+#endif  // POST_EVENTS_COMPACT
+
+//---------------------------------------
+static inline post_event_window_t post_events_get_window(
+        const post_event_history_t *history, uint32_t begin_time) {
+    const post_event_buffer_t *events = _post_events_buffer(
+        history, begin_time);
 
     // Start at end event - beyond end of post-event history
     const uint32_t count = events->count_minus_one + 1;
@@ -98,8 +239,10 @@ static inline post_event_window_t post_events_get_window(
 
 //---------------------------------------
 static inline post_event_window_t post_events_get_window_delayed(
-        const post_event_history_t *events, uint32_t begin_time,
+        const post_event_history_t *history, uint32_t begin_time,
         uint32_t end_time) {
+    const post_event_buffer_t *events = _post_events_buffer(
+        history, begin_time);
 
     // Start at end event - beyond end of post-event history
     const uint32_t count = events->count_minus_one + 1;
@@ -113,9 +256,10 @@ static inline post_event_window_t post_events_get_window_delayed(
         // **NOTE** next_time can be invalid
         window.next_time = event_time--;
 
-        // If this event is still in the future, move the end time back
+        // If this event is still in the future, move the end of the window
+        // back to it
         if (*event_time > end_time) {
-            end_event_time = window.next_time;
+            end_event_time = event_time;
         }
     }
 
@@ -129,8 +273,10 @@ static inline post_event_window_t post_events_get_window_delayed(
     // Calculate number of events
     window.num_events = (end_event_time - window.next_time);
 
-    // Using num_events, find next and previous traces
-    const post_trace_t *end_event_trace = events->traces + count;
+    // Using num_events, find next and previous traces, from the end of the
+    // window rather than the end of the history
+    const post_trace_t *end_event_trace =
+        events->traces + (end_event_time - events->times);
     window.next_trace = (end_event_trace - window.num_events);
     window.prev_trace = *(window.next_trace - 1);
 
@@ -166,6 +312,87 @@ static inline post_event_window_t post_events_next_delayed(
     return window;
 }
 
+#ifdef POST_EVENTS_COMPACT
+//---------------------------------------
+static inline void _post_events_rebase(
+        post_event_history_t *events, uint32_t time) {
+
+    // Leave room for half the range of an offset before the next rebase
+    const uint32_t epoch = time - (UINT16_MAX / 2);
+    const uint32_t count = events->count_minus_one + 1;
+
+    // Skip the events before the new epoch, following the trace on to the
+    // first event after it
+    uint32_t first = 1;
+    post_trace_t first_trace = events->first_trace;
+    while (first < count && (events->epoch + events->times[first]) < epoch) {
+        first++;
+        if (first < count) {
+            first_trace = timing_add_post_spike(
+                events->epoch + events->times[first],
+                events->epoch + events->times[first - 1], first_trace);
+        }
+    }
+
+    // Move the events kept down, as offsets from the new epoch
+    uint32_t n = 1;
+    for (uint32_t e = first; e < count; e++) {
+        events->times[n++] = events->epoch + events->times[e] - epoch;
+    }
+    log_debug("\tMoved post-synaptic epoch from %u to %u, forgetting %u events",
+              events->epoch, epoch, first - 1);
+    events->count_minus_one = n - 1;
+    events->first_event += first - 1;
+    events->first_trace = first_trace;
+    events->epoch = epoch;
+}
+
+//---------------------------------------
+static inline void post_events_add(uint32_t time, post_event_history_t *events,
+                                   post_trace_t trace) {
+
+    if ((time - events->epoch) > UINT16_MAX) {
+        _post_events_rebase(events, time);
+    }
+
+    uint32_t new_index;
+    if (events->count_minus_one < (MAX_POST_SYNAPTIC_EVENTS - 1)) {
+
+        // If there's still space, store time at current end
+        // and increment count minus 1
+        new_index = ++events->count_minus_one;
+        events->times[new_index] = time - events->epoch;
+        if (new_index == 1) {
+            events->first_trace = trace;
+        }
+    } else {
+
+        // Otherwise Shuffle down elements, following the first trace on to
+        // the event that becomes the first
+        // **NOTE** 1st element is always an entry at time 0
+        events->first_trace = timing_add_post_spike(
+            events->epoch + events->times[2],
+            events->epoch + events->times[1], events->first_trace);
+        events->first_event++;
+        for (uint32_t e = 2; e < MAX_POST_SYNAPTIC_EVENTS; e++) {
+            events->times[e - 1] = events->times[e];
+        }
+
+        // Stick new time at end
+        new_index = MAX_POST_SYNAPTIC_EVENTS - 1;
+        events->times[new_index] = time - events->epoch;
+    }
+    events->last_trace = trace;
+
+    // Keep the trace of every POST_EVENTS_CHECKPOINT_INTERVAL'th event
+    const uint16_t number = events->first_event + new_index - 1;
+    if ((number % POST_EVENTS_CHECKPOINT_INTERVAL) == 0) {
+        events->checkpoints[
+            (number / POST_EVENTS_CHECKPOINT_INTERVAL) %
+            POST_EVENTS_N_CHECKPOINTS] = trace;
+    }
+}
+#else
 //---------------------------------------
 static inline void post_events_add(uint32_t time, post_event_history_t *events,
                                    post_trace_t trace) {
@@ -191,5 +418,6 @@ static inline void post_events_add(uint32_t time, post_event_history_t *events,
         events->traces[MAX_POST_SYNAPTIC_EVENTS - 1] = trace;
     }
 }
+#endif  // POST_EVENTS_COMPACT
 
 #endif  // _POST_EVENTS_H_
@@ -10,5 +10,13 @@
 
 // Helper macros for 16-bit fixed-point multiplication
 #define STDP_FIXED_MUL_16X16(a, b) maths_fixed_mul16(a, b, STDP_FIXED_POINT)
+#define STDP_FIXED_MUL_16X16_TOP(a, b) \
+    maths_fixed_mul16_top(a, b, STDP_FIXED_POINT)
+#define STDP_FIXED_MUL_16X16_ADD(a, b, c) \
+    maths_fixed_mul16_add(a, b, c, STDP_FIXED_POINT)
+
+// Helper macro for fixed-point multiplication of 32-bit values by 16-bit ones
+#define STDP_FIXED_MUL_32X16(a, b) \
+    maths_fixed_mul32x16(a, b, STDP_FIXED_POINT)
 
 #endif  // _STDP_TYPEDEFS_H_
@@ -3,6 +3,7 @@
 
 // sPyNNaker neural modelling includes
 #include "../../synapses.h"
+#include "../synapse_dynamics.h"
 
 // Plasticity common includes
 #include "../common/pre_events.h"
@@ -13,7 +14,14 @@
 #include <string.h>
 #include <debug.h>
 
+// Only the MAD implementation reads interleaved plastic rows
+#ifdef PLASTIC_ROWS_INTERLEAVED
+#error "Interleaved plastic rows need the MAD STDP implementation"
+#endif  // PLASTIC_ROWS_INTERLEAVED
+
 #ifdef SYNAPSE_BENCHMARK
+#include "weight_update_benchmark.h"
+
 uint32_t num_plastic_pre_synaptic_events;
 #endif  // SYNAPSE_BENCHMARK
 
@@ -122,7 +130,7 @@ bool synapse_dynamics_initialise(
 
     // Load timing dependence data
     address_t weight_region_address = timing_initialise(address);
-    if (address == NULL) {
+    if (weight_region_address == NULL) {
         return false;
     }
 
@@ -138,17 +146,25 @@ bool synapse_dynamics_initialise(
         return false;
     }
 
+#ifdef SYNAPSE_BENCHMARK
+    free_running_timer_start();
+    weight_update_benchmark();
+#endif  // SYNAPSE_BENCHMARK
+
     return true;
 }
 
 bool synapse_dynamics_process_plastic_synapses(
         address_t plastic_region_address, address_t fixed_region_address,
-        weight_t *ring_buffers, uint32_t time) {
+        weight_t *ring_buffers, uint32_t time,
+        plastic_write_back_t *write_back) {
 
     // Extract separate arrays of plastic synapses (from plastic region),
     // Control words (from fixed region) and number of plastic synapses
     plastic_synapse_t *plastic_words = _plastic_synapses(
         plastic_region_address);
+    plastic_synapse_t *first_changed = NULL;
+    plastic_synapse_t *end_changed = plastic_words;
     const control_t *control_words = synapse_row_plastic_controls(
         fixed_region_address);
     size_t plastic_synapse = synapse_row_num_plastic_controls(
@@ -200,9 +216,19 @@ bool synapse_dynamics_process_plastic_synapses(
         ring_buffers[ring_buffer_index] += synapse_structure_get_final_weight(
             final_state);
 
-        // Write back updated synaptic word to plastic region
-        *plastic_words++ = synapse_structure_get_final_synaptic_word(
-            final_state);
+        // Write back updated synaptic word to plastic region, noting the
+        // span of the words that changed, as only these need to be written
+        // back to SDRAM
+        plastic_synapse_t new_word =
+            synapse_structure_get_final_synaptic_word(final_state);
+        if (new_word != *plastic_words) {
+            *plastic_words = new_word;
+            if (first_changed == NULL) {
+                first_changed = plastic_words;
+            }
+            end_changed = plastic_words + 1;
+        }
+        plastic_words++;
     }
 
     log_debug("Adding pre-synaptic event to trace at time:%u", time);
@@ -213,6 +239,14 @@ bool synapse_dynamics_process_plastic_synapses(
     pre_events_add(time, event_history, timing_add_pre_spike(
         time, last_pre_time, last_pre_trace));
 
+    // The event history always changes, as it holds this spike
+    if (first_changed == NULL) {
+        first_changed = end_changed;
+    }
+    synapse_dynamics_write_back_add_bytes(
+        write_back, sizeof(pre_event_history_t) / sizeof(uint32_t),
+        (uint8_t *) first_changed - (uint8_t *) plastic_region_address,
+        (uint8_t *) end_changed - (uint8_t *) plastic_region_address);
     return true;
 }
 
@@ -222,9 +256,8 @@ void synapse_dynamics_process_post_synaptic_event(
 
     // Add post-event
     post_event_history_t *history = &post_event_history[neuron_index];
-    const uint32_t last_post_time = history->times[history->count_minus_one];
-    const post_trace_t last_post_trace =
-        history->traces[history->count_minus_one];
+    const uint32_t last_post_time = post_events_last_time(history);
+    const post_trace_t last_post_trace = post_events_last_trace(history);
     post_events_add(time, history, timing_add_post_spike(time, last_post_time,
                                                          last_post_trace));
 }
@@ -3,6 +3,8 @@
 
 // sPyNNaker neural modelling includes
 #include "../../synapses.h"
+#include "../../weight_recording.h"
+#include "../synapse_dynamics.h"
 
 // Plasticity common includes
 #include "../common/maths.h"
@@ -14,40 +16,46 @@
 #include <debug.h>
 
 #ifdef SYNAPSE_BENCHMARK
+#include "../../../common/free_running_timer.h"
+#include "weight_update_benchmark.h"
+
  uint32_t num_plastic_pre_synaptic_events;
+ uint32_t num_plastic_row_cycles;
 #endif  // SYNAPSE_BENCHMARK
 
 //---------------------------------------
 // Macros
 //---------------------------------------
 // The plastic control words used by Morrison synapses store an axonal delay
-// in the upper 3 bits.
-// Assuming a maximum of 16 delay slots, this is all that is required as:
+// in the upper bits.
+// Assuming a maximum of 16 delay slots:
 //
-// 1) Dendritic + Axonal <= 15
+// 1) Dendritic + Axonal <= 16
 // 2) Dendritic >= Axonal
 //
 // Therefore:
 //
-// * Maximum value of dendritic delay is 15 (with axonal delay of 0)
-//    - It requires 4 bits
-// * Maximum value of axonal delay is 7 (with dendritic delay of 8)
-//    - It requires 3 bits
+// * Maximum value of dendritic delay is 16 (with axonal delay of 0)
+//    - It requires 4 bits, as 16 is stored as 0
+// * Maximum value of axonal delay is 8 (with dendritic delay of 8)
+//    - It is given the 3 bits left with 2 synapse types, or fewer with more;
+//      the host moves any axonal delay that does not fit to the dendritic
+//      delay, which still satisfies 2)
 //
 // |        Axonal delay       |  Dendritic delay   |       Type        |      Index         |
 // |---------------------------|--------------------|-------------------|--------------------|
 // | SYNAPSE_AXONAL_DELAY_BITS | SYNAPSE_DELAY_BITS | SYNAPSE_TYPE_BITS | SYNAPSE_INDEX_BITS |
 // |                           |                    |        SYNAPSE_TYPE_INDEX_BITS         |
 // |---------------------------|--------------------|----------------------------------------|
+#define SYNAPSE_DELAY_TYPE_INDEX_BITS \
+    (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_INDEX_BITS)
+
 #ifndef SYNAPSE_AXONAL_DELAY_BITS
-#define SYNAPSE_AXONAL_DELAY_BITS 3
+#define SYNAPSE_AXONAL_DELAY_BITS (16 - SYNAPSE_DELAY_TYPE_INDEX_BITS)
 #endif
 
 #define SYNAPSE_AXONAL_DELAY_MASK ((1 << SYNAPSE_AXONAL_DELAY_BITS) - 1)
 
-#define SYNAPSE_DELAY_TYPE_INDEX_BITS \
-    (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_INDEX_BITS)
-
 #if (SYNAPSE_DELAY_TYPE_INDEX_BITS + SYNAPSE_AXONAL_DELAY_BITS) > 16
 #error "Not enough bits for axonal synaptic delay bits"
 #endif
@@ -65,45 +73,82 @@ post_event_history_t *post_event_history;
 //---------------------------------------
 // Synapse update loop
 //---------------------------------------
-static inline final_state_t _plasticity_update_synapse(
-        uint32_t time,
-        const uint32_t last_pre_time, const pre_trace_t last_pre_trace,
-        const pre_trace_t new_pre_trace, const uint32_t delay_dendritic,
-        const uint32_t delay_axonal, update_state_t current_state,
-        const post_event_history_t *post_event_history) {
-
-    // Apply axonal delay to time of last presynaptic spike
-    const uint32_t delayed_last_pre_time = last_pre_time + delay_axonal;
-
-    // Get the post-synaptic window of events to be processed
-    const uint32_t window_begin_time = delayed_last_pre_time - delay_dendritic;
-    const uint32_t window_end_time = time + delay_axonal - delay_dendritic;
+//! \brief gets the window of post-synaptic events to pair with a
+//!        pre-synaptic spike: those that reached the synapse, dendritic delay
+//!        after they were emitted, after the last pre-synaptic spike and no
+//!        later than this one, which reaches it axonal delay after it was
+//!        emitted; as the axonal delay is no more than the dendritic delay,
+//!        all of these events have already happened.
+static inline post_event_window_t _get_post_window(
+        const post_event_history_t *post_event_history,
+        uint32_t delayed_last_pre_time, uint32_t delayed_pre_time,
+        uint32_t delay_dendritic) {
+
+    // The times are clamped at zero for spikes near the start of the run
+    const uint32_t window_begin_time =
+        (delayed_last_pre_time > delay_dendritic) ?
+            (delayed_last_pre_time - delay_dendritic) : 0;
+    const uint32_t window_end_time = (delayed_pre_time > delay_dendritic) ?
+        (delayed_pre_time - delay_dendritic) : 0;
     post_event_window_t post_window = post_events_get_window_delayed(
             post_event_history, window_begin_time, window_end_time);
 
-    log_debug("\tPerforming deferred synapse update at time:%u", time);
+    // The previous event is found at the time it was emitted, so delay it to
+    // the time it reached the synapse, as the events in the window are
+    post_window.prev_time += delay_dendritic;
+
     log_debug("\t\tbegin_time:%u, end_time:%u - prev_time:%u, num_events:%u",
         window_begin_time, window_end_time, post_window.prev_time,
         post_window.num_events);
+    return post_window;
+}
+
+//! \brief applies the events of a post-synaptic window to a state, leaving
+//!        the window at its last event
+static inline update_state_t _apply_post_window(
+        post_event_window_t *post_window, uint32_t delayed_last_pre_time,
+        pre_trace_t last_pre_trace, uint32_t delay_dendritic,
+        update_state_t current_state) {
 
     // Process events in post-synaptic window
-    while (post_window.num_events > 0) {
-        const uint32_t delayed_post_time = *post_window.next_time
+    while (post_window->num_events > 0) {
+        const uint32_t delayed_post_time = *post_window->next_time
                                            + delay_dendritic;
         log_debug("\t\tApplying post-synaptic event at delayed time:%u\n",
               delayed_post_time);
 
         // Apply spike to state
         current_state = timing_apply_post_spike(
-            delayed_post_time, *post_window.next_trace, delayed_last_pre_time,
-            last_pre_trace, post_window.prev_time, post_window.prev_trace,
+            delayed_post_time, *post_window->next_trace, delayed_last_pre_time,
+            last_pre_trace, post_window->prev_time, post_window->prev_trace,
             current_state);
 
         // Go onto next event
-        post_window = post_events_next_delayed(post_window, delayed_post_time);
+        *post_window = post_events_next_delayed(
+            *post_window, delayed_post_time);
     }
+    return current_state;
+}
+
+static inline final_state_t _plasticity_update_synapse(
+        uint32_t time,
+        const uint32_t last_pre_time, const pre_trace_t last_pre_trace,
+        const pre_trace_t new_pre_trace, const uint32_t delay_dendritic,
+        const uint32_t delay_axonal, update_state_t current_state,
+        const post_event_history_t *post_event_history) {
 
+    // Apply axonal delay to time of last presynaptic spike
+    const uint32_t delayed_last_pre_time = last_pre_time + delay_axonal;
     const uint32_t delayed_pre_time = time + delay_axonal;
+
+    log_debug("\tPerforming deferred synapse update at time:%u", time);
+    post_event_window_t post_window = _get_post_window(
+        post_event_history, delayed_last_pre_time, delayed_pre_time,
+        delay_dendritic);
+    current_state = _apply_post_window(
+        &post_window, delayed_last_pre_time, last_pre_trace, delay_dendritic,
+        current_state);
+
     log_debug("\t\tApplying pre-synaptic event at time:%u last post time:%u\n",
               delayed_pre_time, post_window.prev_time);
 
@@ -117,10 +162,136 @@ static inline final_state_t _plasticity_update_synapse(
     return synapse_structure_get_final_state(current_state);
 }
 
+#ifdef SYNAPSE_UPDATES_COMMUTE
+//---------------------------------------
+// Window updates
+//---------------------------------------
+// When the weight dependence only accumulates the updates of each event, to
+// apply them all at the end, the updates from the post-synaptic events in
+// the window of a synapse do not depend on the synapse, only on the window,
+// the pre-synaptic trace and the dendritic delay.  A row is therefore
+// processed in two passes: the first finds the updates of the window of each
+// synapse, reusing those last found for the same post-synaptic neuron if the
+// window is the same and the neuron has not spiked since; the second adds
+// them to each synapse and pairs the pre-synaptic spike with the last event
+// of the window, without a loop over the events.
+
+// The number of synapses of a row whose window updates are found in the first
+// pass before they are applied in the second
+#define N_WINDOW_UPDATES 32
+
+// A window end time that no window has, to mark a cached update as invalid
+#define INVALID_WINDOW_END_TIME UINT32_MAX
+
+//! The updates from the events of a post-synaptic window, accumulated from
+//! zero, and the last event of the window, at the time it reached the
+//! synapse
+typedef struct {
+    update_state_t updates;
+    uint32_t prev_time;
+    post_trace_t prev_trace;
+} window_update_t;
+
+//! The window update last found for a post-synaptic neuron, and the window it
+//! was found for
+typedef struct {
+    uint32_t delayed_last_pre_time;
+    uint32_t window_end_time;
+    uint32_t delay_dendritic;
+    pre_trace_t last_pre_trace;
+    window_update_t update;
+} window_cache_t;
+
+static window_cache_t *window_cache;
+
+static window_update_t window_updates[N_WINDOW_UPDATES];
+
+#ifdef SYNAPSE_BENCHMARK
+static uint32_t num_window_updates_found;
+static uint32_t num_window_updates_reused;
+static uint32_t num_first_pass_cycles;
+static uint32_t num_second_pass_cycles;
+#endif  // SYNAPSE_BENCHMARK
+
+static inline bool _window_cache_initialise(uint32_t n_neurons) {
+    window_cache = (window_cache_t *) spin1_malloc(
+        n_neurons * sizeof(window_cache_t));
+    if (window_cache == NULL) {
+        log_error("Unable to allocate the post-synaptic window cache");
+        return false;
+    }
+    for (uint32_t n = 0; n < n_neurons; n++) {
+        window_cache[n].window_end_time = INVALID_WINDOW_END_TIME;
+    }
+    return true;
+}
+
+//! \brief gets the updates from the post-synaptic window of a synapse,
+//!        reusing those found for an earlier synapse to the same neuron if
+//!        the window is the same
+static inline const window_update_t *_get_window_update(
+        index_t neuron_index, uint32_t delayed_last_pre_time,
+        pre_trace_t last_pre_trace, uint32_t delayed_pre_time,
+        uint32_t delay_dendritic) {
+    window_cache_t *cache = &window_cache[neuron_index];
+    const uint32_t window_end_time = (delayed_pre_time > delay_dendritic) ?
+        (delayed_pre_time - delay_dendritic) : 0;
+    if (cache->window_end_time == window_end_time
+            && cache->delayed_last_pre_time == delayed_last_pre_time
+            && cache->delay_dendritic == delay_dendritic
+            && memcmp(&cache->last_pre_trace, &last_pre_trace,
+                      sizeof(pre_trace_t)) == 0) {
+#ifdef SYNAPSE_BENCHMARK
+        num_window_updates_reused++;
+#endif  // SYNAPSE_BENCHMARK
+        return &cache->update;
+    }
+
+#ifdef SYNAPSE_BENCHMARK
+    num_window_updates_found++;
+#endif  // SYNAPSE_BENCHMARK
+    post_event_window_t post_window = _get_post_window(
+        &post_event_history[neuron_index], delayed_last_pre_time,
+        delayed_pre_time, delay_dendritic);
+    cache->update.updates = _apply_post_window(
+        &post_window, delayed_last_pre_time, last_pre_trace, delay_dendritic,
+        synapse_structure_get_update_state(0, 0));
+    cache->update.prev_time = post_window.prev_time;
+    cache->update.prev_trace = post_window.prev_trace;
+    cache->delayed_last_pre_time = delayed_last_pre_time;
+    cache->window_end_time = window_end_time;
+    cache->delay_dendritic = delay_dendritic;
+    cache->last_pre_trace = last_pre_trace;
+    return &cache->update;
+}
+#endif  // SYNAPSE_UPDATES_COMMUTE
+
 //---------------------------------------
 // Synaptic row plastic-region implementation
 //---------------------------------------
-static inline plastic_synapse_t* _plastic_synapses(
+// With PLASTIC_ROWS_INTERLEAVED, the plastic region holds a word per synapse
+// after the event history, with the control word in the lower half and the
+// plastic synapse in the upper, as in a fixed synapse word.  The synapses are
+// then read from one array, and the fixed region holds only their count.
+//
+//   0:  [ Event history                                            ]
+//   H:  [ 1st plastic synapse          | 1st plastic control word  ]
+//   ...
+// H+P-1:[ Last plastic synapse         | Last plastic control word ]
+//
+// Without it, the control words follow the fixed synapses in the fixed
+// region, and the plastic synapses follow the event history on their own.
+#ifdef PLASTIC_ROWS_INTERLEAVED
+#define PLASTIC_ROW_STRIDE 2
+
+static_assert(sizeof(plastic_synapse_t) == sizeof(control_t),
+              "Only plastic synapses of 16 bits can be interleaved with"
+              " their control words");
+#else
+#define PLASTIC_ROW_STRIDE 1
+#endif  // PLASTIC_ROWS_INTERLEAVED
+
+static inline address_t _plastic_row_synapse_words(
         address_t plastic_region_address) {
     const uint32_t pre_event_history_size_words =
         sizeof(pre_event_history_t) / sizeof(uint32_t);
@@ -129,8 +300,34 @@ static inline plastic_synapse_t* _plastic_synapses(
                   "Size of pre_event_history_t structure should be a multiple"
                   " of 32-bit words");
 
-    return (plastic_synapse_t*)
-        (&plastic_region_address[pre_event_history_size_words]);
+    return &plastic_region_address[pre_event_history_size_words];
+}
+
+//! \brief returns the first plastic synapse of a row; each synapse after it
+//!        is PLASTIC_ROW_STRIDE on from the one before
+static inline plastic_synapse_t* _plastic_synapses(
+        address_t plastic_region_address) {
+    plastic_synapse_t *synapses = (plastic_synapse_t *)
+        _plastic_row_synapse_words(plastic_region_address);
+#ifdef PLASTIC_ROWS_INTERLEAVED
+    return &synapses[1];
+#else
+    return synapses;
+#endif  // PLASTIC_ROWS_INTERLEAVED
+}
+
+//! \brief returns the first plastic control word of a row; each control word
+//!        after it is PLASTIC_ROW_STRIDE on from the one before
+static inline const control_t *_plastic_controls(
+        address_t plastic_region_address, address_t fixed_region_address) {
+#ifdef PLASTIC_ROWS_INTERLEAVED
+    use(fixed_region_address);
+    return (const control_t *) _plastic_row_synapse_words(
+        plastic_region_address);
+#else
+    use(plastic_region_address);
+    return synapse_row_plastic_controls(fixed_region_address);
+#endif  // PLASTIC_ROWS_INTERLEAVED
 }
 
 //---------------------------------------
@@ -147,11 +344,11 @@ void synapse_dynamics_print_plastic_synapses(
     use(ring_buffer_to_input_buffer_left_shifts);
 #if LOG_LEVEL >= LOG_DEBUG
 
-    // Extract separate arrays of weights (from plastic region),
-    // Control words (from fixed region) and number of plastic synapses
+    // Extract the weights and control words (both from the plastic region
+    // when interleaved) and number of plastic synapses
     weight_t *plastic_words = _plastic_synapses(plastic_region_address);
-    const control_t *control_words = synapse_row_plastic_controls(
-        fixed_region_address);
+    const control_t *control_words = _plastic_controls(
+        plastic_region_address, fixed_region_address);
     size_t plastic_synapse = synapse_row_num_plastic_controls(
         fixed_region_address);
     const pre_event_history_t *event_history = _plastic_event_history(
@@ -162,9 +359,11 @@ void synapse_dynamics_print_plastic_synapses(
     // Loop through plastic synapses
     for (uint32_t i = 0; i < plastic_synapse; i++) {
 
-        // Get next weight and control word (auto incrementing control word)
-        uint32_t weight = *plastic_words++;
-        uint32_t control_word = *control_words++;
+        // Get next weight and control word
+        uint32_t weight = *plastic_words;
+        uint32_t control_word = *control_words;
+        plastic_words += PLASTIC_ROW_STRIDE;
+        control_words += PLASTIC_ROW_STRIDE;
         uint32_t synapse_type = synapse_row_sparse_type(control_word);
 
         log_debug("%08x [%3d: (w: %5u (=", control_word, i, weight);
@@ -184,13 +383,20 @@ static inline index_t _sparse_axonal_delay(uint32_t x) {
     return ((x >> SYNAPSE_DELAY_TYPE_INDEX_BITS) & SYNAPSE_AXONAL_DELAY_MASK);
 }
 
+//---------------------------------------
+// A dendritic delay of a whole ring buffer is stored as 0, which lands in the
+// same ring buffer slot, but the timing rule needs the real delay
+static inline index_t _sparse_dendritic_delay(uint32_t x) {
+    return ((synapse_row_sparse_delay(x) - 1) & SYNAPSE_DELAY_MASK) + 1;
+}
+
 bool synapse_dynamics_initialise(
         address_t address, uint32_t n_neurons,
         uint32_t *ring_buffer_to_input_buffer_left_shifts) {
 
     // Load timing dependence data
     address_t weight_region_address = timing_initialise(address);
-    if (address == NULL) {
+    if (weight_region_address == NULL) {
         return false;
     }
 
@@ -206,19 +412,67 @@ bool synapse_dynamics_initialise(
         return false;
     }
 
+#ifdef SYNAPSE_UPDATES_COMMUTE
+    if (!_window_cache_initialise(n_neurons)) {
+        return false;
+    }
+#endif  // SYNAPSE_UPDATES_COMMUTE
+
+#ifdef SYNAPSE_BENCHMARK
+    free_running_timer_start();
+    weight_update_benchmark();
+#endif  // SYNAPSE_BENCHMARK
+
     return true;
 }
 
+//! \brief adds the weight of a synapse to the ring buffers and stores it
+//!        in the plastic region, noting the span of the words that changed,
+//!        as only these need to be written back to SDRAM, and recording the
+//!        weight if the row is recorded
+static inline void _finish_synapse(
+        final_state_t final_state, uint32_t control_word,
+        uint32_t ring_buffer_index, weight_t *ring_buffers,
+        plastic_synapse_t *plastic_word, plastic_synapse_t **first_changed,
+        plastic_synapse_t **end_changed) {
+
+    // Add weight to ring-buffer entry
+    // **NOTE** Dave suspects that this could be a
+    // potential location for overflow
+    weight_t weight = synapse_structure_get_final_weight(final_state);
+    ring_buffers[ring_buffer_index] += weight;
+
+    // Write back updated synaptic word to plastic region
+    plastic_synapse_t new_word =
+        synapse_structure_get_final_synaptic_word(final_state);
+    if (new_word != *plastic_word) {
+        *plastic_word = new_word;
+        if (*first_changed == NULL) {
+            *first_changed = plastic_word;
+        }
+        *end_changed = plastic_word + 1;
+        weight_recording_record_synapse(control_word, weight);
+    }
+}
+
 bool synapse_dynamics_process_plastic_synapses(
         address_t plastic_region_address, address_t fixed_region_address,
-        weight_t *ring_buffers, uint32_t time) {
+        weight_t *ring_buffers, uint32_t time,
+        plastic_write_back_t *write_back) {
+
+#ifdef SYNAPSE_BENCHMARK
+    uint32_t row_start = free_running_timer_now();
+#endif  // SYNAPSE_BENCHMARK
 
-    // Extract separate arrays of plastic synapses (from plastic region),
-    // Control words (from fixed region) and number of plastic synapses
+    // Extract the plastic synapses (from plastic region), control words
+    // (from fixed region, or plastic region when interleaved) and number of
+    // plastic synapses
     plastic_synapse_t *plastic_words = _plastic_synapses(
         plastic_region_address);
-    const control_t *control_words = synapse_row_plastic_controls(
-        fixed_region_address);
+    plastic_synapse_t *first_changed = NULL;
+    plastic_synapse_t *end_changed = NULL;
+    const control_t *control_words = _plastic_controls(
+        plastic_region_address, fixed_region_address);
     size_t plastic_synapse = synapse_row_num_plastic_controls(
         fixed_region_address);
 
@@ -240,17 +494,76 @@ bool synapse_dynamics_process_plastic_synapses(
     event_history->prev_trace = timing_add_pre_spike(time, last_pre_time,
                                                      last_pre_trace);
 
+#ifdef SYNAPSE_UPDATES_COMMUTE
+
+    // Process the synapses a block at a time, finding the updates of their
+    // windows in the first pass and applying them in the second
+    while (plastic_synapse > 0) {
+        uint32_t n_block = MIN(plastic_synapse, N_WINDOW_UPDATES);
+        plastic_synapse -= n_block;
+
+#ifdef SYNAPSE_BENCHMARK
+        uint32_t start = free_running_timer_now();
+#endif  // SYNAPSE_BENCHMARK
+        for (uint32_t i = 0; i < n_block; i++) {
+            uint32_t control_word = control_words[i * PLASTIC_ROW_STRIDE];
+            uint32_t delay_axonal = _sparse_axonal_delay(control_word);
+            window_updates[i] = *_get_window_update(
+                synapse_row_sparse_index(control_word),
+                last_pre_time + delay_axonal, last_pre_trace,
+                time + delay_axonal, _sparse_dendritic_delay(control_word));
+        }
+#ifdef SYNAPSE_BENCHMARK
+        num_first_pass_cycles += free_running_timer_elapsed(start);
+        start = free_running_timer_now();
+#endif  // SYNAPSE_BENCHMARK
+
+        for (uint32_t i = 0; i < n_block; i++) {
+            uint32_t control_word = *control_words;
+            control_words += PLASTIC_ROW_STRIDE;
+            uint32_t delay_axonal = _sparse_axonal_delay(control_word);
+            uint32_t delay_dendritic = _sparse_dendritic_delay(control_word);
+            uint32_t type = synapse_row_sparse_type(control_word);
+            uint32_t type_index = synapse_row_sparse_type_index(control_word);
+            const window_update_t *update = &window_updates[i];
+
+            // Add the updates of the window to the synapse, and pair the
+            // pre-synaptic spike with the last event of the window
+            update_state_t current_state = synapse_structure_get_update_state(
+                *plastic_words, type);
+            current_state = synapse_structure_add_updates(
+                current_state, update->updates);
+            current_state = timing_apply_pre_spike(
+                time + delay_axonal, event_history->prev_trace,
+                last_pre_time + delay_axonal, last_pre_trace,
+                update->prev_time, update->prev_trace, current_state);
+
+            _finish_synapse(
+                synapse_structure_get_final_state(current_state), control_word,
+                synapses_get_ring_buffer_index_combined(
+                    delay_axonal + delay_dendritic + time, type_index),
+                ring_buffers, plastic_words, &first_changed, &end_changed);
+            plastic_words += PLASTIC_ROW_STRIDE;
+        }
+#ifdef SYNAPSE_BENCHMARK
+        num_second_pass_cycles += free_running_timer_elapsed(start);
+#endif  // SYNAPSE_BENCHMARK
+    }
+
+#else  // SYNAPSE_UPDATES_COMMUTE
+
     // Loop through plastic synapses
     for (; plastic_synapse > 0; plastic_synapse--) {
 
-        // Get next control word (auto incrementing)
-        uint32_t control_word = *control_words++;
+        // Get next control word
+        uint32_t control_word = *control_words;
+        control_words += PLASTIC_ROW_STRIDE;
 
         // Extract control-word components
         // **NOTE** cunningly, control word is just the same as lower
         // 16-bits of 32-bit fixed synapse so same functions can be used
-        uint32_t delay_axonal = 0;    //_sparse_axonal_delay(control_word);
-        uint32_t delay_dendritic = synapse_row_sparse_delay(control_word);
+        uint32_t delay_axonal = _sparse_axonal_delay(control_word);
+        uint32_t delay_dendritic = _sparse_dendritic_delay(control_word);
         uint32_t type = synapse_row_sparse_type(control_word);
         uint32_t index = synapse_row_sparse_index(control_word);
         uint32_t type_index = synapse_row_sparse_type_index(control_word);
@@ -266,19 +579,34 @@ bool synapse_dynamics_process_plastic_synapses(
             &post_event_history[index]);
 
         // Convert into ring buffer offset
-        uint32_t ring_buffer_index = synapses_get_ring_buffer_index_combined(
-                delay_axonal + delay_dendritic + time, type_index);
-
-        // Add weight to ring-buffer entry
-        // **NOTE** Dave suspects that this could be a
-        // potential location for overflow
-        ring_buffers[ring_buffer_index] += synapse_structure_get_final_weight(
-            final_state);
-
-        // Write back updated synaptic word to plastic region
-        *plastic_words++ = synapse_structure_get_final_synaptic_word(
-            final_state);
+        _finish_synapse(
+            final_state, control_word,
+            synapses_get_ring_buffer_index_combined(
+                delay_axonal + delay_dendritic + time, type_index),
+            ring_buffers, plastic_words, &first_changed, &end_changed);
+        plastic_words += PLASTIC_ROW_STRIDE;
     }
+
+#endif  // SYNAPSE_UPDATES_COMMUTE
+
+    // The event history always changes, as it holds the time of this spike;
+    // when interleaved, the span of synapses changed starts part way into a
+    // word, and the words holding it are written back with their controls
+    uint32_t first_changed_byte = 0;
+    uint32_t end_changed_byte = 0;
+    if (first_changed != NULL) {
+        first_changed_byte =
+            (uint8_t *) first_changed - (uint8_t *) plastic_region_address;
+        end_changed_byte =
+            (uint8_t *) end_changed - (uint8_t *) plastic_region_address;
+    }
+    synapse_dynamics_write_back_add_bytes(
+        write_back, sizeof(pre_event_history_t) / sizeof(uint32_t),
+        first_changed_byte, end_changed_byte);
+
+#ifdef SYNAPSE_BENCHMARK
+    num_plastic_row_cycles += free_running_timer_elapsed(row_start);
+#endif  // SYNAPSE_BENCHMARK
     return true;
 }
 
@@ -288,21 +616,32 @@ void synapse_dynamics_process_post_synaptic_event(
 
     // Add post-event
     post_event_history_t *history = &post_event_history[neuron_index];
-    const uint32_t last_post_time = history->times[history->count_minus_one];
-    const post_trace_t last_post_trace =
-        history->traces[history->count_minus_one];
+    const uint32_t last_post_time = post_events_last_time(history);
+    const post_trace_t last_post_trace = post_events_last_trace(history);
     post_events_add(time, history, timing_add_post_spike(time, last_post_time,
                                                          last_post_trace));
+
+#ifdef SYNAPSE_UPDATES_COMMUTE
+    // Any window update found for the neuron may now be out of date
+    window_cache[neuron_index].window_end_time = INVALID_WINDOW_END_TIME;
+#endif  // SYNAPSE_UPDATES_COMMUTE
 }
 
 input_t synapse_dynamics_get_intrinsic_bias(uint32_t time, index_t neuron_index) {
     use(time);
     use(neuron_index);
-    return 0.0k;
+    return ZERO;
 }
 
 uint32_t synapse_dynamics_get_plastic_pre_synaptic_events(){
 #ifdef SYNAPSE_BENCHMARK
+    log_info("Plastic rows processed in %u cycles", num_plastic_row_cycles);
+#ifdef SYNAPSE_UPDATES_COMMUTE
+    log_info(
+        "Window updates found %u, reused %u; cycles in first pass %u, in "
+        "second pass %u", num_window_updates_found, num_window_updates_reused,
+        num_first_pass_cycles, num_second_pass_cycles);
+#endif  // SYNAPSE_UPDATES_COMMUTE
     return num_plastic_pre_synaptic_events;
 #else
     return 0;
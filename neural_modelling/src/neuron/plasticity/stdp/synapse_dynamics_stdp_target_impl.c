@@ -3,6 +3,7 @@
 
 // sPyNNaker neural modelling includes
 #include "../../synapses.h"
+#include "../synapse_dynamics.h"
 
 // Plasticity common includes
 #include "../common/maths.h"
@@ -16,6 +17,17 @@
 // to start and end learning patterns
 #include "timing_dependence/timing_target_pair_impl.h"
 
+// The traces added to the post-synaptic history here do not follow from the
+// times of the events, so they cannot be found again from a compact history
+#ifdef POST_EVENTS_COMPACT
+#error "The target STDP rule cannot use the compact post-synaptic history"
+#endif  // POST_EVENTS_COMPACT
+
+// The plastic synapses here are wider than their control words
+#ifdef PLASTIC_ROWS_INTERLEAVED
+#error "The target STDP rule cannot interleave its plastic rows"
+#endif  // PLASTIC_ROWS_INTERLEAVED
+
 #ifdef SYNAPSE_BENCHMARK
  uint32_t num_plastic_pre_synaptic_events;
 #endif  // SYNAPSE_BENCHMARK
@@ -327,7 +339,7 @@ bool synapse_dynamics_initialise(
 
     // Load timing dependence data
     address_t weight_region_address = timing_initialise(address);
-    if (address == NULL) {
+    if (weight_region_address == NULL) {
         return false;
     }
 
@@ -348,12 +360,14 @@ bool synapse_dynamics_initialise(
 
 bool synapse_dynamics_process_plastic_synapses(
         address_t plastic_region_address, address_t fixed_region_address,
-        weight_t *ring_buffers, uint32_t time) {
+        weight_t *ring_buffers, uint32_t time,
+        plastic_write_back_t *write_back) {
 
     // Extract separate arrays of plastic synapses (from plastic region),
     // Control words (from fixed region) and number of plastic synapses
     plastic_synapse_t *plastic_words = _plastic_synapses(
         plastic_region_address);
+    const plastic_synapse_t *first_synapse = plastic_words;
     const control_t *control_words = synapse_row_plastic_controls(
         fixed_region_address);
     size_t plastic_synapse = synapse_row_num_plastic_controls(
@@ -412,6 +426,13 @@ bool synapse_dynamics_process_plastic_synapses(
         *plastic_words++ = synapse_structure_get_final_synaptic_word(
             final_state);
     }
+
+    // The accumulators change with almost every spike, so the whole region
+    // is written back
+    synapse_dynamics_write_back_add_bytes(
+        write_back, sizeof(pre_event_history_t) / sizeof(uint32_t),
+        (uint8_t *) first_synapse - (uint8_t *) plastic_region_address,
+        (uint8_t *) plastic_words - (uint8_t *) plastic_region_address);
     return true;
 }
 
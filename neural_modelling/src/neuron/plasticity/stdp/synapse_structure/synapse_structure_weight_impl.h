@@ -22,6 +22,17 @@ static inline update_state_t synapse_structure_get_update_state(
     return weight_get_initial(synaptic_word, synapse_type);
 }
 
+//---------------------------------------
+#ifdef WEIGHT_UPDATES_COMMUTE
+// The update state is the weight state, so its updates commute too
+#define SYNAPSE_UPDATES_COMMUTE
+
+static inline update_state_t synapse_structure_add_updates(
+        update_state_t state, update_state_t updates) {
+    return weight_add_updates(state, updates);
+}
+#endif  // WEIGHT_UPDATES_COMMUTE
+
 //---------------------------------------
 static inline final_state_t synapse_structure_get_final_state(
         update_state_t state) {
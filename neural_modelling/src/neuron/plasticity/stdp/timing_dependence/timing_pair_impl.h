@@ -16,31 +16,23 @@ typedef int16_t pre_trace_t;
 
 // Include generic plasticity maths functions
 #include "../../common/maths.h"
+#include "../../common/exp_decay.h"
 #include "../../common/stdp_typedefs.h"
 
 //---------------------------------------
 // Macros
 //---------------------------------------
-// Exponential decay lookup parameters
-#define TAU_PLUS_TIME_SHIFT 0
-#define TAU_PLUS_SIZE 256
-
-#define TAU_MINUS_TIME_SHIFT 0
-#define TAU_MINUS_SIZE 256
-
 // Helper macros for looking up decays
 #define DECAY_LOOKUP_TAU_PLUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_PLUS_TIME_SHIFT, TAU_PLUS_SIZE, tau_plus_lookup)
+    exp_decay_lookup(time, &tau_plus_decay)
 #define DECAY_LOOKUP_TAU_MINUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_MINUS_TIME_SHIFT, TAU_MINUS_SIZE, tau_minus_lookup)
+    exp_decay_lookup(time, &tau_minus_decay)
 
 //---------------------------------------
 // Externals
 //---------------------------------------
-extern int16_t tau_plus_lookup[TAU_PLUS_SIZE];
-extern int16_t tau_minus_lookup[TAU_MINUS_SIZE];
+extern exp_decay_lut_t tau_plus_decay;
+extern exp_decay_lut_t tau_minus_decay;
 
 //---------------------------------------
 // Timing dependence inline functions
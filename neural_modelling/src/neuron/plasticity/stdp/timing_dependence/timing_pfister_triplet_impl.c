@@ -3,11 +3,11 @@
 //---------------------------------------
 // Globals
 //---------------------------------------
-// Exponential lookup-tables
-int16_t tau_plus_lookup[TAU_PLUS_SIZE];
-int16_t tau_minus_lookup[TAU_MINUS_SIZE];
-int16_t tau_x_lookup[TAU_X_SIZE];
-int16_t tau_y_lookup[TAU_Y_SIZE];
+// Exponential decay lookup-tables
+exp_decay_lut_t tau_plus_decay;
+exp_decay_lut_t tau_minus_decay;
+exp_decay_lut_t tau_x_decay;
+exp_decay_lut_t tau_y_decay;
 
 //---------------------------------------
 // Functions
@@ -19,14 +19,23 @@ address_t timing_initialise(address_t address) {
     // **TODO** assert number of neurons is less than max
 
     // Copy LUTs from following memory
-    address_t lut_address = maths_copy_int16_lut(&address[0], TAU_PLUS_SIZE,
-                                                 &tau_plus_lookup[0]);
-    lut_address = maths_copy_int16_lut(lut_address, TAU_MINUS_SIZE,
-                                       &tau_minus_lookup[0]);
-    lut_address = maths_copy_int16_lut(lut_address, TAU_X_SIZE,
-                                       &tau_x_lookup[0]);
-    lut_address = maths_copy_int16_lut(lut_address, TAU_Y_SIZE,
-                                       &tau_y_lookup[0]);
+    address_t lut_address = exp_decay_lut_initialise(
+        &address[0], &tau_plus_decay);
+    if (lut_address == NULL) {
+        return NULL;
+    }
+    lut_address = exp_decay_lut_initialise(lut_address, &tau_minus_decay);
+    if (lut_address == NULL) {
+        return NULL;
+    }
+    lut_address = exp_decay_lut_initialise(lut_address, &tau_x_decay);
+    if (lut_address == NULL) {
+        return NULL;
+    }
+    lut_address = exp_decay_lut_initialise(lut_address, &tau_y_decay);
+    if (lut_address == NULL) {
+        return NULL;
+    }
 
     log_info("timing_initialise: completed successfully");
 
@@ -1,18 +1,18 @@
 #ifndef _TIMING_PFISTER_TRIPLET_IMPL_H_
 #define _TIMING_PFISTER_TRIPLET_IMPL_H_
 
+// Include generic plasticity maths functions
+#include "../../common/maths.h"
+
 //---------------------------------------
 // Structures
 //---------------------------------------
-typedef struct post_trace_t {
-  int16_t o1;
-  int16_t o2;
-} post_trace_t;
-
-typedef struct pre_trace_t {
-  int16_t r1;
-  int16_t r2;
-} pre_trace_t;
+// Each trace is a pair of 16-bit traces packed into a word, laid out as a
+// structure of the two would be: o1 (r1) in the bottom half and o2 (r2) in the
+// top.  The multiplies select the half they need from the word, so the traces
+// are never unpacked.
+typedef maths_pair16_t post_trace_t;
+typedef maths_pair16_t pre_trace_t;
 
 #include "../synapse_structure/synapse_structure_weight_impl.h"
 #include "timing.h"
@@ -21,54 +21,35 @@ typedef struct pre_trace_t {
 // Include debug header for log_info etc
 #include <debug.h>
 
-// Include generic plasticity maths functions
-#include "../../common/maths.h"
+#include "../../common/exp_decay.h"
 #include "../../common/stdp_typedefs.h"
 
 //---------------------------------------
 // Macros
 //---------------------------------------
-// Exponential decay lookup parameters
-#define TAU_PLUS_TIME_SHIFT 0
-#define TAU_PLUS_SIZE 256
-
-#define TAU_MINUS_TIME_SHIFT 0
-#define TAU_MINUS_SIZE 256
-
-#define TAU_X_TIME_SHIFT 2
-#define TAU_X_SIZE 256
-
-#define TAU_Y_TIME_SHIFT 2
-#define TAU_Y_SIZE 256
-
 // Helper macros for looking up decays
 #define DECAY_LOOKUP_TAU_PLUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_PLUS_TIME_SHIFT, TAU_PLUS_SIZE, tau_plus_lookup)
+    exp_decay_lookup(time, &tau_plus_decay)
 #define DECAY_LOOKUP_TAU_MINUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_MINUS_TIME_SHIFT, TAU_MINUS_SIZE, tau_minus_lookup)
-
+    exp_decay_lookup(time, &tau_minus_decay)
 #define DECAY_LOOKUP_TAU_X(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_X_TIME_SHIFT, TAU_X_SIZE, tau_x_lookup)
+    exp_decay_lookup(time, &tau_x_decay)
 #define DECAY_LOOKUP_TAU_Y(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_Y_TIME_SHIFT, TAU_Y_SIZE, tau_y_lookup)
+    exp_decay_lookup(time, &tau_y_decay)
 
 //---------------------------------------
 // Externals
 //---------------------------------------
-extern int16_t tau_plus_lookup[TAU_PLUS_SIZE];
-extern int16_t tau_minus_lookup[TAU_MINUS_SIZE];
-extern int16_t tau_x_lookup[TAU_X_SIZE];
-extern int16_t tau_y_lookup[TAU_Y_SIZE];
+extern exp_decay_lut_t tau_plus_decay;
+extern exp_decay_lut_t tau_minus_decay;
+extern exp_decay_lut_t tau_x_decay;
+extern exp_decay_lut_t tau_y_decay;
 
 //---------------------------------------
 // Timing dependence inline functions
 //---------------------------------------
 static inline post_trace_t timing_get_initial_post_trace() {
-  return (post_trace_t) {.o1 = 0, .o2 = 0};
+  return maths_pair16_pack(0, 0);
 }
 
 //---------------------------------------
@@ -79,23 +60,22 @@ static inline post_trace_t timing_add_post_spike(
     uint32_t delta_time = time - last_time;
 
     // Decay previous o1 trace and add energy caused by new spike
-    int32_t decayed_o1 = STDP_FIXED_MUL_16X16(last_trace.o1,
-            DECAY_LOOKUP_TAU_MINUS(delta_time));
-    int32_t new_o1 = decayed_o1 + STDP_FIXED_POINT_ONE;
+    int32_t new_o1 = STDP_FIXED_MUL_16X16_ADD(last_trace,
+            DECAY_LOOKUP_TAU_MINUS(delta_time), STDP_FIXED_POINT_ONE);
 
     // If this is the 1st post-synaptic event, o2 trace is zero
     // (as it's sampled BEFORE the spike),
     // otherwise, add on energy caused by last spike and decay that
     int32_t new_o2 = (last_time == 0)? 0:
                      STDP_FIXED_MUL_16X16(
-                        last_trace.o2 + STDP_FIXED_POINT_ONE,
+                        maths_pair16_top(last_trace) + STDP_FIXED_POINT_ONE,
                         DECAY_LOOKUP_TAU_Y(delta_time));
 
     log_debug("\tdelta_time=%d, o1=%d, o2=%d\n", delta_time, new_o1, new_o2);
 
     // Return new pre- synaptic event with decayed trace values with energy
     // for new spike added
-    return (post_trace_t) {.o1 = new_o1, .o2 = new_o2};
+    return maths_pair16_pack(new_o1, new_o2);
 }
 
 //---------------------------------------
@@ -106,23 +86,22 @@ static inline pre_trace_t timing_add_pre_spike(
     uint32_t delta_time = time - last_time;
 
     // Decay previous r1 trace and add energy caused by new spike
-    int32_t decayed_r1 = STDP_FIXED_MUL_16X16(last_trace.r1,
-            DECAY_LOOKUP_TAU_PLUS(delta_time));
-    int32_t new_r1 = decayed_r1 + STDP_FIXED_POINT_ONE;
+    int32_t new_r1 = STDP_FIXED_MUL_16X16_ADD(last_trace,
+            DECAY_LOOKUP_TAU_PLUS(delta_time), STDP_FIXED_POINT_ONE);
 
     // If this is the 1st pre-synaptic event, r2 trace is zero
     // (as it's sampled BEFORE the spike),
     // otherwise, add on energy caused by last spike  and decay that
     int32_t new_r2 = (last_time == 0)? 0:
                     STDP_FIXED_MUL_16X16(
-                        last_trace.r2 + STDP_FIXED_POINT_ONE,
+                        maths_pair16_top(last_trace) + STDP_FIXED_POINT_ONE,
                         DECAY_LOOKUP_TAU_X(delta_time));
 
     log_debug("\tdelta_time=%u, r1=%d, r2=%d\n", delta_time, new_r1, new_r2);
 
     // Return new pre-synaptic event with decayed trace values with energy
     // for new spike added
-    return (pre_trace_t) {.r1 = new_r1, .r2 = new_r2};
+    return maths_pair16_pack(new_r1, new_r2);
 }
 
 //---------------------------------------
@@ -136,15 +115,17 @@ static inline update_state_t timing_apply_pre_spike(
     // Get time of event relative to last post-synaptic event
     uint32_t time_since_last_post = time - last_post_time;
     if (time_since_last_post > 0) {
-        int32_t decayed_o1 = STDP_FIXED_MUL_16X16(last_post_trace.o1,
+
+        // **NOTE** the bottom half of the trace is o1
+        int32_t decayed_o1 = STDP_FIXED_MUL_16X16(last_post_trace,
             DECAY_LOOKUP_TAU_MINUS(time_since_last_post));
 
-        // Calculate triplet term
-        int32_t decayed_o1_r2 = STDP_FIXED_MUL_16X16(decayed_o1, trace.r2);
+        // Calculate triplet term, with r2 from the top half of the trace
+        int32_t decayed_o1_r2 = STDP_FIXED_MUL_16X16_TOP(decayed_o1, trace);
 
         log_debug("\t\t\ttime_since_last_post_event=%u, decayed_o1=%d, r2=%d,"
                   "decayed_o1_r2=%d\n", time_since_last_post, decayed_o1,
-                                        trace.r2, decayed_o1_r2);
+                  maths_pair16_top(trace), decayed_o1_r2);
 
         // Apply depression to state (which is a weight_state)
         return weight_two_term_apply_depression(previous_state, decayed_o1,
@@ -165,15 +146,17 @@ static inline update_state_t timing_apply_post_spike(
     // Get time of event relative to last pre-synaptic event
     uint32_t time_since_last_pre = time - last_pre_time;
     if (time_since_last_pre > 0) {
-        int32_t decayed_r1 = STDP_FIXED_MUL_16X16(last_pre_trace.r1,
+
+        // **NOTE** the bottom half of the trace is r1
+        int32_t decayed_r1 = STDP_FIXED_MUL_16X16(last_pre_trace,
             DECAY_LOOKUP_TAU_PLUS(time_since_last_pre));
 
-        // Calculate triplet term
-        int32_t decayed_r1_o2 = STDP_FIXED_MUL_16X16(decayed_r1, trace.o2);
+        // Calculate triplet term, with o2 from the top half of the trace
+        int32_t decayed_r1_o2 = STDP_FIXED_MUL_16X16_TOP(decayed_r1, trace);
 
         log_debug("\t\t\ttime_since_last_pre_event=%u, decayed_r1=%d, o2=%d,"
                   "decayed_r1_o2=%d\n", time_since_last_pre, decayed_r1,
-                                        trace.o2, decayed_r1_o2);
+                  maths_pair16_top(trace), decayed_r1_o2);
 
         // Apply potentiation to state (which is a weight_state)
         return weight_two_term_apply_potentiation(previous_state, decayed_r1,
@@ -3,8 +3,8 @@
 //---------------------------------------
 // Globals
 //---------------------------------------
-// Exponential lookup-tables
-int16_t tau_plus_lookup[TAU_PLUS_SIZE];
+// Exponential decay lookup-tables
+exp_decay_lut_t tau_plus_decay;
 
 //---------------------------------------
 // Functions
@@ -16,8 +16,11 @@ address_t timing_initialise(address_t address) {
     // **TODO** assert number of neurons is less than max
 
     // Copy LUTs from following memory
-    address_t lut_address = maths_copy_int16_lut(&address[0], TAU_PLUS_SIZE,
-                                                 &tau_plus_lookup[0]);
+    address_t lut_address = exp_decay_lut_initialise(
+        &address[0], &tau_plus_decay);
+    if (lut_address == NULL) {
+        return NULL;
+    }
 
     log_info("timing_initialise: completed successfully");
 
@@ -30,6 +30,11 @@ typedef struct {
 
 #include "weight_one_term.h"
 
+// Potentiation and depression are only accumulated until the final weight is
+// found, so the updates of a set of events can be accumulated apart from the
+// weight and added to it later
+#define WEIGHT_UPDATES_COMMUTE
+
 //---------------------------------------
 // Externals
 //---------------------------------------
@@ -64,6 +69,14 @@ static inline weight_state_t weight_one_term_apply_potentiation(
     return state;
 }
 
+//---------------------------------------
+static inline weight_state_t weight_add_updates(
+        weight_state_t state, weight_state_t updates) {
+    state.a2_plus += updates.a2_plus;
+    state.a2_minus += updates.a2_minus;
+    return state;
+}
+
 //---------------------------------------
 static inline weight_t weight_get_final(weight_state_t new_state) {
 
@@ -34,6 +34,11 @@ typedef struct weight_state_t {
 
 #include "weight_two_term.h"
 
+// Potentiation and depression are only accumulated until the final weight is
+// found, so the updates of a set of events can be accumulated apart from the
+// weight and added to it later
+#define WEIGHT_UPDATES_COMMUTE
+
 //---------------------------------------
 // Externals
 //---------------------------------------
@@ -72,6 +77,16 @@ static inline weight_state_t weight_two_term_apply_potentiation(
     return state;
 }
 
+//---------------------------------------
+static inline weight_state_t weight_add_updates(
+        weight_state_t state, weight_state_t updates) {
+    state.a2_plus += updates.a2_plus;
+    state.a2_minus += updates.a2_minus;
+    state.a3_plus += updates.a3_plus;
+    state.a3_minus += updates.a3_minus;
+    return state;
+}
+
 //---------------------------------------
 static inline weight_t weight_get_final(weight_state_t new_state) {
     // Scale potentiation and depression
@@ -6,7 +6,6 @@
 // Global plasticity parameter data
 plasticity_weight_region_data_t
     plasticity_weight_region_data[SYNAPSE_TYPE_COUNT];
-uint32_t weight_multiply_right_shift[SYNAPSE_TYPE_COUNT];
 
 //---------------------------------------
 // Functions
@@ -16,6 +15,9 @@ uint32_t *weight_initialise(uint32_t *address,
 
     log_info("weight_initialise: starting");
     log_info("\tSTDP multiplicative weight dependence");
+#ifdef WEIGHT_UPDATES_DEFERRED
+    log_info("\tUpdates deferred to the end of each synapse update");
+#endif  // WEIGHT_UPDATES_DEFERRED
 
     // Copy plasticity region data from address
     // **NOTE** this seems somewhat safer than relying on sizeof
@@ -28,7 +30,7 @@ uint32_t *weight_initialise(uint32_t *address,
         plasticity_weight_region_data[s].a2_minus = *plasticity_word++;
 
         // Calculate the right shift required to fixed-point multiply weights
-        weight_multiply_right_shift[s] =
+        plasticity_weight_region_data[s].weight_multiply_right_shift =
                 16 - (ring_buffer_to_input_buffer_left_shifts[s] + 1);
 
         log_info(
@@ -38,7 +40,7 @@ uint32_t *weight_initialise(uint32_t *address,
             plasticity_weight_region_data[s].max_weight,
             plasticity_weight_region_data[s].a2_plus,
             plasticity_weight_region_data[s].a2_minus,
-            weight_multiply_right_shift[s]);
+            plasticity_weight_region_data[s].weight_multiply_right_shift);
     }
 
     log_info("weight_initialise: completed successfully");
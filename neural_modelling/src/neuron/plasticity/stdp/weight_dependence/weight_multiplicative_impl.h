@@ -17,14 +17,35 @@ typedef struct {
 
     int32_t a2_plus;
     int32_t a2_minus;
+
+    uint32_t weight_multiply_right_shift;
 } plasticity_weight_region_data_t;
 
+#ifdef WEIGHT_UPDATES_DEFERRED
+// The potentiation and depression of all the events of an update are
+// accumulated and applied together at the end, each scaled by the distance of
+// the initial weight from its bound, rather than each event being scaled by
+// the weight left by the events before it.  This is exact for a single event,
+// and otherwise differs by terms in the product of the learning rates, but as
+// for the additive rule the updates can then be accumulated apart from the
+// weight.
+typedef struct {
+    int32_t initial_weight;
+
+    int32_t a2_plus;
+    int32_t a2_minus;
+
+    const plasticity_weight_region_data_t *weight_region;
+} weight_state_t;
+
+#define WEIGHT_UPDATES_COMMUTE
+#else
 typedef struct {
     int32_t weight;
 
-    uint32_t weight_multiply_right_shift;
     const plasticity_weight_region_data_t *weight_region;
 } weight_state_t;
+#endif  // WEIGHT_UPDATES_DEFERRED
 
 #include "weight_one_term.h"
 
@@ -33,8 +54,71 @@ typedef struct {
 //---------------------------------------
 extern plasticity_weight_region_data_t
     plasticity_weight_region_data[SYNAPSE_TYPE_COUNT];
-extern uint32_t weight_multiply_right_shift[SYNAPSE_TYPE_COUNT];
 
+#ifdef WEIGHT_UPDATES_DEFERRED
+//---------------------------------------
+// Weight dependance functions
+//---------------------------------------
+static inline weight_state_t weight_get_initial(weight_t weight,
+        index_t synapse_type) {
+    return (weight_state_t ) {
+        .initial_weight = (int32_t) weight,
+        .a2_plus = 0,
+        .a2_minus = 0,
+        .weight_region = &plasticity_weight_region_data[synapse_type]
+    };
+}
+
+//---------------------------------------
+static inline weight_state_t weight_one_term_apply_depression(
+        weight_state_t state, int32_t depression) {
+    state.a2_minus += depression;
+    return state;
+}
+
+//---------------------------------------
+static inline weight_state_t weight_one_term_apply_potentiation(
+        weight_state_t state, int32_t potentiation) {
+    state.a2_plus += potentiation;
+    return state;
+}
+
+//---------------------------------------
+static inline weight_state_t weight_add_updates(
+        weight_state_t state, weight_state_t updates) {
+    state.a2_plus += updates.a2_plus;
+    state.a2_minus += updates.a2_minus;
+    return state;
+}
+
+//---------------------------------------
+static inline weight_t weight_get_final(weight_state_t new_state) {
+    const plasticity_weight_region_data_t *region = new_state.weight_region;
+
+    // Scale the potentiation and depression by the distance of the initial
+    // weight from each bound, as each event would be if it were alone
+    int32_t scale_plus = maths_fixed_mul16(
+        region->max_weight - new_state.initial_weight, region->a2_plus,
+        region->weight_multiply_right_shift);
+    int32_t scale_minus = maths_fixed_mul16(
+        new_state.initial_weight - region->min_weight, region->a2_minus,
+        region->weight_multiply_right_shift);
+    // The sums of the updates can be larger than 16 bits, so all 32 bits are
+    // multiplied by the 16-bit scales
+    int32_t new_weight = new_state.initial_weight
+        + STDP_FIXED_MUL_32X16(new_state.a2_plus, scale_plus)
+        - STDP_FIXED_MUL_32X16(new_state.a2_minus, scale_minus);
+
+    // Clamp new weight, as the accumulated updates can overshoot a bound
+    new_weight = MIN(region->max_weight, MAX(new_weight, region->min_weight));
+
+    log_debug("\told_weight:%d, a2+:%d, a2-:%d, new_weight:%d",
+              new_state.initial_weight, new_state.a2_plus, new_state.a2_minus,
+              new_weight);
+
+    return (weight_t) new_weight;
+}
+#else
 //---------------------------------------
 // Weight dependance functions
 //---------------------------------------
@@ -42,8 +126,6 @@ static inline weight_state_t weight_get_initial(weight_t weight,
         index_t synapse_type) {
     return (weight_state_t ) {
         .weight = (int32_t) weight,
-        .weight_multiply_right_shift =
-            weight_multiply_right_shift[synapse_type],
         .weight_region = &plasticity_weight_region_data[synapse_type]
     };
 }
@@ -57,7 +139,8 @@ static inline weight_state_t weight_one_term_apply_depression(
     // fixed-point format
     int32_t scale = maths_fixed_mul16(
         state.weight - state.weight_region->min_weight,
-        state.weight_region->a2_minus, state.weight_multiply_right_shift);
+        state.weight_region->a2_minus,
+        state.weight_region->weight_multiply_right_shift);
 
     // Multiply scale by depression and subtract
     // **NOTE** using standard STDP fixed-point format handles format conversion
@@ -72,7 +155,8 @@ static inline weight_state_t weight_one_term_apply_potentiation(
     // fixed-point format
     int32_t scale = maths_fixed_mul16(
         state.weight_region->max_weight - state.weight,
-        state.weight_region->a2_plus, state.weight_multiply_right_shift);
+        state.weight_region->a2_plus,
+        state.weight_region->weight_multiply_right_shift);
 
     // Multiply scale by potentiation and add
     // **NOTE** using standard STDP fixed-point format handles format conversion
@@ -85,5 +169,6 @@ static inline weight_t weight_get_final(weight_state_t new_state) {
 
     return (weight_t) new_state.weight;
 }
+#endif  // WEIGHT_UPDATES_DEFERRED
 
 #endif  // _WEIGHT_MULTIPLICATIVE_IMPL_H_
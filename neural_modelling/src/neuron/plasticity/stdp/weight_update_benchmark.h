@@ -0,0 +1,84 @@
+/*! \file
+ *
+ *  \brief times the synapse updates of the timing rule and weight dependence
+ *         of a build, on a fixed pattern of events
+ *
+ *  \details Each synapse is updated with a number of post-synaptic events
+ *  followed by a pre-synaptic event, as the synapse update loops do.  When the
+ *  updates of the weight dependence commute, the updates are also timed as
+ *  the two passes of the MAD implementation make them: the post-synaptic
+ *  events are applied once, and their updates added to each synapse.
+ */
+
+#ifndef _WEIGHT_UPDATE_BENCHMARK_H_
+#define _WEIGHT_UPDATE_BENCHMARK_H_
+
+#include "../../../common/free_running_timer.h"
+#include <string.h>
+#include <debug.h>
+
+//! The number of synapses updated by the benchmark
+#define WEIGHT_UPDATE_BENCHMARK_N_SYNAPSES 256
+
+//! The number of post-synaptic events applied to each synapse
+#define WEIGHT_UPDATE_BENCHMARK_N_EVENTS 4
+
+//! \brief applies the post-synaptic events of the benchmark to a state
+static inline update_state_t _weight_update_benchmark_post(
+        pre_trace_t pre_trace, post_trace_t post_trace,
+        update_state_t state) {
+    for (uint32_t e = 0; e < WEIGHT_UPDATE_BENCHMARK_N_EVENTS; e++) {
+        state = timing_apply_post_spike(
+            12 + (e * 8), post_trace, 10, pre_trace, 4 + (e * 8), post_trace,
+            state);
+    }
+    return state;
+}
+
+//! \brief logs the cycles taken by the synapse updates of the benchmark
+static inline void weight_update_benchmark(void) {
+    volatile weight_t sink = 0;
+
+    // The traces of a first spike, which are all that the rules need
+    pre_trace_t pre_trace;
+    post_trace_t post_trace;
+    memset(&pre_trace, 0, sizeof(pre_trace));
+    post_trace = timing_add_post_spike(4, 0, timing_get_initial_post_trace());
+    pre_trace = timing_add_pre_spike(10, 0, pre_trace);
+
+    uint32_t start = free_running_timer_now();
+    for (uint32_t s = 0; s < WEIGHT_UPDATE_BENCHMARK_N_SYNAPSES; s++) {
+        update_state_t state = synapse_structure_get_update_state(
+            (plastic_synapse_t) (s << 4), 0);
+        state = _weight_update_benchmark_post(pre_trace, post_trace, state);
+        state = timing_apply_pre_spike(
+            50, pre_trace, 10, pre_trace, 36, post_trace, state);
+        sink += synapse_structure_get_final_weight(
+            synapse_structure_get_final_state(state));
+    }
+    uint32_t per_event_cycles = free_running_timer_elapsed(start);
+    log_info(
+        "\t%u synapse updates of %u post-synaptic events: %u cycles",
+        WEIGHT_UPDATE_BENCHMARK_N_SYNAPSES, WEIGHT_UPDATE_BENCHMARK_N_EVENTS,
+        per_event_cycles);
+
+#ifdef SYNAPSE_UPDATES_COMMUTE
+    start = free_running_timer_now();
+    update_state_t updates = _weight_update_benchmark_post(
+        pre_trace, post_trace, synapse_structure_get_update_state(0, 0));
+    for (uint32_t s = 0; s < WEIGHT_UPDATE_BENCHMARK_N_SYNAPSES; s++) {
+        update_state_t state = synapse_structure_get_update_state(
+            (plastic_synapse_t) (s << 4), 0);
+        state = synapse_structure_add_updates(state, updates);
+        state = timing_apply_pre_spike(
+            50, pre_trace, 10, pre_trace, 36, post_trace, state);
+        sink += synapse_structure_get_final_weight(
+            synapse_structure_get_final_state(state));
+    }
+    uint32_t deferred_cycles = free_running_timer_elapsed(start);
+    log_info("\tThe same with the updates found once: %u cycles",
+             deferred_cycles);
+#endif  // SYNAPSE_UPDATES_COMMUTE
+}
+
+#endif  // _WEIGHT_UPDATE_BENCHMARK_H_
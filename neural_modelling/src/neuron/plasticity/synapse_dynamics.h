@@ -4,13 +4,76 @@
 #include "../../common/neuron-typedefs.h"
 #include "../synapse_row.h"
 
+//! The words of the plastic region of a row changed by processing it, which
+//! are all that need to be written back to SDRAM: the first n_header_words
+//! words, such as the pre-synaptic event history, and the words from
+//! first_word up to but not including end_word, such as the synapses whose
+//! state changed
+typedef struct plastic_write_back_t {
+    uint32_t n_header_words;
+    uint32_t first_word;
+    uint32_t end_word;
+} plastic_write_back_t;
+
+//! \brief marks none of the plastic region as changed
+//! \param[out] write_back The changes to reset
+static inline void synapse_dynamics_write_back_none(
+        plastic_write_back_t *write_back) {
+    write_back->n_header_words = 0;
+    write_back->first_word = UINT32_MAX;
+    write_back->end_word = 0;
+}
+
+//! \brief marks the header and a span of words of the plastic region as
+//!        changed, in addition to those already marked
+//! \param[in,out] write_back The changes to add to
+//! \param[in] n_header_words The number of words of the header that changed
+//! \param[in] first_word The first word of the span
+//! \param[in] end_word The word after the span, or first_word for no span
+static inline void synapse_dynamics_write_back_add(
+        plastic_write_back_t *write_back, uint32_t n_header_words,
+        uint32_t first_word, uint32_t end_word) {
+    if (n_header_words > write_back->n_header_words) {
+        write_back->n_header_words = n_header_words;
+    }
+    if (end_word > first_word) {
+        if (first_word < write_back->first_word) {
+            write_back->first_word = first_word;
+        }
+        if (end_word > write_back->end_word) {
+            write_back->end_word = end_word;
+        }
+    }
+}
+
+//! \brief marks the header and the words holding a span of bytes of the
+//!        plastic region as changed, in addition to those already marked
+//! \param[in,out] write_back The changes to add to
+//! \param[in] n_header_words The number of words of the header that changed
+//! \param[in] first_byte The first byte of the span
+//! \param[in] end_byte The byte after the span, or first_byte for no span
+static inline void synapse_dynamics_write_back_add_bytes(
+        plastic_write_back_t *write_back, uint32_t n_header_words,
+        uint32_t first_byte, uint32_t end_byte) {
+    synapse_dynamics_write_back_add(
+        write_back, n_header_words, first_byte >> 2, (end_byte + 3) >> 2);
+}
+
 bool synapse_dynamics_initialise(
     address_t address, uint32_t n_neurons,
     uint32_t *ring_buffer_to_input_buffer_left_shifts);
 
+//! \brief processes the plastic synapses of a row for a spike
+//! \param[in] plastic_region_address The plastic region of the row
+//! \param[in] fixed_region_address The fixed region of the row
+//! \param[in] ring_buffers The ring buffers to add the input to
+//! \param[in] time The time of the spike
+//! \param[in,out] write_back The words of the plastic region changed, to
+//!                           which those changed by this spike are added
+//! \return True if the synapses were processed successfully
 bool synapse_dynamics_process_plastic_synapses(
     address_t plastic_region_address, address_t fixed_region_address,
-    weight_t *ring_buffers, uint32_t time);
+    weight_t *ring_buffers, uint32_t time, plastic_write_back_t *write_back);
 
 void synapse_dynamics_process_post_synaptic_event(
     uint32_t time, index_t neuron_index);
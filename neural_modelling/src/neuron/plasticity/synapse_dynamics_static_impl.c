@@ -19,11 +19,13 @@ void synapse_dynamics_process_post_synaptic_event(
 
 //---------------------------------------
 bool synapse_dynamics_process_plastic_synapses(address_t plastic_region_address,
-        address_t fixed_region_address, weight_t *ring_buffer, uint32_t time) {
+        address_t fixed_region_address, weight_t *ring_buffer, uint32_t time,
+        plastic_write_back_t *write_back) {
     use(plastic_region_address);
     use(fixed_region_address);
     use(ring_buffer);
     use(time);
+    use(write_back);
 
     log_error("There should be no plastic synapses!");
     return false;
@@ -0,0 +1,79 @@
+/*! \file
+ *
+ * \brief implementation of the row_cache.h interface.
+ *
+ */
+
+#include "row_cache.h"
+#include <spin1_api.h>
+#include <debug.h>
+
+//! A block of rows copied to DTCM
+typedef struct cached_block_t {
+    uint32_t sdram_start;
+    uint32_t sdram_end;
+    address_t dtcm_copy;
+} cached_block_t;
+
+static cached_block_t *cached_blocks;
+
+static uint32_t n_cached_blocks = 0;
+
+static uint32_t n_hits = 0;
+
+bool row_cache_initialise(address_t synaptic_matrix_address) {
+
+    // The region holds the size of the indirect matrix and the matrix, then
+    // the size of the direct matrix and the matrix, then the cached blocks
+    address_t indirect_synapses_address = &(synaptic_matrix_address[1]);
+    uint32_t direct_matrix_offset = (synaptic_matrix_address[0] >> 2) + 1;
+    uint32_t cache_table_offset = direct_matrix_offset + 1 +
+        (synaptic_matrix_address[direct_matrix_offset] >> 2);
+    address_t cache_table = &(synaptic_matrix_address[cache_table_offset]);
+
+    n_cached_blocks = cache_table[0];
+    if (n_cached_blocks == 0) {
+        return true;
+    }
+    cached_blocks = (cached_block_t *) spin1_malloc(
+        n_cached_blocks * sizeof(cached_block_t));
+    if (cached_blocks == NULL) {
+        log_error("Not enough memory to allocate the row cache");
+        return false;
+    }
+
+    for (uint32_t i = 0; i < n_cached_blocks; i++) {
+        uint32_t offset = cache_table[1 + (2 * i)];
+        uint32_t n_bytes = cache_table[2 + (2 * i)];
+        address_t block_address = (address_t)
+            ((uint32_t) indirect_synapses_address + offset);
+        cached_blocks[i].dtcm_copy = (address_t) spin1_malloc(n_bytes);
+        if (cached_blocks[i].dtcm_copy == NULL) {
+            log_error("Not enough memory to cache %u bytes of rows", n_bytes);
+            return false;
+        }
+        spin1_memcpy(cached_blocks[i].dtcm_copy, block_address, n_bytes);
+        cached_blocks[i].sdram_start = (uint32_t) block_address;
+        cached_blocks[i].sdram_end = (uint32_t) block_address + n_bytes;
+        log_info(
+            "Cached %u bytes of rows from 0x%08x", n_bytes, block_address);
+    }
+    return true;
+}
+
+address_t row_cache_get_row(address_t row_address) {
+    uint32_t address = (uint32_t) row_address;
+    for (uint32_t i = 0; i < n_cached_blocks; i++) {
+        if (address >= cached_blocks[i].sdram_start &&
+                address < cached_blocks[i].sdram_end) {
+            n_hits += 1;
+            return (address_t) ((uint32_t) cached_blocks[i].dtcm_copy +
+                (address - cached_blocks[i].sdram_start));
+        }
+    }
+    return NULL;
+}
+
+uint32_t row_cache_get_n_hits() {
+    return n_hits;
+}
@@ -0,0 +1,43 @@
+/*! \file
+ *
+ *  \brief DTCM copies of blocks of synaptic rows chosen by the host
+ *
+ *  \details The host chooses blocks of static synaptic rows from sources
+ *  that are expected to spike often, and lists them after the direct matrix
+ *  in the synaptic matrix region as a count followed by an (offset, size in
+ *  bytes) pair per block, where the offset is from the start of the indirect
+ *  synaptic matrix.  Each block is copied to DTCM on initialisation, so that
+ *  the rows can be processed straight away rather than read with a DMA.
+ *  Only static rows are cached, as these are never written back.
+ *
+ *  The API contains:
+ *    - row_cache_initialise(synaptic_matrix_address):
+ *         copies the blocks listed after the direct matrix to DTCM
+ *    - row_cache_get_row(row_address):
+ *         gets the DTCM copy of a row, or NULL if it is not cached
+ *    - row_cache_get_n_hits():
+ *         gets the number of rows found in the cache
+ */
+
+#ifndef _ROW_CACHE_H_
+#define _ROW_CACHE_H_
+
+#include "../common/neuron-typedefs.h"
+
+//! \brief copies the blocks of rows listed by the host to DTCM
+//! \param[in] synaptic_matrix_address The address of the synaptic matrix
+//!                                    region
+//! \return True if the blocks could be copied, False if there was not enough
+//!         DTCM
+bool row_cache_initialise(address_t synaptic_matrix_address);
+
+//! \brief gets the DTCM copy of a synaptic row
+//! \param[in] row_address The SDRAM address of the row
+//! \return The address of the copy of the row, or NULL if not cached
+address_t row_cache_get_row(address_t row_address);
+
+//! \brief gets the number of rows found in the cache
+//! \return The number of calls to row_cache_get_row that found a row
+uint32_t row_cache_get_n_hits();
+
+#endif // _ROW_CACHE_H_
@@ -0,0 +1,155 @@
+/*! \file
+ *
+ * \brief implementation of the spike_latency.h interface.
+ *
+ */
+
+#include "spike_latency.h"
+#include "../common/free_running_timer.h"
+#include <debug.h>
+
+#ifdef SPIKE_LATENCY
+
+//! The maximum number of DMA buffers that can be timed
+#define MAX_DMA_BUFFERS 4
+
+//! The times of the spike whose row is in a DMA buffer
+typedef struct buffer_times_t {
+    uint32_t received;
+    uint32_t issued;
+    uint32_t completed;
+} buffer_times_t;
+
+//! Statistics kept for each stage
+typedef struct stage_stats_t {
+    uint32_t max_cycles;
+    log2_histogram_t histogram;
+} stage_stats_t;
+
+static stage_stats_t stage_stats[SPIKE_LATENCY_N_STAGES];
+
+static buffer_times_t buffer_times[MAX_DMA_BUFFERS];
+
+//! The receive times of the spikes in the input buffer, in the same order
+static uint32_t *receive_times;
+
+//! Mask to wrap indices into receive_times
+static uint32_t receive_times_mask;
+
+static uint32_t receive_times_input;
+static uint32_t receive_times_output;
+
+//! The receive time of the spike last taken from the input buffer
+static uint32_t dequeued_receive_time;
+
+//! The number of spikes timed
+static uint32_t n_spikes_timed = 0;
+
+static inline void _add_sample(spike_latency_stages stage, uint32_t cycles) {
+    stage_stats_t *stats = &stage_stats[stage];
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+    log2_histogram_add(
+        &stats->histogram, cycles >> SPIKE_LATENCY_HISTOGRAM_SHIFT);
+}
+
+static inline uint32_t _pop_receive_time() {
+    uint32_t receive_time = receive_times[receive_times_output];
+    receive_times_output = (receive_times_output + 1) & receive_times_mask;
+    n_spikes_timed += 1;
+    return receive_time;
+}
+
+bool spike_latency_initialise(uint32_t incoming_spike_buffer_size) {
+
+    // Use a power of two at least twice the input buffer size, so that the
+    // receive times can never overflow while the input buffer has space
+    uint32_t size = 1;
+    while (size < (incoming_spike_buffer_size << 1)) {
+        size <<= 1;
+    }
+    receive_times = (uint32_t *) spin1_malloc(size * sizeof(uint32_t));
+    if (receive_times == NULL) {
+        log_error("Could not allocate spike receive time buffer");
+        return false;
+    }
+    receive_times_mask = size - 1;
+    receive_times_input = 0;
+    receive_times_output = 0;
+
+    for (uint32_t i = 0; i < SPIKE_LATENCY_N_STAGES; i++) {
+        stage_stats[i].max_cycles = 0;
+        log2_histogram_clear(&stage_stats[i].histogram);
+    }
+    free_running_timer_start();
+    log_info("Spike latency measurement enabled");
+    return true;
+}
+
+void spike_latency_received() {
+    receive_times[receive_times_input] = free_running_timer_now();
+    receive_times_input = (receive_times_input + 1) & receive_times_mask;
+}
+
+void spike_latency_dequeued() {
+    dequeued_receive_time = _pop_receive_time();
+    _add_sample(
+        SPIKE_LATENCY_QUEUED,
+        free_running_timer_elapsed(dequeued_receive_time));
+}
+
+void spike_latency_dma_issued(uint32_t buffer_index) {
+    buffer_times_t *times = &buffer_times[buffer_index];
+    times->received = dequeued_receive_time;
+    times->issued = free_running_timer_now();
+}
+
+void spike_latency_dma_complete(uint32_t buffer_index) {
+    buffer_times_t *times = &buffer_times[buffer_index];
+    times->completed = free_running_timer_now();
+    _add_sample(SPIKE_LATENCY_DMA, times->issued - times->completed);
+}
+
+void spike_latency_merged() {
+    _add_sample(
+        SPIKE_LATENCY_QUEUED,
+        free_running_timer_elapsed(_pop_receive_time()));
+}
+
+void spike_latency_row_done(uint32_t buffer_index) {
+    buffer_times_t *times = &buffer_times[buffer_index];
+    uint32_t now = free_running_timer_now();
+    _add_sample(SPIKE_LATENCY_PROCESSING, times->completed - now);
+    _add_sample(SPIKE_LATENCY_TOTAL, times->received - now);
+}
+
+void spike_latency_direct_row_done() {
+    _add_sample(
+        SPIKE_LATENCY_TOTAL,
+        free_running_timer_elapsed(dequeued_receive_time));
+}
+
+address_t spike_latency_store_provenance(address_t provenance_region) {
+    provenance_region[0] = n_spikes_timed;
+    provenance_region[1] = sv->cpu_clk;
+    address_t next = &(provenance_region[SPIKE_LATENCY_N_HEADER_WORDS]);
+    for (uint32_t i = 0; i < SPIKE_LATENCY_N_STAGES; i++) {
+        next[0] = stage_stats[i].max_cycles;
+        next = log2_histogram_write(&stage_stats[i].histogram, &(next[1]));
+    }
+    return next;
+}
+
+#else
+
+address_t spike_latency_store_provenance(address_t provenance_region) {
+
+    // Write zeros so the host can tell that no latencies were measured
+    for (uint32_t i = 0; i < SPIKE_LATENCY_N_PROVENANCE_WORDS; i++) {
+        provenance_region[i] = 0;
+    }
+    return &(provenance_region[SPIKE_LATENCY_N_PROVENANCE_WORDS]);
+}
+
+#endif // SPIKE_LATENCY
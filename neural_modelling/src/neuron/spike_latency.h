@@ -0,0 +1,146 @@
+/*! \file
+ *
+ *  \brief optional measurement of the latency of spike processing
+ *
+ *  \details When compiled with SPIKE_LATENCY defined, each spike is time
+ *  stamped when it is received, when it is taken from the input buffer, when
+ *  the DMA of its synaptic row is issued and completes, and when the row has
+ *  been processed.  Log2 histograms of the time spent in each stage are kept:
+ *    - queued: from receipt to being taken from the input buffer
+ *    - DMA: from issuing the row read to it completing
+ *    - processing: from the DMA completing to the row being processed
+ *    - total: from receipt to the row being processed
+ *  Spikes with the same key as the spike being processed that are next in
+ *  the input buffer are merged into it; they only have a queued stage.  Direct rows and rows in the row cache have no DMA or processing
+ *  stages.
+ *
+ *  Without SPIKE_LATENCY, all the functions except
+ *  spike_latency_store_provenance compile to nothing, and that writes zeros,
+ *  so that the provenance data layout does not depend on the build.
+ *
+ *  The API contains:
+ *    - spike_latency_initialise(incoming_spike_buffer_size):
+ *         allocates the receive time buffer, which mirrors the input buffer
+ *    - spike_latency_received():
+ *         called when a spike has been added to the input buffer
+ *    - spike_latency_dequeued():
+ *         called when a spike has been taken from the input buffer
+ *    - spike_latency_dma_issued(buffer_index):
+ *         called when the row of the last spike taken is being read
+ *    - spike_latency_dma_complete(buffer_index):
+ *         called when the read of a row has completed
+ *    - spike_latency_merged():
+ *         called when a spike has been taken from the input buffer to be
+ *         merged with the spike being processed
+ *    - spike_latency_row_done(buffer_index):
+ *         called when a row that was read has been processed
+ *    - spike_latency_direct_row_done():
+ *         called when a direct row of the last spike taken has been processed
+ *    - spike_latency_store_provenance(provenance_region):
+ *         writes the histograms to the provenance data region
+ */
+
+#ifndef _SPIKE_LATENCY_H_
+#define _SPIKE_LATENCY_H_
+
+#include "../common/neuron-typedefs.h"
+#include "../common/log2_histogram.h"
+
+//! The stages of spike processing that are measured
+typedef enum spike_latency_stages {
+    SPIKE_LATENCY_QUEUED,
+    SPIKE_LATENCY_DMA,
+    SPIKE_LATENCY_PROCESSING,
+    SPIKE_LATENCY_TOTAL,
+    SPIKE_LATENCY_N_STAGES
+} spike_latency_stages;
+
+//! The histograms count cycles in units of 2^SPIKE_LATENCY_HISTOGRAM_SHIFT
+#define SPIKE_LATENCY_HISTOGRAM_SHIFT 6
+
+//! The number of header words in the provenance data: the number of spikes
+//! timed and the CPU clock in MHz
+#define SPIKE_LATENCY_N_HEADER_WORDS 2
+
+//! The number of provenance words per stage: the maximum number of cycles,
+//! followed by the histogram
+#define SPIKE_LATENCY_N_STAGE_WORDS (1 + LOG2_HISTOGRAM_N_BINS)
+
+//! The number of words written by spike_latency_store_provenance
+#define SPIKE_LATENCY_N_PROVENANCE_WORDS \
+    (SPIKE_LATENCY_N_HEADER_WORDS + \
+     (SPIKE_LATENCY_N_STAGES * SPIKE_LATENCY_N_STAGE_WORDS))
+
+#ifdef SPIKE_LATENCY
+
+//! \brief allocates the buffer of receive times and starts the timer
+//! \param[in] incoming_spike_buffer_size The size of the input spike buffer
+//! \return True if the buffer could be allocated
+bool spike_latency_initialise(uint32_t incoming_spike_buffer_size);
+
+//! \brief records the receive time of a spike added to the input buffer
+void spike_latency_received();
+
+//! \brief records that a spike has been taken from the input buffer
+void spike_latency_dequeued();
+
+//! \brief records that the row of the last spike taken is being read
+//! \param[in] buffer_index The index of the DMA buffer being read into
+void spike_latency_dma_issued(uint32_t buffer_index);
+
+//! \brief records that the read of a row has completed
+//! \param[in] buffer_index The index of the DMA buffer read into
+void spike_latency_dma_complete(uint32_t buffer_index);
+
+//! \brief records that a spike has been taken from the input buffer to be
+//!        merged with the spike being processed
+void spike_latency_merged();
+
+//! \brief records that a row in a DMA buffer has been processed
+//! \param[in] buffer_index The index of the DMA buffer holding the row
+void spike_latency_row_done(uint32_t buffer_index);
+
+//! \brief records that a direct row of the last spike taken was processed
+void spike_latency_direct_row_done();
+
+#else
+
+static inline bool spike_latency_initialise(
+        uint32_t incoming_spike_buffer_size) {
+    use(incoming_spike_buffer_size);
+    return true;
+}
+
+static inline void spike_latency_received() {
+}
+
+static inline void spike_latency_dequeued() {
+}
+
+static inline void spike_latency_dma_issued(uint32_t buffer_index) {
+    use(buffer_index);
+}
+
+static inline void spike_latency_dma_complete(uint32_t buffer_index) {
+    use(buffer_index);
+}
+
+static inline void spike_latency_merged() {
+}
+
+static inline void spike_latency_row_done(uint32_t buffer_index) {
+    use(buffer_index);
+}
+
+static inline void spike_latency_direct_row_done() {
+}
+
+#endif // SPIKE_LATENCY
+
+//! \brief writes the histograms to the provenance data region
+//! \param[in] provenance_region The address to write the
+//!            SPIKE_LATENCY_N_PROVENANCE_WORDS words to
+//! \return The address following the written words
+address_t spike_latency_store_provenance(address_t provenance_region);
+
+#endif // _SPIKE_LATENCY_H_
@@ -2,7 +2,13 @@
 #include "population_table/population_table.h"
 #include "synapse_row.h"
 #include "synapses.h"
+#include "tick_profile.h"
+#include "spike_latency.h"
+#include "row_cache.h"
+#include "input_buffer_policy.h"
+#include "weight_recording.h"
 #include "../common/in_spikes.h"
+#include "../common/free_running_timer.h"
 #include <spin1_api.h>
 #include <debug.h>
 
@@ -20,9 +26,14 @@ typedef struct dma_buffer {
     address_t sdram_writeback_address;
 
     // Key of originating spike
-    // (used to allow row data to be re-used for multiple spikes)
     spike_t originating_spike;
 
+    // The number of spikes merged into the originating spike
+    uint32_t multiplicity;
+
+    // The tick in which the originating spike arrived
+    uint32_t arrival_tick;
+
     uint32_t n_bytes_transferred;
 
     // Row data
@@ -30,8 +41,6 @@ typedef struct dma_buffer {
 
 } dma_buffer;
 
-extern uint32_t time;
-
 // True if the DMA "loop" is currently running
 static bool dma_busy;
 
@@ -48,8 +57,51 @@ static uint32_t max_n_words;
 
 static spike_t spike;
 
+// The number of spikes with the key of spike that arrived together
+static uint32_t spike_multiplicity;
+
+// The tick in which spike arrived, which its rows are processed for
+static uint32_t spike_arrival_tick;
+
+// The number of tick boundaries remembered; spikes that arrived before the
+// oldest are treated as arriving in the oldest tick
+#define N_TICK_BOUNDARIES 4
+#define TICK_BOUNDARY_MASK (N_TICK_BOUNDARIES - 1)
+
+// The number of spikes that had been added to the input buffer at the start
+// of each of the last N_TICK_BOUNDARIES ticks, indexed by tick
+static uint32_t tick_boundaries[N_TICK_BOUNDARIES];
+
+// The tick that spikes added to the input buffer now arrive in
+static uint32_t current_tick = UINT32_MAX;
+
+// The longest time in CPU cycles to wait at the start of a tick for the
+// spikes of earlier ticks to be processed, or 0 not to wait
+static uint32_t drain_guard_cycles = 0;
+
 static uint32_t single_fixed_synapse[4];
 
+// The word of a direct row that has no synapse: the bit above the delay,
+// type and index, which no synapse sets; every other word can be a synapse,
+// and if this is a bit of the weight, the host writes no direct rows
+#define DIRECT_ROW_EMPTY (1 << (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_INDEX_BITS))
+
+// The number of rows read from the direct matrix and by DMA
+static uint32_t n_direct_rows = 0;
+static uint32_t n_row_dmas = 0;
+
+// The number of spikes merged into an earlier spike with the same key
+static uint32_t n_merged_spikes = 0;
+
+// The number of spikes taken from the input buffer after the tick they
+// arrived in had ended
+static uint32_t n_late_spikes = 0;
+
+// The number of bytes of plastic regions written back, and not written back
+// as they had not changed
+static uint32_t n_plastic_bytes_written = 0;
+static uint32_t n_plastic_bytes_skipped = 0;
+
 /* PRIVATE FUNCTIONS - static for inlining */
 
 static inline void _do_dma_read(
@@ -60,11 +112,15 @@ static inline void _do_dma_read(
     dma_buffer *next_buffer = &dma_buffers[next_buffer_to_fill];
     next_buffer->sdram_writeback_address = row_address;
     next_buffer->originating_spike = spike;
+    next_buffer->multiplicity = spike_multiplicity;
+    next_buffer->arrival_tick = spike_arrival_tick;
     next_buffer->n_bytes_transferred = n_bytes_to_transfer;
 
     // Start a DMA transfer to fetch this synaptic row into current
     // buffer
     buffer_being_read = next_buffer_to_fill;
+    n_row_dmas++;
+    spike_latency_dma_issued(buffer_being_read);
     spin1_dma_transfer(
         DMA_TAG_READ_SYNAPTIC_ROW, row_address, next_buffer->row, DMA_READ,
         n_bytes_to_transfer);
@@ -73,8 +129,71 @@ static inline void _do_dma_read(
 
 
 static inline void _do_direct_row(address_t row_address) {
-    single_fixed_synapse[3] = (uint32_t) row_address[0];
-    synapses_process_synaptic_row(time, single_fixed_synapse, false, 0);
+    n_direct_rows++;
+    if (row_address[0] != DIRECT_ROW_EMPTY) {
+        single_fixed_synapse[3] = (uint32_t) row_address[0];
+        synapses_process_synaptic_row(
+            spike_arrival_tick, single_fixed_synapse, spike_multiplicity,
+            false, 0);
+    }
+    spike_latency_direct_row_done();
+}
+
+//! \brief processes a row from the row cache if it is there
+//! \return True if the row was cached and has been processed
+static inline bool _do_cached_row(address_t row_address) {
+    address_t cached_row = row_cache_get_row(row_address);
+    if (cached_row == NULL) {
+        return false;
+    }
+    synapses_process_synaptic_row(
+        spike_arrival_tick, cached_row, spike_multiplicity, false, 0);
+    spike_latency_direct_row_done();
+    return true;
+}
+
+//! \brief takes any spikes with the given key from the front of the input
+//!        buffer that arrived in the same tick
+//! \param[in] key The key of the spike taken
+//! \param[in] arrival_tick The tick in which the spike taken arrived
+//! \return The number of spikes taken
+static inline uint32_t _merge_equal_spikes(
+        spike_t key, uint32_t arrival_tick) {
+    uint32_t n_merged = 0;
+    while (true) {
+
+        // A spike after the boundary of the next tick arrived in a later
+        // tick, so its rows must be processed for that tick; the current
+        // tick is read again each time, as a tick can start while merging
+        if (arrival_tick != current_tick && (int32_t) (
+                in_spikes_get_n_taken() -
+                tick_boundaries[(arrival_tick + 1) & TICK_BOUNDARY_MASK])
+                >= 0) {
+            break;
+        }
+        if (!in_spikes_is_next_spike_equal(key)) {
+            break;
+        }
+        spike_latency_merged();
+        n_merged++;
+    }
+    n_merged_spikes += n_merged;
+    return n_merged;
+}
+
+//! \brief finds the tick in which a spike was added to the input buffer
+//! \param[in] spike_index The number of spikes added before the spike
+//! \return The tick of the last boundary at or before the spike
+static inline uint32_t _get_arrival_tick(uint32_t spike_index) {
+    uint32_t tick = current_tick;
+    for (uint32_t i = 1; i < N_TICK_BOUNDARIES; i++) {
+        if ((int32_t) (spike_index -
+                tick_boundaries[tick & TICK_BOUNDARY_MASK]) >= 0) {
+            break;
+        }
+        tick--;
+    }
+    return tick;
 }
 
 static inline void _setup_synaptic_dma_read() {
@@ -95,16 +214,37 @@ static inline void _setup_synaptic_dma_read() {
             // This is a direct row to process
             if (n_bytes_to_transfer == 0) {
                 _do_direct_row(row_address);
-            } else {
+            } else if (!_do_cached_row(row_address)) {
                 _do_dma_read(row_address, n_bytes_to_transfer);
                 setup_done = true;
             }
         }
 
-        // If there's more incoming spikes
-        cpsr = spin1_int_disable();
+        // If there's more incoming spikes; the input buffer is only added to
+        // by the packet received callback, so it can be read without
+        // disabling interrupts
         while (!setup_done && in_spikes_get_next_spike(&spike)) {
-            spin1_mode_restore(cpsr);
+            spike_latency_dequeued();
+
+            // Drop the spike if the buffer is too full for the policy
+            if (input_buffer_policy_should_drop(
+                    spike, in_spikes_get_n_spikes())) {
+                continue;
+            }
+
+            // Process the rows for the tick the spike arrived in, even if
+            // that has ended, so that the delays stay correct
+            spike_arrival_tick = _get_arrival_tick(
+                in_spikes_get_n_taken() - 1);
+            if (spike_arrival_tick != current_tick) {
+                n_late_spikes++;
+            }
+
+            // Merge the copies of the spike that follow it in the same
+            // tick, so that its rows are read and processed once for all of
+            // them
+            spike_multiplicity = 1 + _merge_equal_spikes(
+                spike, spike_arrival_tick);
             log_debug("Checking for row for spike 0x%.8x\n", spike);
 
             // Decode spike to get address of destination synaptic row
@@ -114,47 +254,74 @@ static inline void _setup_synaptic_dma_read() {
                 // This is a direct row to process
                 if (n_bytes_to_transfer == 0) {
                     _do_direct_row(row_address);
-                } else {
+                } else if (!_do_cached_row(row_address)) {
                     _do_dma_read(row_address, n_bytes_to_transfer);
                     setup_done = true;
                 }
             }
-            cpsr = spin1_int_disable();
         }
 
+        // If the setup was not done, and there are no more spikes, stop
+        // trying to set up synaptic DMAs; a spike received since the buffer
+        // was found empty would not trigger a new user event, so check again
+        // with interrupts disabled
         if (!setup_done) {
-            finished = true;
+            cpsr = spin1_int_disable();
+            if (in_spikes_is_empty()) {
+                log_debug("DMA not busy");
+                dma_busy = false;
+                finished = true;
+            }
+            spin1_mode_restore(cpsr);
         }
-        cpsr = spin1_int_disable();
     }
+}
 
-    // If the setup was not done, and there are no more spikes,
-    // stop trying to set up synaptic DMAs
-    if (!setup_done) {
-        log_debug("DMA not busy");
-        dma_busy = false;
-    }
-    spin1_mode_restore(cpsr);
+static inline void _do_plastic_region_write(
+        dma_buffer *buffer, uint32_t first_word, uint32_t n_words) {
+    log_debug("Writing back %u words of plastic region from word %u to %08x",
+              n_words, first_word, buffer->sdram_writeback_address + 1);
+    spin1_dma_transfer(
+        DMA_TAG_WRITE_PLASTIC_REGION,
+        buffer->sdram_writeback_address + 1 + first_word,
+        synapse_row_plastic_region(buffer->row) + first_word,
+        DMA_WRITE, n_words * sizeof(uint32_t));
+    n_plastic_bytes_written += n_words * sizeof(uint32_t);
 }
 
-static inline void _setup_synaptic_dma_write(uint32_t dma_buffer_index) {
+static inline void _setup_synaptic_dma_write(
+        uint32_t dma_buffer_index, const plastic_write_back_t *write_back) {
 
     // Get pointer to current buffer
     dma_buffer *buffer = &dma_buffers[dma_buffer_index];
 
-    // Get the number of plastic bytes and the write back address from the
-    // synaptic row
-    size_t n_plastic_region_bytes =
-        synapse_row_plastic_size(buffer->row) * sizeof(uint32_t);
-
-    log_debug("Writing back %u bytes of plastic region to %08x",
-              n_plastic_region_bytes, buffer->sdram_writeback_address + 1);
-
-    // Start transfer
-    spin1_dma_transfer(
-        DMA_TAG_WRITE_PLASTIC_REGION, buffer->sdram_writeback_address + 1,
-        synapse_row_plastic_region(buffer->row),
-        DMA_WRITE, n_plastic_region_bytes);
+    // Write back the header and the span of words that changed, as one
+    // transfer if they touch, or nothing if nothing changed
+    uint32_t n_region_words = synapse_row_plastic_size(buffer->row);
+    uint32_t n_header_words = write_back->n_header_words;
+    uint32_t first_word = write_back->first_word;
+    uint32_t end_word = write_back->end_word;
+    if (end_word > n_region_words) {
+        end_word = n_region_words;
+    }
+    uint32_t n_words_written = 0;
+    if (first_word >= end_word) {
+        if (n_header_words > 0) {
+            _do_plastic_region_write(buffer, 0, n_header_words);
+            n_words_written = n_header_words;
+        }
+    } else if (first_word <= n_header_words) {
+        _do_plastic_region_write(buffer, 0, end_word);
+        n_words_written = end_word;
+    } else {
+        if (n_header_words > 0) {
+            _do_plastic_region_write(buffer, 0, n_header_words);
+        }
+        _do_plastic_region_write(buffer, first_word, end_word - first_word);
+        n_words_written = n_header_words + (end_word - first_word);
+    }
+    n_plastic_bytes_skipped +=
+        (n_region_words - n_words_written) * sizeof(uint32_t);
 }
 
 
@@ -164,10 +331,12 @@ static inline void _setup_synaptic_dma_write(uint32_t dma_buffer_index) {
 void _multicast_packet_received_callback(uint key, uint payload) {
     use(payload);
 
-    log_debug("Received spike %x at %d, DMA Busy = %d", key, time, dma_busy);
+    log_debug(
+        "Received spike %x at %d, DMA Busy = %d", key, current_tick, dma_busy);
 
     // If there was space to add spike to incoming spike queue
     if (in_spikes_add_spike(key)) {
+        spike_latency_received();
 
         // If we're not already processing synaptic DMAs,
         // flag pipeline as busy and trigger a feed event
@@ -182,6 +351,7 @@ void _multicast_packet_received_callback(uint key, uint payload) {
         }
     } else {
         log_debug("Could not add spike");
+        input_buffer_policy_overflowed(key);
     }
 }
 
@@ -189,12 +359,15 @@ void _multicast_packet_received_callback(uint key, uint payload) {
 void _user_event_callback(uint unused0, uint unused1) {
     use(unused0);
     use(unused1);
+    tick_profile_start_spike_processing();
     _setup_synaptic_dma_read();
+    tick_profile_end_spike_processing();
 }
 
 // Called when a DMA completes
 void _dma_complete_callback(uint unused, uint tag) {
     use(unused);
+    tick_profile_start_spike_processing();
 
     log_debug("DMA transfer complete with tag %u", tag);
 
@@ -204,40 +377,40 @@ void _dma_complete_callback(uint unused, uint tag) {
         // Get pointer to current buffer
         uint32_t current_buffer_index = buffer_being_read;
         dma_buffer *current_buffer = &dma_buffers[current_buffer_index];
+        spike_latency_dma_complete(current_buffer_index);
 
         // Start the next DMA transfer, so it is complete when we are finished
         _setup_synaptic_dma_read();
 
-        // Process synaptic row repeatedly
-        bool subsequent_spikes;
-        do {
-
-            // Are there any more incoming spikes from the same pre-synaptic
-            // neuron?
-            subsequent_spikes = in_spikes_is_next_spike_equal(
-                current_buffer->originating_spike);
-
-            // Process synaptic row, writing it back if it's the last time
-            // it's going to be processed
-            if (!synapses_process_synaptic_row(time, current_buffer->row,
-                                          !subsequent_spikes,
-                                          current_buffer_index)) {
-                log_error(
-                    "Error processing spike 0x%.8x for address 0x%.8x"
-                    "(local=0x%.8x)",
-                    current_buffer->originating_spike,
-                    current_buffer->sdram_writeback_address,
-                    current_buffer->row);
-
-                // Print out the row for debugging
-                for (uint32_t i = 0;
-                        i < (current_buffer->n_bytes_transferred >> 2); i++) {
-                    log_error("%u: 0x%.8x", i, current_buffer->row[i]);
-                }
-
-                rt_error(RTE_SWERR);
+        // Process synaptic row once for all of the spikes merged when the
+        // spike was taken from the input buffer, and write it back.  Spikes
+        // that arrived later are not merged here, as the spike may have more
+        // rows still to be read, which would then miss them.  The weights
+        // are recorded at the time that the plastic synapses are updated
+        // for, which is later than the arrival of a late row.
+        weight_recording_start_row(
+            current_buffer->sdram_writeback_address,
+            synapses_get_plastic_time(current_buffer->arrival_tick));
+        if (!synapses_process_synaptic_row(
+                current_buffer->arrival_tick, current_buffer->row,
+                current_buffer->multiplicity, true, current_buffer_index)) {
+            log_error(
+                "Error processing spike 0x%.8x for address 0x%.8x"
+                "(local=0x%.8x)",
+                current_buffer->originating_spike,
+                current_buffer->sdram_writeback_address,
+                current_buffer->row);
+
+            // Print out the row for debugging
+            for (uint32_t i = 0;
+                    i < (current_buffer->n_bytes_transferred >> 2); i++) {
+                log_error("%u: 0x%.8x", i, current_buffer->row[i]);
             }
-        } while (subsequent_spikes);
+
+            rt_error(RTE_SWERR);
+        }
+        weight_recording_end_row();
+        spike_latency_row_done(current_buffer_index);
 
     } else if (tag == DMA_TAG_WRITE_PLASTIC_REGION) {
 
@@ -248,6 +421,7 @@ void _dma_complete_callback(uint unused, uint tag) {
         // Otherwise, if it ISN'T the result of a plastic region write
         log_error("Invalid tag %d received in DMA", tag);
     }
+    tick_profile_end_spike_processing();
 }
 
 
@@ -278,6 +452,9 @@ bool spike_processing_initialise(
     if (!in_spikes_initialize_spike_buffer(incoming_spike_buffer_size)) {
         return false;
     }
+    if (!spike_latency_initialise(incoming_spike_buffer_size)) {
+        return false;
+    }
 
     // Set up for single fixed synapses (data that is consistent per direct row)
     single_fixed_synapse[0] = 0;
@@ -294,8 +471,46 @@ bool spike_processing_initialise(
     return true;
 }
 
-void spike_processing_finish_write(uint32_t process_id) {
-    _setup_synaptic_dma_write(process_id);
+void spike_processing_start_tick(uint32_t tick) {
+
+    // The boundary is written before the tick, so that a spike is never
+    // found to be before the boundary of the tick it is given
+    tick_boundaries[tick & TICK_BOUNDARY_MASK] = in_spikes_get_n_added();
+    in_spikes_barrier();
+    current_tick = tick;
+}
+
+void spike_processing_set_drain_guard(uint32_t max_cycles) {
+    drain_guard_cycles = max_cycles;
+    if (max_cycles > 0) {
+        free_running_timer_start();
+    }
+}
+
+//! \brief determines if spikes of earlier ticks are still waiting or being
+//!        processed
+static inline bool _has_earlier_spikes() {
+    uint32_t boundary = tick_boundaries[current_tick & TICK_BOUNDARY_MASK];
+    return ((int32_t) (in_spikes_get_n_taken() - boundary) < 0) ||
+        (dma_busy && spike_arrival_tick != current_tick);
+}
+
+void spike_processing_drain_earlier_ticks() {
+    if (drain_guard_cycles == 0) {
+        return;
+    }
+
+    // The spike processing callbacks interrupt this loop to do the work
+    uint32_t start = free_running_timer_now();
+    while (_has_earlier_spikes() &&
+            free_running_timer_elapsed(start) < drain_guard_cycles) {
+        in_spikes_barrier();
+    }
+}
+
+void spike_processing_finish_write(
+        uint32_t process_id, const plastic_write_back_t *write_back) {
+    _setup_synaptic_dma_write(process_id, write_back);
 }
 
 //! \brief returns the number of times the input buffer has overflowed
@@ -305,3 +520,49 @@ uint32_t spike_processing_get_buffer_overflows() {
     // Check for buffer overflow
     return in_spikes_get_n_buffer_overflows();
 }
+
+//! \brief returns true if spike processing is currently in progress
+//! \return true if there are synaptic rows being transferred or processed
+bool spike_processing_is_busy() {
+    return dma_busy;
+}
+
+//! \brief returns the number of synaptic rows read from the direct matrix
+//! \return the number of rows processed without a DMA
+uint32_t spike_processing_get_n_direct_rows() {
+    return n_direct_rows;
+}
+
+//! \brief returns the number of synaptic rows read by DMA
+//! \return the number of row DMAs started
+uint32_t spike_processing_get_n_row_dmas() {
+    return n_row_dmas;
+}
+
+//! \brief returns the number of spikes merged with an earlier spike with the
+//!        same key, so that the rows were only processed once
+//! \return the number of spikes merged
+uint32_t spike_processing_get_n_merged_spikes() {
+    return n_merged_spikes;
+}
+
+//! \brief returns the number of spikes taken from the input buffer after the
+//!        tick they arrived in had ended
+//! \return the number of late spikes
+uint32_t spike_processing_get_n_late_spikes() {
+    return n_late_spikes;
+}
+
+//! \brief returns the number of bytes of plastic regions written back to
+//!        SDRAM
+//! \return the number of bytes written back
+uint32_t spike_processing_get_n_plastic_bytes_written() {
+    return n_plastic_bytes_written;
+}
+
+//! \brief returns the number of bytes of plastic regions not written back to
+//!        SDRAM, as they had not changed
+//! \return the number of bytes not written back
+uint32_t spike_processing_get_n_plastic_bytes_skipped() {
+    return n_plastic_bytes_skipped;
+}
@@ -2,16 +2,69 @@
 #define _SPIKE_PROCESSING_H_
 
 #include "../common/neuron-typedefs.h"
+#include "plasticity/synapse_dynamics.h"
 
 bool spike_processing_initialise(
     size_t row_max_n_bytes, uint mc_packet_callback_priority,
     uint dma_trasnfer_callback_priority, uint user_event_priority,
     uint incoming_spike_buffer_size);
 
-void spike_processing_finish_write(uint32_t process_id);
+//! \brief writes back the changed words of the plastic region of a row
+//! \param[in] process_id The index of the DMA buffer holding the row
+//! \param[in] write_back The words of the plastic region that changed
+void spike_processing_finish_write(
+    uint32_t process_id, const plastic_write_back_t *write_back);
+
+//! \brief marks the spikes that arrive from now on as arriving in a tick, so
+//!        that their rows are processed for that tick
+//! \param[in] tick The tick that is starting
+void spike_processing_start_tick(uint32_t tick);
+
+//! \brief sets the longest time to wait in
+//!        spike_processing_drain_earlier_ticks
+//! \param[in] max_cycles The time in CPU cycles, or 0 not to wait
+void spike_processing_set_drain_guard(uint32_t max_cycles);
+
+//! \brief waits, up to the time set by spike_processing_set_drain_guard,
+//!        for the spikes that arrived before the current tick to be
+//!        processed; called from the timer callback, which spike processing
+//!        interrupts
+void spike_processing_drain_earlier_ticks();
 
 //! \brief returns the number of times the input buffer has overflowed
 //! \return the number of times the input buffer has overflowed
 uint32_t spike_processing_get_buffer_overflows();
 
+//! \brief returns true if spike processing is currently in progress
+//! \return true if there are synaptic rows being transferred or processed
+bool spike_processing_is_busy();
+
+//! \brief returns the number of synaptic rows read from the direct matrix
+//! \return the number of rows processed without a DMA
+uint32_t spike_processing_get_n_direct_rows();
+
+//! \brief returns the number of synaptic rows read by DMA
+//! \return the number of row DMAs started
+uint32_t spike_processing_get_n_row_dmas();
+
+//! \brief returns the number of spikes merged with an earlier spike with the
+//!        same key, so that the rows were only processed once
+//! \return the number of spikes merged
+uint32_t spike_processing_get_n_merged_spikes();
+
+//! \brief returns the number of spikes taken from the input buffer after the
+//!        tick they arrived in had ended
+//! \return the number of late spikes
+uint32_t spike_processing_get_n_late_spikes();
+
+//! \brief returns the number of bytes of plastic regions written back to
+//!        SDRAM
+//! \return the number of bytes written back
+uint32_t spike_processing_get_n_plastic_bytes_written();
+
+//! \brief returns the number of bytes of plastic regions not written back to
+//!        SDRAM, as they had not changed
+//! \return the number of bytes not written back
+uint32_t spike_processing_get_n_plastic_bytes_skipped();
+
 #endif // _SPIKE_PROCESSING_H_
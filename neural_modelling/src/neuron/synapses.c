@@ -34,9 +34,28 @@ static synapse_param_t *neuron_synapse_shaping_params;
 // Count of the number of times the ring buffers have saturated
 static uint32_t saturation_count = 0;
 
+// The last time step whose ring buffer slot has been moved to the input
+// buffers; input can't be added to this or any earlier slot
+static uint32_t drained_time = UINT32_MAX;
+
+// The number of rows processed for a time step so early that some of their
+// input had to be moved to a later slot, in total, up to the start of the
+// last time step, and the most in a time step
+static uint32_t n_late_rows = 0;
+static uint32_t n_late_rows_at_last_update = 0;
+static uint32_t n_ticks_with_late_rows = 0;
+static uint32_t max_late_rows_in_a_tick = 0;
+
 
 /* PRIVATE FUNCTIONS */
 
+//! \brief whether a row for a time step is late: for a time step so early
+//!        that the slot of its shortest possible delay has been moved to the
+//!        input
+static inline bool _is_late(uint32_t time) {
+    return ((int32_t) (time + 1 - drained_time)) <= 0;
+}
+
 static inline void _print_synaptic_row(synaptic_row_t synaptic_row) {
 #if LOG_LEVEL >= LOG_DEBUG
     log_debug("Synaptic row, at address %08x Num plastic words:%u\n",
@@ -152,16 +171,23 @@ static inline void _print_inputs() {
 
 // This is the "inner loop" of the neural simulation.
 // Every spike event could cause up to 256 different weights to
-// be put into the ring buffer.
+// be put into the ring buffer.  The synapses of several equal spikes are
+// processed at once by adding the weights multiplied by the number of
+// spikes.  In a late row, the input of any synapse that would go into a slot
+// that has already been moved to the input is added to the next slot
+// instead.  This is called with constant multiplicity and late in the
+// common case, so that the compiler removes the work they need.
 static inline void _process_fixed_synapses(
-        address_t fixed_region_address, uint32_t time) {
+        address_t fixed_region_address, uint32_t time,
+        uint32_t multiplicity, bool late) {
     register uint32_t *synaptic_words = synapse_row_fixed_weight_controls(
         fixed_region_address);
     register uint32_t fixed_synapse = synapse_row_num_fixed_synapses(
         fixed_region_address);
+    uint32_t earliest_time = drained_time + 1;
 
 #ifdef SYNAPSE_BENCHMARK
-    num_fixed_pre_synaptic_events += fixed_synapse;
+    num_fixed_pre_synaptic_events += fixed_synapse * multiplicity;
 #endif // SYNAPSE_BENCHMARK
 
     for (; fixed_synapse > 0; fixed_synapse--) {
@@ -171,44 +197,48 @@ static inline void _process_fixed_synapses(
         uint32_t synaptic_word = *synaptic_words++;
 
 #ifdef SYNAPSE_TYPE_TARGET
-
-        if(synapse_row_sparse_type(synaptic_word) == TARGET) {
-
-            //io_printf(IO_BUF,"Weight at %dms: %d\n", time, ((uint8_t)(synapses_convert_weight_to_input(
-            //                        synapse_row_sparse_weight(synaptic_word), ring_buffer_to_input_left_shifts[2]))));
-
-
-            // bypass the ring buffer and neuron, goto postsynaptic event buffer
-            synapse_dynamics_process_target_synaptic_event(time,
-                        synapse_row_sparse_index( synaptic_word),
-                        (uint8_t)synapses_convert_weight_to_input(
-                                    synapse_row_sparse_weight(synaptic_word), 
-                                    ring_buffer_to_input_left_shifts[2]));
+        if (synapse_row_sparse_type(synaptic_word) == TARGET) {
+
+            // bypass the ring buffer and neuron, goto postsynaptic event
+            // buffer; target events can't be combined, so send one per spike
+            for (uint32_t i = 0; i < multiplicity; i++) {
+                synapse_dynamics_process_target_synaptic_event(time,
+                    synapse_row_sparse_index(synaptic_word),
+                    (uint8_t) synapses_convert_weight_to_input(
+                        synapse_row_sparse_weight(synaptic_word),
+                        ring_buffer_to_input_left_shifts[2]));
+            }
         }
-         else
+        else
 #endif
         {
 
             // Extract components from this word
-            uint32_t delay = synapse_row_sparse_delay(synaptic_word);
-            uint32_t combined_synapse_neuron_index = synapse_row_sparse_type_index(
-                    synaptic_word);
-            uint32_t weight = synapse_row_sparse_weight(synaptic_word);
+            uint32_t synapse_time =
+                synapse_row_sparse_delay(synaptic_word) + time;
+            if (late && ((int32_t) (synapse_time - earliest_time) < 0)) {
+                synapse_time = earliest_time;
+            }
+            uint32_t combined_synapse_neuron_index =
+                synapse_row_sparse_type_index(synaptic_word);
+            uint32_t weight =
+                synapse_row_sparse_weight(synaptic_word) * multiplicity;
 
             // Convert into ring buffer offset
-            uint32_t ring_buffer_index = synapses_get_ring_buffer_index_combined(
-                delay + time, combined_synapse_neuron_index);
+            uint32_t ring_buffer_index =
+                synapses_get_ring_buffer_index_combined(
+                    synapse_time, combined_synapse_neuron_index);
 
             // Add weight to current ring buffer value
             uint32_t accumulation = ring_buffers[ring_buffer_index] + weight;
 
-            // If 17th bit is set, saturate accumulator at UINT16_MAX (0xFFFF)
+            // Saturate the accumulator at UINT16_MAX (0xFFFF); the weight
+            // of several spikes can exceed 17 bits, so this is a comparison
+            // rather than a test of the 17th bit
             // **NOTE** 0x10000 can be expressed as an ARM literal,
-            //          but 0xFFFF cannot.  Therefore, we use (0x10000 - 1)
-            //          to obtain this value
-            uint32_t sat_test = accumulation & 0x10000;
-            if (sat_test) {
-                accumulation = sat_test - 1;
+            //          but 0xFFFF cannot
+            if (accumulation >= 0x10000) {
+                accumulation = 0x10000 - 1;
                 saturation_count += 1;
             }
 
@@ -356,18 +386,47 @@ void synapses_do_timestep_update(timer_t time) {
 
     _print_inputs();
 
+    // Input for this time step can no longer be added
+    drained_time = time;
+
     // Re-enable the interrupts
     spin1_mode_restore(state);
+
+    // Count the late rows of the last time step
+    uint32_t n_tick_late_rows = n_late_rows - n_late_rows_at_last_update;
+    n_late_rows_at_last_update = n_late_rows;
+    if (n_tick_late_rows > 0) {
+        n_ticks_with_late_rows += 1;
+        if (n_tick_late_rows > max_late_rows_in_a_tick) {
+            max_late_rows_in_a_tick = n_tick_late_rows;
+        }
+    }
 }
 
-bool synapses_process_synaptic_row(uint32_t time, synaptic_row_t row,
-                                   bool write, uint32_t process_id) {
+uint32_t synapses_get_plastic_time(uint32_t time) {
+
+    // A late row is processed for the last time step drained, as the synapse
+    // dynamics add input at the time plus the delay
+    if (_is_late(time)) {
+        return drained_time;
+    }
+    return time;
+}
+
+bool synapses_process_synaptic_row(
+        uint32_t time, synaptic_row_t row, uint32_t multiplicity, bool write,
+        uint32_t process_id) {
 
     _print_synaptic_row(row);
 
     // Get address of non-plastic region from row
     address_t fixed_region_address = synapse_row_fixed_region(row);
 
+    bool late = _is_late(time);
+    if (late) {
+        n_late_rows++;
+    }
+
     // **TODO** multiple optimised synaptic row formats
     //if (plastic_tag(row) == 0)
     //{
@@ -377,15 +436,22 @@ bool synapses_process_synaptic_row(uint32_t time, synaptic_row_t row,
         // Get region's address
         address_t plastic_region_address = synapse_row_plastic_region(row);
 
-        // Process any plastic synapses
-        if (!synapse_dynamics_process_plastic_synapses(plastic_region_address,
-                fixed_region_address, ring_buffers, time)) {
-            return false;
+        // Process any plastic synapses once for each spike, as each spike
+        // updates the state of the synapses
+        uint32_t plastic_time = synapses_get_plastic_time(time);
+        plastic_write_back_t write_back;
+        synapse_dynamics_write_back_none(&write_back);
+        for (uint32_t i = 0; i < multiplicity; i++) {
+            if (!synapse_dynamics_process_plastic_synapses(
+                    plastic_region_address, fixed_region_address,
+                    ring_buffers, plastic_time, &write_back)) {
+                return false;
+            }
         }
 
-        // Perform DMA write back
+        // Perform DMA write back of the words that changed
         if (write) {
-            spike_processing_finish_write(process_id);
+            spike_processing_finish_write(process_id, &write_back);
         }
     }
 
@@ -393,7 +459,15 @@ bool synapses_process_synaptic_row(uint32_t time, synaptic_row_t row,
     // **NOTE** this is done after initiating DMA in an attempt
     // to hide cost of DMA behind this loop to improve the chance
     // that the DMA controller is ready to read next synaptic row afterwards
-    _process_fixed_synapses(fixed_region_address, time);
+    if (late) {
+        _process_fixed_synapses(
+            fixed_region_address, time, multiplicity, true);
+    } else if (multiplicity == 1) {
+        _process_fixed_synapses(fixed_region_address, time, 1, false);
+    } else {
+        _process_fixed_synapses(
+            fixed_region_address, time, multiplicity, false);
+    }
     //}
     return true;
 }
@@ -405,6 +479,25 @@ uint32_t synapses_get_saturation_count() {
     return saturation_count;
 }
 
+//! \brief returns the number of rows processed for a time step so early that
+//!        some of their input had to be moved to a later time step
+//! \return the number of late rows
+uint32_t synapses_get_n_late_rows() {
+    return n_late_rows;
+}
+
+//! \brief returns the number of time steps in which late rows were processed
+//! \return the number of time steps with late rows
+uint32_t synapses_get_n_ticks_with_late_rows() {
+    return n_ticks_with_late_rows;
+}
+
+//! \brief returns the most late rows processed in one time step
+//! \return the maximum number of late rows in a time step
+uint32_t synapses_get_max_late_rows_in_a_tick() {
+    return max_late_rows_in_a_tick;
+}
+
 //! \brief returns the counters for plastic and fixed pre synaptic events based
 //! on (if the model was compiled with SYNAPSE_BENCHMARK parameter) or
 //! returns 0
@@ -53,14 +53,48 @@ bool synapses_initialise(
 
 void synapses_do_timestep_update(timer_t time);
 
+//! \brief processes a synaptic row for one or more spikes from its source
+//!        received together
+//! \param[in] time The time step in which the spikes arrived; if the input
+//!                 for this time step plus a delay has already been moved to
+//!                 the neurons, it is added at the next time step instead
+//! \param[in] row The row to process
+//! \param[in] multiplicity The number of spikes to process the row for; the
+//!                         weights of the fixed synapses are multiplied by
+//!                         this, and the plastic synapses are processed once
+//!                         per spike
+//! \param[in] write True if the plastic region should be written back
+//! \param[in] process_id The index of the DMA buffer holding the row
+//! \return True if the row was processed successfully
 bool synapses_process_synaptic_row(
-    uint32_t time, synaptic_row_t row, bool write, uint32_t process_id);
+    uint32_t time, synaptic_row_t row, uint32_t multiplicity, bool write,
+    uint32_t process_id);
+
+//! \brief gets the time step for which the plastic synapses of a row are
+//!        updated: the time step of the row, or for a late row, the last
+//!        time step moved to the input
+//! \param[in] time The time step of the row
+//! \return The time step of the plastic update
+uint32_t synapses_get_plastic_time(uint32_t time);
 
 //! \brief returns the number of times the synapses have saturated their
 //!        weights.
 //! \return the number of times the synapses have saturated.
 uint32_t synapses_get_saturation_count();
 
+//! \brief returns the number of rows processed for a time step so early that
+//!        some of their input had to be moved to a later time step
+//! \return the number of late rows
+uint32_t synapses_get_n_late_rows();
+
+//! \brief returns the number of time steps in which late rows were processed
+//! \return the number of time steps with late rows
+uint32_t synapses_get_n_ticks_with_late_rows();
+
+//! \brief returns the most late rows processed in one time step
+//! \return the maximum number of late rows in a time step
+uint32_t synapses_get_max_late_rows_in_a_tick();
+
 //! \brief returns the counters for plastic and fixed pre synaptic events based
 //!        on (if the model was compiled with SYNAPSE_BENCHMARK parameter) or
 //!        returns 0
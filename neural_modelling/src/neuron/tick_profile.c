@@ -0,0 +1,153 @@
+/*! \file
+ *
+ * \brief implementation of the tick_profile.h interface.
+ *
+ */
+
+#include "tick_profile.h"
+#include "../common/free_running_timer.h"
+#include <debug.h>
+
+#ifdef TICK_PROFILE
+
+//! Statistics kept for each phase
+typedef struct phase_stats_t {
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+    uint32_t n_samples;
+    log2_histogram_t histogram;
+} phase_stats_t;
+
+static phase_stats_t phase_stats[TICK_PROFILE_N_PHASES];
+
+//! The number of ticks measured
+static uint32_t n_ticks = 0;
+
+//! The number of ticks that finished after the next tick was due
+static uint32_t n_late_ticks = 0;
+
+//! The number of ticks that started with spike processing still running
+static uint32_t n_spike_processing_busy_ticks = 0;
+
+//! The number of cycles in a timer tick
+static uint32_t tick_cycles;
+
+//! The number of cycles between the tick interrupt and the tick starting
+static uint32_t tick_start_latency;
+
+//! Timer 2 value at the start of the tick and at the last phase boundary
+static uint32_t tick_start_time;
+static uint32_t phase_start_time;
+
+//! Timer 2 value at the start of the current spike processing callback
+static uint32_t spike_processing_start_time;
+
+//! Cycles spent processing spikes since the start of the last tick
+static uint32_t spike_processing_cycles = 0;
+
+static inline void _add_sample(tick_profile_phases phase, uint32_t cycles) {
+    phase_stats_t *stats = &phase_stats[phase];
+    if (cycles < stats->min_cycles) {
+        stats->min_cycles = cycles;
+    }
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+    stats->total_cycles += cycles;
+    stats->n_samples += 1;
+    log2_histogram_add(
+        &stats->histogram, cycles >> TICK_PROFILE_HISTOGRAM_SHIFT);
+}
+
+void tick_profile_initialise(uint32_t timer_period) {
+    tick_cycles = timer_period * sv->cpu_clk;
+    for (uint32_t i = 0; i < TICK_PROFILE_N_PHASES; i++) {
+        phase_stats[i].min_cycles = UINT32_MAX;
+        phase_stats[i].max_cycles = 0;
+        phase_stats[i].total_cycles = 0;
+        phase_stats[i].n_samples = 0;
+        log2_histogram_clear(&phase_stats[i].histogram);
+    }
+    free_running_timer_start();
+    log_info("Tick profiling enabled, %u cycles per tick", tick_cycles);
+}
+
+void tick_profile_start_tick(bool spike_processing_busy) {
+    tick_start_time = free_running_timer_now();
+    phase_start_time = tick_start_time;
+
+    // Timer 1 counts down from its load value since the tick interrupt
+    tick_start_latency = tc[T1_LOAD] - tc[T1_COUNT];
+
+    if (spike_processing_busy) {
+        n_spike_processing_busy_ticks += 1;
+    }
+
+    // Account the spike processing done since the last tick started
+    if (n_ticks > 0) {
+        uint32_t state = spin1_int_disable();
+        _add_sample(TICK_PROFILE_SPIKE_PROCESSING, spike_processing_cycles);
+        spike_processing_cycles = 0;
+        spin1_mode_restore(state);
+    }
+    n_ticks += 1;
+}
+
+void tick_profile_end_phase(tick_profile_phases phase) {
+    uint32_t now = free_running_timer_now();
+    _add_sample(phase, phase_start_time - now);
+    phase_start_time = now;
+}
+
+void tick_profile_end_tick() {
+    uint32_t tick_time =
+        tick_start_latency + free_running_timer_elapsed(tick_start_time);
+    if (tick_time > tick_cycles) {
+        n_late_ticks += 1;
+    }
+}
+
+void tick_profile_start_spike_processing() {
+    spike_processing_start_time = free_running_timer_now();
+}
+
+void tick_profile_end_spike_processing() {
+    spike_processing_cycles +=
+        free_running_timer_elapsed(spike_processing_start_time);
+}
+
+address_t tick_profile_store_provenance(address_t provenance_region) {
+    provenance_region[0] = n_ticks;
+    provenance_region[1] = n_late_ticks;
+    provenance_region[2] = n_spike_processing_busy_ticks;
+    provenance_region[3] = sv->cpu_clk;
+    address_t next = &(provenance_region[TICK_PROFILE_N_HEADER_WORDS]);
+    for (uint32_t i = 0; i < TICK_PROFILE_N_PHASES; i++) {
+        phase_stats_t *stats = &phase_stats[i];
+        if (stats->n_samples > 0) {
+            next[0] = stats->min_cycles;
+            next[1] = stats->max_cycles;
+            next[2] = (uint32_t) (stats->total_cycles / stats->n_samples);
+        } else {
+            next[0] = 0;
+            next[1] = 0;
+            next[2] = 0;
+        }
+        next = log2_histogram_write(&stats->histogram, &(next[3]));
+    }
+    return next;
+}
+
+#else
+
+address_t tick_profile_store_provenance(address_t provenance_region) {
+
+    // Write zeros so the host can tell that no profile was taken
+    for (uint32_t i = 0; i < TICK_PROFILE_N_PROVENANCE_WORDS; i++) {
+        provenance_region[i] = 0;
+    }
+    return &(provenance_region[TICK_PROFILE_N_PROVENANCE_WORDS]);
+}
+
+#endif // TICK_PROFILE
@@ -0,0 +1,120 @@
+/*! \file
+ *
+ *  \brief optional instrumentation of the phases of the timer tick
+ *
+ *  \details When compiled with TICK_PROFILE defined, the time taken by each
+ *  phase of the timer tick (synapse update, neuron update and recording) and
+ *  by the spike processing done in between is measured using the free-running
+ *  timer 2, and the minimum, maximum, mean and a histogram of each are kept.
+ *  Ticks that finish after the next tick was due, and ticks that start while
+ *  spike processing of the last tick is still running are also counted.
+ *
+ *  Without TICK_PROFILE, all the functions except
+ *  tick_profile_store_provenance compile to nothing, and that writes zeros,
+ *  so that the provenance data layout does not depend on the build.
+ *
+ *  The API contains:
+ *    - tick_profile_initialise(timer_period):
+ *         sets up the timer used for measurement
+ *    - tick_profile_start_tick(spike_processing_busy):
+ *         marks the start of a timer tick
+ *    - tick_profile_end_phase(phase):
+ *         marks the end of a phase of the tick
+ *    - tick_profile_end_tick():
+ *         marks the end of the timer tick
+ *    - tick_profile_start_spike_processing() /
+ *      tick_profile_end_spike_processing():
+ *         mark the start and end of each spike processing callback
+ *    - tick_profile_store_provenance(provenance_region):
+ *         writes the statistics to the provenance data region
+ */
+
+#ifndef _TICK_PROFILE_H_
+#define _TICK_PROFILE_H_
+
+#include "../common/neuron-typedefs.h"
+#include "../common/log2_histogram.h"
+
+//! The phases of the timer tick that are measured
+typedef enum tick_profile_phases {
+    TICK_PROFILE_SYNAPSES,
+    TICK_PROFILE_NEURONS,
+    TICK_PROFILE_RECORDING,
+    TICK_PROFILE_SPIKE_PROCESSING,
+    TICK_PROFILE_N_PHASES
+} tick_profile_phases;
+
+//! The histograms count cycles in units of 2^TICK_PROFILE_HISTOGRAM_SHIFT
+#define TICK_PROFILE_HISTOGRAM_SHIFT 8
+
+//! The number of header words in the provenance data: the number of ticks
+//! measured, the number of late ticks, the number of ticks which started
+//! with spike processing still running and the CPU clock in MHz
+#define TICK_PROFILE_N_HEADER_WORDS 4
+
+//! The number of provenance words per phase: the minimum, maximum and mean
+//! number of cycles, followed by the histogram
+#define TICK_PROFILE_N_PHASE_WORDS (3 + LOG2_HISTOGRAM_N_BINS)
+
+//! The number of words written by tick_profile_store_provenance
+#define TICK_PROFILE_N_PROVENANCE_WORDS \
+    (TICK_PROFILE_N_HEADER_WORDS + \
+     (TICK_PROFILE_N_PHASES * TICK_PROFILE_N_PHASE_WORDS))
+
+#ifdef TICK_PROFILE
+
+//! \brief sets up timer 2 to be used to measure the phases
+//! \param[in] timer_period The timer tick period in microseconds
+void tick_profile_initialise(uint32_t timer_period);
+
+//! \brief marks the start of a timer tick
+//! \param[in] spike_processing_busy True if the spike processing was still
+//!            running when the tick started
+void tick_profile_start_tick(bool spike_processing_busy);
+
+//! \brief marks the end of a phase of the timer tick (and so the start of
+//!        the next)
+//! \param[in] phase The phase that has just ended
+void tick_profile_end_phase(tick_profile_phases phase);
+
+//! \brief marks the end of the timer tick, counting it if late
+void tick_profile_end_tick();
+
+//! \brief marks the start of a spike processing callback
+void tick_profile_start_spike_processing();
+
+//! \brief marks the end of a spike processing callback
+void tick_profile_end_spike_processing();
+
+#else
+
+static inline void tick_profile_initialise(uint32_t timer_period) {
+    use(timer_period);
+}
+
+static inline void tick_profile_start_tick(bool spike_processing_busy) {
+    use(spike_processing_busy);
+}
+
+static inline void tick_profile_end_phase(tick_profile_phases phase) {
+    use(phase);
+}
+
+static inline void tick_profile_end_tick() {
+}
+
+static inline void tick_profile_start_spike_processing() {
+}
+
+static inline void tick_profile_end_spike_processing() {
+}
+
+#endif // TICK_PROFILE
+
+//! \brief writes the statistics to the provenance data region
+//! \param[in] provenance_region The address to write the
+//!            TICK_PROFILE_N_PROVENANCE_WORDS words to
+//! \return The address following the written words
+address_t tick_profile_store_provenance(address_t provenance_region);
+
+#endif // _TICK_PROFILE_H_
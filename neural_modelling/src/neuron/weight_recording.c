@@ -0,0 +1,191 @@
+/*! \file
+ *
+ * \brief implementation of the weight_recording.h interface.
+ *
+ */
+
+#include "weight_recording.h"
+#include <recording.h>
+#include <spin1_api.h>
+#include <debug.h>
+
+//! A range of the synaptic blocks holding rows whose weights are recorded
+typedef struct recorded_block_t {
+    uint32_t offset;
+    uint32_t n_bytes;
+} recorded_block_t;
+
+//! The layout of the weight recording region
+typedef struct weight_recording_config_t {
+    uint32_t interval_ticks;
+    uint32_t buffer_words;
+    uint32_t n_blocks;
+    recorded_block_t blocks[];
+} weight_recording_config_t;
+
+static recorded_block_t *blocks;
+
+//! The number of ranges to record, or 0 if weights are not recorded
+static uint32_t n_blocks = 0;
+
+//! The address that the offsets of the rows are from
+static address_t synaptic_blocks_address;
+
+static uint32_t interval_ticks;
+
+//! The number of ticks until the next flush
+static uint32_t ticks_to_flush;
+
+//! The two buffers, one being filled while the other is recorded
+static uint32_t *buffers[2];
+
+//! The buffer being filled, its size and the number of words in it
+static uint32_t *buffer;
+static uint32_t buffer_words;
+static uint32_t n_buffer_words = 0;
+
+//! The entry of the row being processed, or NULL if it is not recorded
+static uint32_t *row_entry = NULL;
+
+//! True if the row being processed is recorded but there was no space for
+//! its entry
+static bool row_lost = false;
+
+static uint32_t n_changes_recorded = 0;
+
+static uint32_t n_changes_lost = 0;
+
+//! \brief determines if a row is in one of the ranges to record
+static inline bool _is_recorded(uint32_t offset) {
+    for (uint32_t i = 0; i < n_blocks; i++) {
+        if ((offset - blocks[i].offset) < blocks[i].n_bytes) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool weight_recording_initialise(
+        address_t address, address_t synaptic_blocks,
+        uint32_t recording_flags) {
+    weight_recording_config_t *config = (weight_recording_config_t *) address;
+    if (!recording_is_channel_enabled(
+            recording_flags, WEIGHT_RECORDING_CHANNEL) ||
+            config->interval_ticks == 0 || config->n_blocks == 0) {
+        n_blocks = 0;
+        return true;
+    }
+    interval_ticks = config->interval_ticks;
+    ticks_to_flush = interval_ticks;
+    buffer_words = config->buffer_words;
+    synaptic_blocks_address = synaptic_blocks;
+
+    blocks = (recorded_block_t *) spin1_malloc(
+        config->n_blocks * sizeof(recorded_block_t));
+    if (blocks == NULL) {
+        log_error("Not enough memory to allocate the weight recording ranges");
+        return false;
+    }
+    for (uint32_t i = 0; i < 2; i++) {
+        buffers[i] = (uint32_t *) spin1_malloc(
+            buffer_words * sizeof(uint32_t));
+        if (buffers[i] == NULL) {
+            log_error("Not enough memory to allocate the weight buffers");
+            return false;
+        }
+    }
+    buffer = buffers[0];
+    n_buffer_words = 0;
+    for (uint32_t i = 0; i < config->n_blocks; i++) {
+        blocks[i] = config->blocks[i];
+    }
+    n_blocks = config->n_blocks;
+    log_info(
+        "Recording the weights of %u blocks every %u ticks in %u words",
+        n_blocks, interval_ticks, buffer_words);
+    return true;
+}
+
+void weight_recording_start_row(address_t row_address, uint32_t time) {
+    if (n_blocks == 0) {
+        return;
+    }
+    uint32_t offset =
+        (uint8_t *) row_address - (uint8_t *) synaptic_blocks_address;
+    if (!_is_recorded(offset)) {
+        return;
+    }
+    if (n_buffer_words + WEIGHT_RECORDING_ENTRY_HEADER_WORDS > buffer_words) {
+        row_lost = true;
+        return;
+    }
+    row_entry = &buffer[n_buffer_words];
+    row_entry[0] = time;
+    row_entry[1] = offset;
+    row_entry[2] = 0;
+    n_buffer_words += WEIGHT_RECORDING_ENTRY_HEADER_WORDS;
+}
+
+void weight_recording_record_synapse(uint32_t control_word, uint32_t weight) {
+    if (row_entry == NULL) {
+        if (row_lost) {
+            n_changes_lost += 1;
+        }
+        return;
+    }
+    if (n_buffer_words == buffer_words) {
+        n_changes_lost += 1;
+        return;
+    }
+    buffer[n_buffer_words++] =
+        (weight << 16) | (control_word & 0xFFFF);
+    row_entry[2] += 1;
+    n_changes_recorded += 1;
+}
+
+void weight_recording_end_row() {
+
+    // Only keep the entries of rows in which a weight changed
+    if (row_entry != NULL && row_entry[2] == 0) {
+        n_buffer_words -= WEIGHT_RECORDING_ENTRY_HEADER_WORDS;
+    }
+    row_entry = NULL;
+    row_lost = false;
+}
+
+void weight_recording_flush() {
+    if (n_blocks == 0) {
+        return;
+    }
+
+    // Swap the buffers, so that the rows processed while the full one is
+    // recorded are added to the other
+    uint cpsr = spin1_int_disable();
+    uint32_t *full_buffer = buffer;
+    uint32_t n_words = n_buffer_words;
+    buffer = (buffer == buffers[0]) ? buffers[1] : buffers[0];
+    n_buffer_words = 0;
+    spin1_mode_restore(cpsr);
+
+    if (n_words > 0) {
+        recording_record(
+            WEIGHT_RECORDING_CHANNEL, full_buffer,
+            n_words * sizeof(uint32_t));
+    }
+}
+
+void weight_recording_do_timestep_update() {
+    if (n_blocks == 0) {
+        return;
+    }
+    ticks_to_flush -= 1;
+    if (ticks_to_flush == 0) {
+        ticks_to_flush = interval_ticks;
+        weight_recording_flush();
+    }
+}
+
+void weight_recording_store_provenance(address_t provenance_region) {
+    provenance_region[0] = n_changes_recorded;
+    provenance_region[1] = n_changes_lost;
+}
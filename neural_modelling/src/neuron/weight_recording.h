@@ -0,0 +1,99 @@
+/*! \file
+ *
+ *  \brief recording of the changes to the weights of selected plastic
+ *  projections while the simulation runs
+ *
+ *  \details The host writes the interval between flushes, the size of the
+ *  buffers and the byte ranges of the synaptic matrix that hold the blocks
+ *  of rows of the projections to record to the weight recording region.
+ *  When a row in one of the ranges is processed, each synapse whose weight
+ *  changes is added to an entry for the row in a DTCM buffer:
+ *    - the tick the row was processed for
+ *    - the byte offset of the row from the start of the synaptic blocks
+ *    - the number of synapses that follow
+ *    - a word per synapse, holding the new weight in the upper half and the
+ *      control word of the synapse in the lower half, as a fixed synapse
+ *      word does
+ *  Every interval ticks, the timer callback swaps the buffers and records
+ *  the entries added since the last flush to the weight recording channel,
+ *  so that only the weights that changed are ever sent to the host, which
+ *  finds the projection, source and target of each synapse from the row
+ *  offset and control word.  When a buffer fills, the changes that do not
+ *  fit are counted and lost.
+ *
+ *  Rows are processed by the DMA callback, which can interrupt the timer
+ *  callback but is never interrupted by it, so only the swap of the buffers
+ *  needs interrupts disabled.
+ *
+ *  The API contains:
+ *    - weight_recording_initialise(address, synaptic_blocks,
+ *                                  recording_flags):
+ *         reads the ranges and allocates the buffers
+ *    - weight_recording_start_row(row_address, time):
+ *         called before a row read by DMA is processed
+ *    - weight_recording_record_synapse(control_word, weight):
+ *         called when the weight of a synapse of the row has changed
+ *    - weight_recording_end_row():
+ *         called when the row has been processed
+ *    - weight_recording_do_timestep_update():
+ *         flushes the buffer every interval ticks
+ *    - weight_recording_flush():
+ *         records the entries added since the last flush, before the
+ *         recording is finalised
+ *    - weight_recording_store_provenance(provenance_region):
+ *         writes the number of changes recorded and lost
+ */
+
+#ifndef _WEIGHT_RECORDING_H_
+#define _WEIGHT_RECORDING_H_
+
+#include "../common/neuron-typedefs.h"
+
+//! The recording channel of the weight changes, after spikes, V and gsyn
+#define WEIGHT_RECORDING_CHANNEL 3
+
+//! The number of words before the synapses of each entry
+#define WEIGHT_RECORDING_ENTRY_HEADER_WORDS 3
+
+//! The number of changes recorded and the number lost
+#define WEIGHT_RECORDING_N_PROVENANCE_WORDS 2
+
+//! \brief reads the intervals and ranges written by the host and allocates
+//!        the buffers if the weight recording channel is enabled
+//! \param[in] address The address of the weight recording region
+//! \param[in] synaptic_blocks The address that the row offsets are from
+//! \param[in] recording_flags The recording flags of the core
+//! \return True if successful, False if there was not enough DTCM
+bool weight_recording_initialise(
+    address_t address, address_t synaptic_blocks, uint32_t recording_flags);
+
+//! \brief starts an entry for a row if it is in one of the ranges to record
+//! \param[in] row_address The SDRAM address the row was read from
+//! \param[in] time The tick the row is processed for
+void weight_recording_start_row(address_t row_address, uint32_t time);
+
+//! \brief adds a synapse whose weight has changed to the entry of the row
+//!        being processed, if there is one
+//! \param[in] control_word The control word of the synapse
+//! \param[in] weight The new weight of the synapse, of which the lower 16
+//!                   bits are recorded
+void weight_recording_record_synapse(uint32_t control_word, uint32_t weight);
+
+//! \brief completes the entry of the row being processed, discarding it if
+//!        no weight changed
+void weight_recording_end_row();
+
+//! \brief records the entries added since the last flush, if this is the
+//!        last tick of an interval
+void weight_recording_do_timestep_update();
+
+//! \brief records the entries added since the last flush
+void weight_recording_flush();
+
+//! \brief writes the numbers of changes recorded and lost to the provenance
+//!        region
+//! \param[in] provenance_region Where to write the
+//!                              WEIGHT_RECORDING_N_PROVENANCE_WORDS words
+void weight_recording_store_provenance(address_t provenance_region);
+
+#endif // _WEIGHT_RECORDING_H_
@@ -22,11 +22,15 @@ class AbstractSpikeRecordable(object):
         """
 
     @abstractmethod
-    def get_spikes(self, placements, graph_mapper, buffer_manager):
+    def get_spikes(self, placements, graph_mapper, buffer_manager,
+                   spike_file_path=None):
         """ Get the recorded spikes from the object
         :param placements: the placements object
         :param graph_mapper: the graph mapper object
         :param buffer_manager: the buffer manager object
+        :param spike_file_path: a binary spike file to write the spikes to\
+                as they are extracted, or None to return them
         :return: A numpy array of 2-element arrays of (neuron_id, time)\
-                ordered by time
+                ordered by neuron_id and then time, or the number of spikes\
+                written if spike_file_path is given
         """
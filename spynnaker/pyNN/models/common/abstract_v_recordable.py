@@ -23,7 +23,7 @@ class AbstractVRecordable(object):
 
     @abstractmethod
     def get_v(self, n_machine_time_steps, placements, graph_mapper,
-              buffer_manager):
+              buffer_manager, store_directory=None):
         """ Get the recorded v from the object
 
         :param n_machine_time_steps: the number of timer ticks that will\
@@ -31,6 +31,9 @@ class AbstractVRecordable(object):
         :param placements: The placements of the graph
         :param graph_mapper: The mapper between subvertices and vertices
         :param buffer_manager: the buffer manager object
+        :param store_directory: a directory to write a recording store to\
+                as the v is extracted, or None to return the v
         :return: A numpy array of 3-element arrays of (neuron_id, time, v)\
-                ordered by time
+                ordered by neuron_id and then time, or a RecordingStore\
+                reader if store_directory is given
         """
@@ -2,6 +2,8 @@ from spinn_machine.utilities.progress_bar import ProgressBar
 from spinnman.messages.eieio.data_messages.eieio_data_header \
     import EIEIODataHeader
 
+from spynnaker.pyNN.models.common import recording_utils
+
 import numpy
 
 import logging
@@ -37,13 +39,15 @@ class EIEIOSpikeRecorder(object):
 
     def get_spikes(self, label, buffer_manager, region, state_region,
                    placements, graph_mapper, partitionable_vertex,
-                   base_key_function):
+                   base_key_function, spike_file_path=None):
 
-        results = list()
+        gatherer = recording_utils.SpikeGatherer(spike_file_path)
         missing_str = ""
         ms_per_tick = self._machine_time_step / 1000.0
-        subvertices = \
-            graph_mapper.get_subvertices_from_vertex(partitionable_vertex)
+        subvertices = sorted(
+            graph_mapper.get_subvertices_from_vertex(partitionable_vertex),
+            key=lambda subvertex:
+                graph_mapper.get_subvertex_slice(subvertex).lo_atom)
         progress_bar = ProgressBar(len(subvertices),
                                    "Getting spikes for {}".format(label))
 
@@ -65,6 +69,8 @@ class EIEIOSpikeRecorder(object):
             spike_data = str(raw_spike_data.read_all())
             number_of_bytes_written = len(spike_data)
 
+            spike_ids = list()
+            spike_times = list()
             offset = 0
             while offset < number_of_bytes_written:
                 eieio_header = EIEIODataHeader.from_bytestring(
@@ -78,7 +84,12 @@ class EIEIOSpikeRecorder(object):
                 neuron_ids = ((keys - base_key_function(subvertex)) +
                               subvertex_slice.lo_atom)
                 offset += eieio_header.count * 4
-                results.append(numpy.dstack((neuron_ids, timestamps))[0])
+                spike_ids.append(neuron_ids)
+                spike_times.append(timestamps)
+            if len(spike_ids) > 0:
+                gatherer.add_core(
+                    numpy.concatenate(spike_ids),
+                    numpy.concatenate(spike_times))
             progress_bar.update()
 
         progress_bar.end()
@@ -86,9 +97,4 @@ class EIEIOSpikeRecorder(object):
             logger.warn(
                 "Population {} is missing spike data in region {} from the"
                 " following cores: {}".format(label, region, missing_str))
-        if len(results) != 0:
-            result = numpy.vstack(results)
-            result = result[numpy.lexsort((result[:, 1], result[:, 0]))]
-        else:
-            result = []
-        return result
+        return gatherer.finish()
@@ -41,14 +41,18 @@ class GsynRecorder(object):
         return n_neurons * 8
 
     def get_gsyn(self, label, buffer_manager, region, state_region,
-                 placements, graph_mapper, partitionable_vertex):
+                 placements, graph_mapper, partitionable_vertex,
+                 store_directory=None):
 
         ms_per_tick = self._machine_time_step / 1000.0
 
-        subvertices = \
-            graph_mapper.get_subvertices_from_vertex(partitionable_vertex)
+        subvertices = sorted(
+            graph_mapper.get_subvertices_from_vertex(partitionable_vertex),
+            key=lambda subvertex:
+                graph_mapper.get_subvertex_slice(subvertex).lo_atom)
 
-        data = list()
+        gatherer = recording_utils.ValueGatherer(
+            2, 1.0 / 32767.0, store_directory)
         missing_str = ""
 
         progress_bar = ProgressBar(
@@ -72,19 +76,9 @@ class GsynRecorder(object):
             record = (numpy.asarray(record_raw, dtype="uint8").
                       view(dtype="<i4")).reshape(
                 (-1, ((vertex_slice.n_atoms * 2) + 1)))
-            split_record = numpy.array_split(record, [1, 1], 1)
-            record_time = numpy.repeat(
-                split_record[0] * float(ms_per_tick),
-                vertex_slice.n_atoms, 1)
-            record_ids = numpy.tile(
-                numpy.arange(vertex_slice.lo_atom, vertex_slice.hi_atom + 1),
-                len(record_time)).reshape((-1, vertex_slice.n_atoms))
-            record_gsyn = (split_record[2] / 32767.0).reshape(
-                [-1, vertex_slice.n_atoms, 2])
-
-            part_data = numpy.dstack([record_ids, record_time, record_gsyn])
-            part_data = numpy.reshape(part_data, [-1, 4])
-            data.append(part_data)
+            gatherer.add_core(
+                vertex_slice.lo_atom, record[:, 0] * float(ms_per_tick),
+                record[:, 1:])
             progress_bar.update()
 
         progress_bar.end()
@@ -93,7 +87,4 @@ class GsynRecorder(object):
                 "Population {} is missing conductance data in region {}"
                 " from the following cores: {}".format(
                     label, region, missing_str))
-        data = numpy.vstack(data)
-        order = numpy.lexsort((data[:, 1], data[:, 0]))
-        result = data[order]
-        return result
+        return gatherer.finish()
@@ -1,6 +1,7 @@
 from spinn_machine.utilities.progress_bar import ProgressBar
 
 from spynnaker.pyNN.models.common import recording_utils
+from spynnaker.pyNN.utilities import spike_bits
 
 import math
 import numpy
@@ -44,14 +45,16 @@ class MultiSpikeRecorder(object):
         return n_neurons * 4
 
     def get_spikes(self, label, buffer_manager, region, state_region,
-                   placements, graph_mapper, partitionable_vertex):
+                   placements, graph_mapper, partitionable_vertex,
+                   spike_file_path=None):
 
-        spike_times = list()
-        spike_ids = list()
         ms_per_tick = self._machine_time_step / 1000.0
+        gatherer = recording_utils.SpikeGatherer(spike_file_path)
 
-        subvertices = \
-            graph_mapper.get_subvertices_from_vertex(partitionable_vertex)
+        subvertices = sorted(
+            graph_mapper.get_subvertices_from_vertex(partitionable_vertex),
+            key=lambda subvertex:
+                graph_mapper.get_subvertex_slice(subvertex).lo_atom)
 
         missing_str = ""
 
@@ -78,22 +81,25 @@ class MultiSpikeRecorder(object):
             if data_missing:
                 missing_str += "({}, {}, {}); ".format(x, y, p)
             raw_data = neuron_param_region_data_pointer.read_all()
+            spike_ids = list()
+            spike_times = list()
             offset = 0
             while offset < len(raw_data):
                 ((time, n_blocks), offset) = (
                     struct.unpack_from("<II", raw_data, offset), offset + 8)
                 (spike_data, offset) = (numpy.frombuffer(
-                    raw_data, dtype="uint8",
-                    count=n_bytes_per_block * n_blocks, offset=offset),
+                    raw_data, dtype="<u4", count=n_words * n_blocks,
+                    offset=offset),
                     offset + (n_bytes_per_block * n_blocks))
-                spikes = spike_data.view("<i4").byteswap().view("uint8")
-                bits = numpy.fliplr(numpy.unpackbits(spikes).reshape(
-                    (-1, 32))).reshape((-1, n_bytes_per_block * 8))
-                indices = numpy.nonzero(bits)[1]
-                times = numpy.repeat([time * ms_per_tick], len(indices))
-                indices = indices + lo_atom
-                spike_ids.append(indices)
-                spike_times.append(times)
+                _, indices = spike_bits.decode_spikes(
+                    spike_data.reshape((n_blocks, n_words)))
+                spike_ids.append(indices + lo_atom)
+                spike_times.append(
+                    numpy.repeat([time * ms_per_tick], len(indices)))
+            if len(spike_ids) > 0:
+                gatherer.add_core(
+                    numpy.concatenate(spike_ids),
+                    numpy.concatenate(spike_times))
             progress_bar.update()
 
         progress_bar.end()
@@ -102,7 +108,4 @@ class MultiSpikeRecorder(object):
                 "Population {} is missing spike data in region {} from the"
                 " following cores: {}".format(label, region, missing_str))
 
-        spike_ids = numpy.hstack(spike_ids)
-        spike_times = numpy.hstack(spike_times)
-        result = numpy.dstack((spike_ids, spike_times))[0]
-        return result[numpy.lexsort((spike_times, spike_ids))]
+        return gatherer.finish()
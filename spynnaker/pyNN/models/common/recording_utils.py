@@ -1,5 +1,7 @@
 from spinn_front_end_common.utilities import helpful_functions
 from spynnaker.pyNN import exceptions
+from spynnaker.pyNN.utilities import recording_store
+from spynnaker.pyNN.utilities import spike_file
 
 import struct
 import logging
@@ -90,3 +92,136 @@ def get_buffer_sizes(buffer_max, space_needed, enable_buffered_recording):
     if buffer_max < space_needed:
         return buffer_max
     return space_needed
+
+
+class SpikeGatherer(object):
+    """ Gathers the recorded spikes of a population a core at a time, either\
+        into an array allocated once every core has been read, or straight\
+        into a binary spike file
+    """
+
+    __slots__ = ["_cores", "_n_spikes", "_spike_file"]
+
+    def __init__(self, spike_file_path=None):
+        """
+
+        :param spike_file_path: The binary spike file to write, or None to\
+            gather the spikes into an array
+        """
+        self._cores = list()
+        self._n_spikes = 0
+        self._spike_file = None
+        if spike_file_path is not None:
+            self._spike_file = spike_file.open_binary_spike_file(
+                spike_file_path)
+
+    def add_core(self, neuron_ids, times):
+        """ Add the spikes of a core; cores should be added in order of\
+            their first neuron id
+
+        :param neuron_ids: The population neuron ids of the spikes
+        :param times: The times of the spikes in milliseconds
+        """
+        order = numpy.lexsort((times, neuron_ids))
+        neuron_ids = neuron_ids[order]
+        times = times[order]
+        self._n_spikes += len(order)
+        if self._spike_file is not None:
+            spike_file.write_binary_spikes(self._spike_file, times, neuron_ids)
+        else:
+            self._cores.append((neuron_ids, times))
+
+    def finish(self):
+        """ Finish gathering
+
+        :return: The number of spikes written if writing a file, otherwise\
+            an array of (neuron_id, time) ordered by neuron id and then time
+        """
+        if self._spike_file is not None:
+            self._spike_file.close()
+            return self._n_spikes
+
+        # The spikes of each core are copied and then freed, so that there
+        # is no more than one core of spikes in memory twice
+        result = numpy.empty((self._n_spikes, 2), dtype="float64")
+        offset = 0
+        self._cores.reverse()
+        while len(self._cores) > 0:
+            neuron_ids, times = self._cores.pop()
+            result[offset:offset + len(times), 0] = neuron_ids
+            result[offset:offset + len(times), 1] = times
+            offset += len(times)
+        return result
+
+
+class ValueGatherer(object):
+    """ Gathers values recorded from every neuron of a population at every\
+        time step a core at a time, either into an array allocated once\
+        every core has been read, or straight into a recording store
+    """
+
+    __slots__ = ["_cores", "_n_rows", "_n_values", "_scale", "_store"]
+
+    def __init__(self, n_values, scale, store_directory=None):
+        """
+
+        :param n_values: The number of values recorded per neuron
+        :param scale: The scale to multiply the recorded values by
+        :param store_directory: The directory of the recording store to\
+            write, or None to gather the values into an array
+        """
+        self._cores = list()
+        self._n_rows = 0
+        self._n_values = n_values
+        self._scale = scale
+        self._store = None
+        if store_directory is not None:
+            self._store = recording_store.RecordingStoreWriter(
+                store_directory, n_values)
+
+    def add_core(self, lo_atom, times, values):
+        """ Add the values of a core; cores should be added in order of\
+            their first neuron id
+
+        :param lo_atom: The first neuron id of the core
+        :param times: The time of each row of values in milliseconds
+        :param values: The recorded values, with a row for each time
+        """
+        if len(times) == 0:
+            return
+        order = numpy.argsort(times, kind="mergesort")
+        times = times[order]
+        values = values[order]
+        if self._store is not None:
+            self._store.add_core(lo_atom, times, values * self._scale)
+        else:
+            self._cores.append((lo_atom, times, values))
+            self._n_rows += values.size // self._n_values
+
+    def finish(self):
+        """ Finish gathering
+
+        :return: A reader of the store if writing a store, otherwise an\
+            array of (neuron_id, time, value...) ordered by neuron id and\
+            then time
+        """
+        if self._store is not None:
+            return self._store.close()
+
+        # Each core is transposed into its place in the result and then
+        # freed, rather than stacking the cores and sorting the whole result
+        result = numpy.empty(
+            (self._n_rows, 2 + self._n_values), dtype="float64")
+        offset = 0
+        self._cores.reverse()
+        while len(self._cores) > 0:
+            lo_atom, times, values = self._cores.pop()
+            values = values.reshape((len(times), -1, self._n_values))
+            n_atoms = values.shape[1]
+            part = result[offset:offset + n_atoms * len(times)].reshape(
+                (n_atoms, len(times), 2 + self._n_values))
+            part[:, :, 0] = numpy.arange(lo_atom, lo_atom + n_atoms)[:, None]
+            part[:, :, 1] = times[None, :]
+            part[:, :, 2:] = numpy.transpose(values, (1, 0, 2)) * self._scale
+            offset += n_atoms * len(times)
+        return result
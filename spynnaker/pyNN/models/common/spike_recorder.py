@@ -1,6 +1,7 @@
 from spinn_machine.utilities.progress_bar import ProgressBar
 
 from spynnaker.pyNN.models.common import recording_utils
+from spynnaker.pyNN.utilities import spike_bits
 
 import math
 import numpy
@@ -42,14 +43,16 @@ class SpikeRecorder(object):
         return n_neurons * 4
 
     def get_spikes(self, label, buffer_manager, region, state_region,
-                   placements, graph_mapper, partitionable_vertex):
+                   placements, graph_mapper, partitionable_vertex,
+                   spike_file_path=None):
 
-        spike_times = list()
-        spike_ids = list()
         ms_per_tick = self._machine_time_step / 1000.0
+        gatherer = recording_utils.SpikeGatherer(spike_file_path)
 
-        subvertices = \
-            graph_mapper.get_subvertices_from_vertex(partitionable_vertex)
+        subvertices = sorted(
+            graph_mapper.get_subvertices_from_vertex(partitionable_vertex),
+            key=lambda subvertex:
+                graph_mapper.get_subvertex_slice(subvertex).lo_atom)
 
         missing_str = ""
 
@@ -67,7 +70,6 @@ class SpikeRecorder(object):
 
             # Read the spikes
             n_words = int(math.ceil(subvertex_slice.n_atoms / 32.0))
-            n_bytes = n_words * 4
             n_words_with_timestamp = n_words + 1
 
             # for buffering output info is taken form the buffer manager
@@ -78,18 +80,11 @@ class SpikeRecorder(object):
                 missing_str += "({}, {}, {}); ".format(x, y, p)
             record_raw = neuron_param_region_data_pointer.read_all()
             raw_data = (numpy.asarray(record_raw, dtype="uint8").
-                        view(dtype="<i4")).reshape(
+                        view(dtype="<u4")).reshape(
                 [-1, n_words_with_timestamp])
-            split_record = numpy.array_split(raw_data, [1, 1], 1)
-            record_time = split_record[0] * float(ms_per_tick)
-            spikes = split_record[2].byteswap().view("uint8")
-            bits = numpy.fliplr(numpy.unpackbits(spikes).reshape(
-                (-1, 32))).reshape((-1, n_bytes * 8))
-            time_indices, indices = numpy.where(bits == 1)
-            times = record_time[time_indices].reshape((-1))
-            indices = indices + lo_atom
-            spike_ids.append(indices)
-            spike_times.append(times)
+            time_indices, indices = spike_bits.decode_spikes(raw_data[:, 1:])
+            times = raw_data[time_indices, 0] * float(ms_per_tick)
+            gatherer.add_core(indices + lo_atom, times)
             progress_bar.update()
 
         progress_bar.end()
@@ -98,7 +93,4 @@ class SpikeRecorder(object):
                 "Population {} is missing spike data in region {} from the"
                 " following cores: {}".format(label, region, missing_str))
 
-        spike_ids = numpy.hstack(spike_ids)
-        spike_times = numpy.hstack(spike_times)
-        result = numpy.dstack((spike_ids, spike_times))[0]
-        return result[numpy.lexsort((spike_times, spike_ids))]
+        return gatherer.finish()
@@ -39,14 +39,17 @@ class VRecorder(object):
         return n_neurons * 4
 
     def get_v(self, label, buffer_manager, region, state_region, placements,
-              graph_mapper, partitionable_vertex):
+              graph_mapper, partitionable_vertex, store_directory=None):
 
-        subvertices = \
-            graph_mapper.get_subvertices_from_vertex(partitionable_vertex)
+        subvertices = sorted(
+            graph_mapper.get_subvertices_from_vertex(partitionable_vertex),
+            key=lambda subvertex:
+                graph_mapper.get_subvertex_slice(subvertex).lo_atom)
 
         ms_per_tick = self._machine_time_step / 1000.0
 
-        data = list()
+        gatherer = recording_utils.ValueGatherer(
+            1, 1.0 / 32767.0, store_directory)
         missing_str = ""
 
         progress_bar = \
@@ -69,23 +72,12 @@ class VRecorder(object):
             if missing_data:
                 missing_str += "({}, {}, {}); ".format(x, y, p)
             record_raw = neuron_param_region_data_pointer.read_all()
-            record_length = len(record_raw)
-            n_rows = record_length / ((vertex_slice.n_atoms + 1) * 4)
             record = (numpy.asarray(record_raw, dtype="uint8").
-                      view(dtype="<i4")).reshape((n_rows,
-                                                  (vertex_slice.n_atoms + 1)))
-            split_record = numpy.array_split(record, [1, 1], 1)
-            record_time = numpy.repeat(
-                split_record[0] * float(ms_per_tick), vertex_slice.n_atoms, 1)
-            record_ids = numpy.tile(
-                numpy.arange(vertex_slice.lo_atom, vertex_slice.hi_atom + 1),
-                len(record_time)).reshape((-1, vertex_slice.n_atoms))
-            record_membrane_potential = split_record[2] / 32767.0
-
-            part_data = numpy.dstack(
-                [record_ids, record_time, record_membrane_potential])
-            part_data = numpy.reshape(part_data, [-1, 3])
-            data.append(part_data)
+                      view(dtype="<i4")).reshape(
+                (-1, (vertex_slice.n_atoms + 1)))
+            gatherer.add_core(
+                vertex_slice.lo_atom, record[:, 0] * float(ms_per_tick),
+                record[:, 1:])
             progress_bar.update()
 
         progress_bar.end()
@@ -94,7 +86,4 @@ class VRecorder(object):
                 "Population {} is missing membrane voltage data in region {}"
                 " from the following cores: {}".format(
                     label, region, missing_str))
-        data = numpy.vstack(data)
-        order = numpy.lexsort((data[:, 1], data[:, 0]))
-        result = data[order]
-        return result
+        return gatherer.finish()
@@ -0,0 +1,117 @@
+from spinn_machine.utilities.progress_bar import ProgressBar
+
+from spynnaker.pyNN.utilities import weight_recording
+
+import math
+import numpy
+import logging
+logger = logging.getLogger(__name__)
+
+
+class WeightRecorder(object):
+    """ Records the changes to the weights of the plastic projections into a\
+        population; the cores flush the changes of all of the recorded\
+        projections at the shortest interval asked for
+    """
+
+    def __init__(self, machine_time_step):
+        self._interval_ticks = None
+        self._machine_time_step = machine_time_step
+
+    @property
+    def record_weights(self):
+        return self._interval_ticks is not None
+
+    @property
+    def interval_ticks(self):
+        """ The number of ticks between flushes, or 0 if no weights are\
+            recorded
+        """
+        if self._interval_ticks is None:
+            return 0
+        return self._interval_ticks
+
+    def add_interval(self, interval):
+        """ Ask for the weights to be flushed at least every interval\
+            milliseconds
+        """
+        interval_ticks = max(1, int(round(
+            (interval * 1000.0) / self._machine_time_step)))
+        if self._interval_ticks is None or \
+                interval_ticks < self._interval_ticks:
+            self._interval_ticks = interval_ticks
+
+    def get_sdram_usage_in_bytes(self, n_machine_time_steps):
+        if not self.record_weights:
+            return 0
+        if n_machine_time_steps is None:
+            raise Exception(
+                "Cannot record weights without a fixed run time")
+
+        # A buffer per interval, and one flushed at the end of the run
+        n_flushes = int(math.ceil(
+            float(n_machine_time_steps) / self._interval_ticks)) + 1
+        return n_flushes * weight_recording.BUFFER_BYTES
+
+    def get_sdram_usage_per_timestep_in_bytes(self):
+        if not self.record_weights:
+            return 0
+        return int(math.ceil(
+            float(weight_recording.BUFFER_BYTES) / self._interval_ticks))
+
+    def get_dtcm_usage_in_bytes(self):
+        if not self.record_weights:
+            return 0
+        return 2 * weight_recording.BUFFER_BYTES
+
+    def get_n_cpu_cycles(self):
+        if not self.record_weights:
+            return 0
+        return weight_recording.BUFFER_WORDS
+
+    def get_weight_history(
+            self, label, buffer_manager, region, state_region, placements,
+            graph_mapper, partitionable_vertex, synapse_info,
+            recorded_blocks):
+        """ Get the weight changes recorded for a projection
+
+        :param recorded_blocks: dict of placement to the RecordedBlock of\
+            each block that the core records
+        :return: numpy array of weight_recording.WEIGHT_HISTORY_DTYPE,\
+            sorted by time
+        """
+        subvertices = graph_mapper.get_subvertices_from_vertex(
+            partitionable_vertex)
+        ms_per_tick = self._machine_time_step / 1000.0
+        missing_str = ""
+        changes = list()
+
+        progress_bar = ProgressBar(
+            len(subvertices), "Getting weight changes for {}".format(label))
+        for subvertex in subvertices:
+            placement = placements.get_placement_of_subvertex(subvertex)
+            blocks = recorded_blocks.get(placement, [])
+            if not any(block.synapse_info is synapse_info
+                       for block in blocks):
+                progress_bar.update()
+                continue
+
+            data_pointer, missing_data = buffer_manager.get_data_for_vertex(
+                placement, region, state_region)
+            if missing_data:
+                missing_str += "({}, {}, {}); ".format(
+                    placement.x, placement.y, placement.p)
+            changes.append(weight_recording.read_weight_changes(
+                data_pointer.read_all(), blocks, synapse_info, ms_per_tick))
+            progress_bar.update()
+        progress_bar.end()
+
+        if len(missing_str) > 0:
+            logger.warn(
+                "Population {} is missing weight changes in region {} from"
+                " the following cores: {}".format(
+                    label, region, missing_str))
+        if len(changes) == 0:
+            return numpy.zeros(0, dtype=weight_recording.WEIGHT_HISTORY_DTYPE)
+        changes = numpy.concatenate(changes)
+        return changes[numpy.argsort(changes["time"], kind="mergesort")]
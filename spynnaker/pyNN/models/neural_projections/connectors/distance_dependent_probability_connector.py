@@ -4,6 +4,7 @@ from spynnaker.pyNN.utilities import utility_calls
 from spynnaker.pyNN.models.neural_projections.connectors.abstract_connector \
     import AbstractConnector
 
+import ast
 import logging
 import numpy
 import math
@@ -25,6 +26,71 @@ from numpy import tan, tanh, maximum, minimum, e, pi  # @UnusedImport
 
 logger = logging.getLogger(__name__)
 
+# The number of distances at which the expression is sampled to find the
+# maximum probability of connection
+_N_SUPPORT_SAMPLES = 10000
+
+
+def _get_constant(node):
+    """ Get the value of an expression that does not depend on d, or None if\
+        it depends on d or is not a number
+    """
+    for child in ast.walk(node):
+        if isinstance(child, ast.Name) and child.id == "d":
+            return None
+    expression = ast.fix_missing_locations(ast.Expression(body=node))
+    try:
+        return float(eval(
+            compile(expression, "<d_expression>", "eval"), globals()))
+    except Exception:
+        return None
+
+
+def _get_distance_bound(node):
+    """ Get a distance beyond which an expression of d is always zero, or\
+        None if there is no such distance or it cannot be shown to be one;\
+        this is only found from comparisons of d with a constant, combined\
+        by "*", "&", "+" and "|"
+    """
+    if isinstance(node, ast.Expression):
+        return _get_distance_bound(node.body)
+
+    if isinstance(node, ast.Compare) and len(node.ops) == 1:
+        left, op, right = node.left, node.ops[0], node.comparators[0]
+        if isinstance(left, ast.Name) and left.id == "d" and isinstance(
+                op, (ast.Lt, ast.LtE)):
+            return _get_constant(right)
+        if isinstance(right, ast.Name) and right.id == "d" and isinstance(
+                op, (ast.Gt, ast.GtE)):
+            return _get_constant(left)
+        return None
+
+    # A product is zero where any part is, a sum only where all parts are
+    if isinstance(node, ast.BinOp):
+        operands = [node.left, node.right]
+        if isinstance(node.op, (ast.Mult, ast.BitAnd)):
+            return _min_bound(operands)
+        if isinstance(node.op, (ast.Add, ast.BitOr)):
+            return _max_bound(operands)
+        return None
+    return None
+
+
+def _min_bound(nodes):
+    bounds = [
+        bound for bound in (_get_distance_bound(node) for node in nodes)
+        if bound is not None]
+    if len(bounds) == 0:
+        return None
+    return min(bounds)
+
+
+def _max_bound(nodes):
+    bounds = [_get_distance_bound(node) for node in nodes]
+    if any(bound is None for bound in bounds):
+        return None
+    return max(bounds)
+
 
 class DistanceDependentProbabilityConnector(AbstractConnector):
     """ Make connections using a distribution which varies with distance.
@@ -69,24 +135,110 @@ class DistanceDependentProbabilityConnector(AbstractConnector):
                 "n_connections is not implemented for"
                 " DistanceDependentProbabilityConnector on this platform")
 
-        # Get the probabilities up-front for now
-        # TODO: Work out how this can be done statistically
-        expand_distances = self._expand_distances(self._d_expression)
-        pre_positions = self._pre_population.positions
-        post_positions = self._post_population.positions
+        # Compile the expression once; it is evaluated for each pair of
+        # slices as they are needed rather than for all pairs up-front
+        self._d_code = compile(d_expression, "<d_expression>", "eval")
+        self._d_bound = _get_distance_bound(
+            ast.parse(d_expression, mode="eval"))
+        self._expand = self._expand_distances(d_expression)
+
+        # The distance beyond which the probability is zero, or None if not
+        # known, and the maximum probability over all distances
+        self._max_distance = None
+        self._max_prob = 1.0
+
+        # The maximum probability for each pair of slices, by atom range
+        self._slice_max_probs = dict()
+
+    def set_projection_information(
+            self, pre_population, post_population, rng, machine_time_step):
+        AbstractConnector.set_projection_information(
+            self, pre_population, post_population, rng, machine_time_step)
+        self._slice_max_probs = dict()
+        self._find_support()
+
+    def _evaluate(self, d, shape):
+        """ Evaluate the probability expression on the distances d, giving an\
+            array of the given shape
+        """
+        probs = numpy.asarray(
+            eval(self._d_code, globals(), {"d": d}), dtype="float64")
+        if probs.shape != shape:
+            probs = probs * numpy.ones(shape)
+        return probs
+
+    def _find_support(self):
+        """ Find the distance beyond which the probability of connection is\
+            zero, where the expression is bounded by comparisons of d with\
+            constants, and the maximum probability, by sampling the\
+            expression over the range of distances between the populations.\
+            This is only possible where the expression depends on the\
+            overall distance and the space has no periodic boundaries; the\
+            distance is never found from the samples, as a narrow range of\
+            distances with a non-zero probability could fall between them.
+        """
+        self._max_distance = None
+        self._max_prob = 1.0
+        if self._expand or self._space.periodic_boundaries is not None:
+            return
+        self._max_distance = self._d_bound
+
+        axes = self._space.axes
+        pre_positions = self._pre_population.positions[axes]
+        post_positions = self._post_population.positions[axes]
+        furthest = numpy.maximum(
+            numpy.amax(pre_positions, axis=1) -
+            numpy.amin(post_positions, axis=1),
+            numpy.amax(post_positions, axis=1) -
+            numpy.amin(pre_positions, axis=1))
+        samples = numpy.linspace(
+            0.0, math.sqrt(numpy.sum(furthest ** 2)), _N_SUPPORT_SAMPLES)
+        probs = self._evaluate(samples, samples.shape)
+        self._max_prob = min(1.0, float(numpy.amax(probs)))
+
+    def _get_probs(self, pre_vertex_slice, post_vertex_slice):
+        """ Get the matrix of probabilities of connection from the neurons of\
+            pre_vertex_slice to those of post_vertex_slice, or None if the\
+            slices are too far apart for any to connect
+        """
+        pre_positions = self._pre_population.positions[
+            :, pre_vertex_slice.as_slice]
+        post_positions = self._post_population.positions[
+            :, post_vertex_slice.as_slice]
+
+        # Skip the slices if the bounding boxes of their positions are
+        # further apart than the support of the expression
+        if self._max_distance is not None:
+            axes = self._space.axes
+            gap = numpy.maximum(0.0, numpy.maximum(
+                numpy.amin(pre_positions[axes], axis=1) -
+                numpy.amax(post_positions[axes], axis=1),
+                numpy.amin(post_positions[axes], axis=1) -
+                numpy.amax(pre_positions[axes], axis=1)))
+            if math.sqrt(numpy.sum(gap ** 2)) > self._max_distance:
+                return None
+
+        d = self._space.distances(pre_positions, post_positions, self._expand)
+        return self._evaluate(
+            d, (pre_vertex_slice.n_atoms, post_vertex_slice.n_atoms))
 
-        # d is apparently unused, but is in fact expected by d_expression
-        # so is used when eval is called
-        d = self._space.distances(  # @UnusedVariable
-            pre_positions, post_positions, expand_distances)
-        self._probs = eval(self._d_expression)
+    def _get_max_prob(self, pre_vertex_slice, post_vertex_slice):
+        key = (pre_vertex_slice.lo_atom, pre_vertex_slice.hi_atom,
+               post_vertex_slice.lo_atom, post_vertex_slice.hi_atom)
+        if key not in self._slice_max_probs:
+            probs = self._get_probs(pre_vertex_slice, post_vertex_slice)
+            max_prob = 0.0
+            if probs is not None:
+                max_prob = min(1.0, float(numpy.amax(probs)))
+            self._slice_max_probs[key] = max_prob
+        return self._slice_max_probs[key]
 
     def get_delay_maximum(self):
         return self._get_delay_maximum(
             self._delays, utility_calls.get_probable_maximum_selected(
                 self._n_pre_neurons * self._n_post_neurons,
                 self._n_pre_neurons * self._n_post_neurons,
-                numpy.amax(self._probs)))
+                self._max_prob))
 
     def get_delay_variance(
             self, pre_slices, pre_slice_index, post_slices,
@@ -94,8 +246,7 @@ class DistanceDependentProbabilityConnector(AbstractConnector):
         return self._get_delay_variance(self._delays, None)
 
     def _get_n_connections(self, out_of, pre_vertex_slice, post_vertex_slice):
-        max_prob = numpy.amax(
-            self._probs[pre_vertex_slice.as_slice, post_vertex_slice.as_slice])
+        max_prob = self._get_max_prob(pre_vertex_slice, post_vertex_slice)
         return utility_calls.get_probable_maximum_selected(
             self._n_pre_neurons * self._n_post_neurons, out_of,
             max_prob)
@@ -147,18 +298,29 @@ class DistanceDependentProbabilityConnector(AbstractConnector):
             post_slice_index, pre_vertex_slice, post_vertex_slice,
             synapse_type):
 
-        probs = self._probs[
-            pre_slice_index.to_slice, post_slice_index.to_slice]
+        probs = self._get_probs(pre_vertex_slice, post_vertex_slice)
+        if probs is None:
+            return numpy.zeros(
+                0, dtype=AbstractConnector.NUMPY_SYNAPSES_DTYPE)
         n_items = pre_vertex_slice.n_atoms * post_vertex_slice.n_atoms
-        items = self._rng.next(n_items)
+        items = numpy.reshape(
+            self._rng.next(n_items),
+            (pre_vertex_slice.n_atoms, post_vertex_slice.n_atoms))
 
         # If self connections are not allowed, remove possibility the self
-        # connections by setting them to a value of infinity
-        if not self._allow_self_connections:
-            items[0:n_items:post_vertex_slice.n_atoms + 1] = numpy.inf
+        # connections by setting them to a value of infinity; only a
+        # projection from a population to itself has self connections
+        if (not self._allow_self_connections and
+                self._pre_population is self._post_population):
+            lo_atom = max(pre_vertex_slice.lo_atom, post_vertex_slice.lo_atom)
+            hi_atom = min(pre_vertex_slice.hi_atom, post_vertex_slice.hi_atom)
+            if lo_atom <= hi_atom:
+                atoms = numpy.arange(lo_atom, hi_atom + 1)
+                items[atoms - pre_vertex_slice.lo_atom,
+                      atoms - post_vertex_slice.lo_atom] = numpy.inf
 
         present = items < probs
-        ids = numpy.where(present)[0]
+        ids = numpy.flatnonzero(present)
         n_connections = numpy.sum(present)
 
         block = numpy.zeros(
@@ -15,6 +15,10 @@ class DelayedPartitionableEdge(MultiCastPartitionableEdge):
     def add_synapse_information(self, synapse_information):
         self._synapse_information.append(synapse_information)
 
+    @property
+    def synapse_information(self):
+        return self._synapse_information
+
     def create_subedge(self, pre_subvertex, post_subvertex, label=None):
         return DelayedPartitionedEdge(
             self._synapse_information, pre_subvertex, post_subvertex, label)
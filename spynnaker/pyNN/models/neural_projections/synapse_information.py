@@ -9,6 +9,8 @@ class SynapseInformation(object):
         self._synapse_dynamics = synapse_dynamics
         self._synapse_type = synapse_type
         self._index = 0
+        self._input_priority = 0
+        self._record_weights = False
 
     @property
     def connector(self):
@@ -29,3 +31,26 @@ class SynapseInformation(object):
     @index.setter
     def index(self, index):
         self._index = index
+
+    @property
+    def input_priority(self):
+        """ The priority of the spikes of the projection in the input buffer\
+            of the post-synaptic cores when the buffer fills and the overflow\
+            policy is priority; higher is more important
+        """
+        return self._input_priority
+
+    @input_priority.setter
+    def input_priority(self, input_priority):
+        self._input_priority = input_priority
+
+    @property
+    def record_weights(self):
+        """ True if the post-synaptic cores record the changes to the\
+            weights of the projection while the simulation runs
+        """
+        return self._record_weights
+
+    @record_weights.setter
+    def record_weights(self, record_weights):
+        self._record_weights = record_weights
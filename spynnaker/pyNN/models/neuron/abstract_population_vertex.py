@@ -40,6 +40,7 @@ from spynnaker.pyNN.models.common.abstract_gsyn_recordable \
 from spynnaker.pyNN.models.common.spike_recorder import SpikeRecorder
 from spynnaker.pyNN.models.common.v_recorder import VRecorder
 from spynnaker.pyNN.models.common.gsyn_recorder import GsynRecorder
+from spynnaker.pyNN.models.common.weight_recorder import WeightRecorder
 from spynnaker.pyNN.utilities import constants
 from spynnaker.pyNN.utilities.conf import config
 from spynnaker.pyNN.models.neuron.population_partitioned_vertex \
@@ -52,6 +53,7 @@ from data_specification.data_specification_generator \
 from abc import ABCMeta
 from six import add_metaclass
 import logging
+import math
 import os
 
 logger = logging.getLogger(__name__)
@@ -67,6 +69,9 @@ _C_MAIN_BASE_DTCM_USAGE_IN_BYTES = 12
 _C_MAIN_BASE_SDRAM_USAGE_IN_BYTES = 72
 _C_MAIN_BASE_N_CPU_CYCLES = 0
 
+# The number of words in the neuron parameters before the global parameters
+_N_NEURON_PARAMS_HEADER_WORDS = 5
+
 
 @add_metaclass(ABCMeta)
 class AbstractPopulationVertex(
@@ -103,11 +108,6 @@ class AbstractPopulationVertex(
         self._label = label
         self._machine_time_step = machine_time_step
         self._timescale_factor = timescale_factor
-        self._incoming_spike_buffer_size = incoming_spike_buffer_size
-        if incoming_spike_buffer_size is None:
-            self._incoming_spike_buffer_size = config.getint(
-                "Simulation", "incoming_spike_buffer_size")
-
         self._model_name = model_name
         self._neuron_model = neuron_model
         self._input_type = input_type
@@ -118,12 +118,15 @@ class AbstractPopulationVertex(
         self._spike_recorder = SpikeRecorder(machine_time_step)
         self._v_recorder = VRecorder(machine_time_step)
         self._gsyn_recorder = GsynRecorder(machine_time_step)
+        self._weight_recorder = WeightRecorder(machine_time_step)
         self._spike_buffer_max_size = config.getint(
             "Buffers", "spike_buffer_size")
         self._v_buffer_max_size = config.getint(
             "Buffers", "v_buffer_size")
         self._gsyn_buffer_max_size = config.getint(
             "Buffers", "gsyn_buffer_size")
+        self._weight_buffer_max_size = config.getint(
+            "Buffers", "weight_buffer_size")
         self._buffer_size_before_receive = config.getint(
             "Buffers", "buffer_size_before_receive")
         self._time_between_requests = config.getint(
@@ -142,7 +145,8 @@ class AbstractPopulationVertex(
         # Set up synapse handling
         self._synapse_manager = SynapticManager(
             synapse_type, machine_time_step, ring_buffer_sigma,
-            spikes_per_second)
+            spikes_per_second,
+            incoming_spike_buffer_size=incoming_spike_buffer_size)
 
         # bool for if state has changed.
         self._change_requires_mapping = True
@@ -160,7 +164,8 @@ class AbstractPopulationVertex(
 
         is_recording = (
             self._gsyn_recorder.record_gsyn or self._v_recorder.record_v or
-            self._spike_recorder.record
+            self._spike_recorder.record or
+            self._weight_recorder.record_weights
         )
         subvertex = PopulationPartitionedVertex(
             resources_required, label, is_recording, constraints)
@@ -180,8 +185,13 @@ class AbstractPopulationVertex(
             gsyn_buffering_needed = recording_utils.needs_buffering(
                 self._gsyn_buffer_max_size, gsyn_buffer_size,
                 self._enable_buffered_recording)
+            weight_buffering_needed = recording_utils.needs_buffering(
+                self._weight_buffer_max_size,
+                self._weight_recorder.get_sdram_usage_in_bytes(
+                    self._no_machine_time_steps),
+                self._enable_buffered_recording)
             if (spike_buffering_needed or v_buffering_needed or
-                    gsyn_buffering_needed):
+                    gsyn_buffering_needed or weight_buffering_needed):
                 subvertex.activate_buffering_output(
                     buffering_ip_address=self._receive_buffer_host,
                     buffering_port=self._receive_buffer_port)
@@ -193,6 +203,8 @@ class AbstractPopulationVertex(
                 vertex_slice.n_atoms, 1)
             sdram_per_ts += self._gsyn_recorder.get_sdram_usage_in_bytes(
                 vertex_slice.n_atoms, 1)
+            sdram_per_ts += \
+                self._weight_recorder.get_sdram_usage_per_timestep_in_bytes()
             subvertex.activate_buffering_output(
                 minimum_sdram_for_buffering=self._minimum_buffer_sdram,
                 buffered_sdram_per_timestep=sdram_per_ts)
@@ -219,7 +231,9 @@ class AbstractPopulationVertex(
                 self._spike_recorder.get_n_cpu_cycles(vertex_slice.n_atoms) +
                 self._v_recorder.get_n_cpu_cycles(vertex_slice.n_atoms) +
                 self._gsyn_recorder.get_n_cpu_cycles(vertex_slice.n_atoms) +
-                self._synapse_manager.get_n_cpu_cycles(vertex_slice, graph))
+                self._weight_recorder.get_n_cpu_cycles() +
+                self._synapse_manager.get_n_cpu_cycles(
+                    vertex_slice, graph.incoming_edges_to_vertex(self)))
 
     # @implements AbstractPopulationVertex.get_dtcm_usage_for_atoms
     def get_dtcm_usage_for_atoms(self, vertex_slice, graph):
@@ -232,11 +246,27 @@ class AbstractPopulationVertex(
                 self._additional_input.get_dtcm_usage_per_neuron_in_bytes()
         return (_NEURON_BASE_DTCM_USAGE_IN_BYTES +
                 (per_neuron_usage * vertex_slice.n_atoms) +
+                self._get_dtcm_usage_for_neuron_buffers(vertex_slice) +
                 self._spike_recorder.get_dtcm_usage_in_bytes() +
                 self._v_recorder.get_dtcm_usage_in_bytes() +
                 self._gsyn_recorder.get_dtcm_usage_in_bytes() +
+                self._weight_recorder.get_dtcm_usage_in_bytes() +
                 self._synapse_manager.get_dtcm_usage_in_bytes(
-                    vertex_slice, graph))
+                    vertex_slice, graph.incoming_edges_to_vertex(self)))
+
+    @staticmethod
+    def _get_dtcm_usage_for_neuron_buffers(vertex_slice):
+        """ Get the DTCM used by the buffers that neuron.c allocates for every\
+            neuron whether or not it is recording: the voltage and input\
+            recording buffers, the outgoing spike queue and the spike bit\
+            field
+        """
+        n_atoms = vertex_slice.n_atoms
+        return (
+            (4 + (constants.V_BUFFER_SIZE_PER_TICK_PER_NEURON * n_atoms)) +
+            (4 + (constants.GSYN_BUFFER_SIZE_PER_TICK_PER_NEURON * n_atoms)) +
+            (4 * n_atoms) +
+            (4 + (int(math.ceil(n_atoms / 32.0)) * 4)))
 
     def _get_sdram_usage_for_neuron_params(self, vertex_slice):
         per_neuron_usage = (
@@ -246,16 +276,20 @@ class AbstractPopulationVertex(
             per_neuron_usage += \
                 self._additional_input.get_sdram_usage_per_neuron_in_bytes()
         return ((common_constants.DATA_SPECABLE_BASIC_SETUP_INFO_N_WORDS * 4) +
-                ReceiveBuffersToHostBasicImpl.get_recording_data_size(3) +
+                (_N_NEURON_PARAMS_HEADER_WORDS * 4) +
+                ReceiveBuffersToHostBasicImpl.get_recording_data_size(4) +
                 (per_neuron_usage * vertex_slice.n_atoms) +
                 self._neuron_model.get_sdram_usage_in_bytes(
                     vertex_slice.n_atoms))
 
-    # @implements AbstractPartitionableVertex.get_sdram_usage_for_atoms
-    def get_sdram_usage_for_atoms(self, vertex_slice, graph):
-        sdram_requirement = (
+    def get_sdram_usage_for_atoms_without_recording(
+            self, vertex_slice, graph):
+        """ Get the SDRAM usage of the atoms apart from the recording\
+            buffers, which can only be sized once the run time is known
+        """
+        return (
             self._get_sdram_usage_for_neuron_params(vertex_slice) +
-            ReceiveBuffersToHostBasicImpl.get_buffer_state_region_size(3) +
+            ReceiveBuffersToHostBasicImpl.get_buffer_state_region_size(4) +
             PopulationPartitionedVertex.get_provenance_data_size(
                 PopulationPartitionedVertex
                 .N_ADDITIONAL_PROVENANCE_DATA_ITEMS) +
@@ -265,6 +299,11 @@ class AbstractPopulationVertex(
                 vertex_slice, graph.incoming_edges_to_vertex(self)) *
              common_constants.SARK_PER_MALLOC_SDRAM_USAGE))
 
+    # @implements AbstractPartitionableVertex.get_sdram_usage_for_atoms
+    def get_sdram_usage_for_atoms(self, vertex_slice, graph):
+        sdram_requirement = self.get_sdram_usage_for_atoms_without_recording(
+            vertex_slice, graph)
+
         # add recording SDRAM if not automatically calculated
         if not self._using_auto_pause_and_resume:
             spike_buffer_size = self._spike_recorder.get_sdram_usage_in_bytes(
@@ -282,6 +321,11 @@ class AbstractPopulationVertex(
             sdram_requirement += recording_utils.get_buffer_sizes(
                 self._gsyn_buffer_max_size, gsyn_buffer_size,
                 self._enable_buffered_recording)
+            sdram_requirement += recording_utils.get_buffer_sizes(
+                self._weight_buffer_max_size,
+                self._weight_recorder.get_sdram_usage_in_bytes(
+                    self._no_machine_time_steps),
+                self._enable_buffered_recording)
         else:
             sdram_requirement += self._minimum_buffer_sdram
 
@@ -299,6 +343,8 @@ class AbstractPopulationVertex(
             extra_mallocs += 1
         if self._spike_recorder.record:
             extra_mallocs += 1
+        if self._weight_recorder.record_weights:
+            extra_mallocs += 1
         return (
             2 + self._synapse_manager.get_number_of_mallocs_used_by_dsg() +
             extra_mallocs)
@@ -310,7 +356,8 @@ class AbstractPopulationVertex(
 
     def _reserve_memory_regions(
             self, spec, vertex_slice, spike_history_region_sz,
-            v_history_region_sz, gsyn_history_region_sz, subvertex):
+            v_history_region_sz, gsyn_history_region_sz,
+            weight_history_region_sz, subvertex):
 
         spec.comment("\nReserving memory space for data regions:\n\n")
 
@@ -319,7 +366,7 @@ class AbstractPopulationVertex(
             region=constants.POPULATION_BASED_REGIONS.SYSTEM.value,
             size=((
                 common_constants.DATA_SPECABLE_BASIC_SETUP_INFO_N_WORDS * 4) +
-                subvertex.get_recording_data_size(3)), label='System')
+                subvertex.get_recording_data_size(4)), label='System')
 
         spec.reserve_memory_region(
             region=constants.POPULATION_BASED_REGIONS.NEURON_PARAMS.value,
@@ -331,16 +378,17 @@ class AbstractPopulationVertex(
             constants.POPULATION_BASED_REGIONS.BUFFERING_OUT_STATE.value,
             [constants.POPULATION_BASED_REGIONS.SPIKE_HISTORY.value,
              constants.POPULATION_BASED_REGIONS.POTENTIAL_HISTORY.value,
-             constants.POPULATION_BASED_REGIONS.GSYN_HISTORY.value],
+             constants.POPULATION_BASED_REGIONS.GSYN_HISTORY.value,
+             constants.POPULATION_BASED_REGIONS.WEIGHT_HISTORY.value],
             [spike_history_region_sz, v_history_region_sz,
-             gsyn_history_region_sz])
+             gsyn_history_region_sz, weight_history_region_sz])
 
         subvertex.reserve_provenance_data_region(spec)
 
     def _write_setup_info(
             self, spec, spike_history_region_sz, neuron_potential_region_sz,
-            gsyn_region_sz, ip_tags, buffer_size_before_receive,
-            time_between_requests, subvertex):
+            gsyn_region_sz, weight_region_sz, ip_tags,
+            buffer_size_before_receive, time_between_requests, subvertex):
         """ Write information used to control the simulation and gathering of\
             results.
         """
@@ -351,11 +399,11 @@ class AbstractPopulationVertex(
         subvertex.write_recording_data(
             spec, ip_tags,
             [spike_history_region_sz, neuron_potential_region_sz,
-             gsyn_region_sz], buffer_size_before_receive,
+             gsyn_region_sz, weight_region_sz], buffer_size_before_receive,
             time_between_requests)
 
     def _write_neuron_parameters(
-            self, spec, key, vertex_slice):
+            self, spec, key, vertex_slice, incoming_spike_buffer_size):
 
         n_atoms = (vertex_slice.hi_atom - vertex_slice.lo_atom) + 1
         spec.comment("\nWriting Neuron Parameters for {} Neurons:\n".format(
@@ -378,7 +426,14 @@ class AbstractPopulationVertex(
         spec.write_value(data=n_atoms)
 
         # Write the size of the incoming spike buffer
-        spec.write_value(data=self._incoming_spike_buffer_size)
+        spec.write_value(data=incoming_spike_buffer_size)
+
+        # Write the number of microseconds between sending spikes, spreading
+        # a spike from every neuron over half of the timestep
+        time_between_spikes = (
+            (self._machine_time_step * self._timescale_factor) /
+            (n_atoms * 2.0))
+        spec.write_value(data=int(time_between_spikes))
 
         # Write the global parameters
         global_params = self._neuron_model.get_global_parameters()
@@ -430,6 +485,8 @@ class AbstractPopulationVertex(
             vertex_slice.n_atoms, self._no_machine_time_steps)
         gsyn_buffer_size = self._gsyn_recorder.get_sdram_usage_in_bytes(
             vertex_slice.n_atoms, self._no_machine_time_steps)
+        weight_buffer_size = self._weight_recorder.get_sdram_usage_in_bytes(
+            self._no_machine_time_steps)
         spike_history_sz = recording_utils.get_buffer_sizes(
             self._spike_buffer_max_size, spike_buffer_size,
             self._enable_buffered_recording)
@@ -439,6 +496,9 @@ class AbstractPopulationVertex(
         gsyn_history_sz = recording_utils.get_buffer_sizes(
             self._gsyn_buffer_max_size, gsyn_buffer_size,
             self._enable_buffered_recording)
+        weight_history_sz = recording_utils.get_buffer_sizes(
+            self._weight_buffer_max_size, weight_buffer_size,
+            self._enable_buffered_recording)
         spike_buffering_needed = recording_utils.needs_buffering(
             self._spike_buffer_max_size, spike_buffer_size,
             self._enable_buffered_recording)
@@ -448,16 +508,20 @@ class AbstractPopulationVertex(
         gsyn_buffering_needed = recording_utils.needs_buffering(
             self._gsyn_buffer_max_size, gsyn_buffer_size,
             self._enable_buffered_recording)
+        weight_buffering_needed = recording_utils.needs_buffering(
+            self._weight_buffer_max_size, weight_buffer_size,
+            self._enable_buffered_recording)
         buffer_size_before_receive = self._buffer_size_before_receive
         if (not spike_buffering_needed and not v_buffering_needed and
-                not gsyn_buffering_needed):
+                not gsyn_buffering_needed and not weight_buffering_needed):
             buffer_size_before_receive = max((
-                spike_history_sz, v_history_sz, gsyn_history_sz)) + 256
+                spike_history_sz, v_history_sz, gsyn_history_sz,
+                weight_history_sz)) + 256
 
         # Reserve memory regions
         self._reserve_memory_regions(
             spec, vertex_slice, spike_history_sz, v_history_sz,
-            gsyn_history_sz, subvertex)
+            gsyn_history_sz, weight_history_sz, subvertex)
 
         # Declare random number generators and distributions:
         # TODO add random distribution stuff
@@ -479,14 +543,19 @@ class AbstractPopulationVertex(
 
         # Write the regions
         self._write_setup_info(
-            spec, spike_history_sz, v_history_sz, gsyn_history_sz, ip_tags,
-            buffer_size_before_receive, self._time_between_requests, subvertex)
-        self._write_neuron_parameters(spec, key, vertex_slice)
+            spec, spike_history_sz, v_history_sz, gsyn_history_sz,
+            weight_history_sz, ip_tags, buffer_size_before_receive,
+            self._time_between_requests, subvertex)
+        self._write_neuron_parameters(
+            spec, key, vertex_slice,
+            self._synapse_manager.get_incoming_spike_buffer_size(
+                vertex_slice, graph.incoming_edges_to_vertex(self)))
 
         # allow the synaptic matrix to write its data spec-able data
         self._synapse_manager.write_data_spec(
             spec, self, vertex_slice, subvertex, placement, partitioned_graph,
-            graph, routing_info, graph_mapper, self._input_type)
+            graph, routing_info, graph_mapper, self._input_type,
+            self._weight_recorder.interval_ticks)
 
         # End the writing of this specification:
         spec.end_specification()
@@ -514,12 +583,13 @@ class AbstractPopulationVertex(
         self._spike_recorder.record = True
 
     # @implements AbstractSpikeRecordable.get_spikes
-    def get_spikes(self, placements, graph_mapper, buffer_manager):
+    def get_spikes(self, placements, graph_mapper, buffer_manager,
+                   spike_file_path=None):
         return self._spike_recorder.get_spikes(
             self._label, buffer_manager,
             constants.POPULATION_BASED_REGIONS.SPIKE_HISTORY.value,
             constants.POPULATION_BASED_REGIONS.BUFFERING_OUT_STATE.value,
-            placements, graph_mapper, self)
+            placements, graph_mapper, self, spike_file_path)
 
     # @implements AbstractVRecordable.is_recording_v
     def is_recording_v(self):
@@ -532,12 +602,12 @@ class AbstractPopulationVertex(
 
     # @implements AbstractVRecordable.get_v
     def get_v(self, n_machine_time_steps, placements, graph_mapper,
-              buffer_manager):
+              buffer_manager, store_directory=None):
         return self._v_recorder.get_v(
             self._label, buffer_manager,
             constants.POPULATION_BASED_REGIONS.POTENTIAL_HISTORY.value,
             constants.POPULATION_BASED_REGIONS.BUFFERING_OUT_STATE.value,
-            placements, graph_mapper, self)
+            placements, graph_mapper, self, store_directory)
 
     # @implements AbstractGSynRecordable.is_recording_gsyn
     def is_recording_gsyn(self):
@@ -550,12 +620,35 @@ class AbstractPopulationVertex(
 
     # @implements AbstractGSynRecordable.get_gsyn
     def get_gsyn(self, n_machine_time_steps, placements, graph_mapper,
-                 buffer_manager):
+                 buffer_manager, store_directory=None):
         return self._gsyn_recorder.get_gsyn(
             self._label, buffer_manager,
             constants.POPULATION_BASED_REGIONS.GSYN_HISTORY.value,
             constants.POPULATION_BASED_REGIONS.BUFFERING_OUT_STATE.value,
-            placements, graph_mapper, self)
+            placements, graph_mapper, self, store_directory)
+
+    def is_recording_weights(self):
+        return self._weight_recorder.record_weights
+
+    def set_recording_weights(self, interval):
+        """ Record the weight changes of the projections into the population\
+            that ask for it, flushing them at least every interval\
+            milliseconds
+        """
+        self._change_requires_mapping = True
+        self._weight_recorder.add_interval(interval)
+
+    def get_weight_history(
+            self, synapse_info, placements, graph_mapper, buffer_manager):
+        """ Get the weight changes recorded for a projection into the\
+            population
+        """
+        return self._weight_recorder.get_weight_history(
+            self._label, buffer_manager,
+            constants.POPULATION_BASED_REGIONS.WEIGHT_HISTORY.value,
+            constants.POPULATION_BASED_REGIONS.BUFFERING_OUT_STATE.value,
+            placements, graph_mapper, self, synapse_info,
+            self._synapse_manager.weight_recording_blocks)
 
     def initialize(self, variable, value):
         initialize_attr = getattr(
@@ -632,11 +725,16 @@ class AbstractPopulationVertex(
             connection_holder, edge, synapse_info)
 
     def get_connections_from_machine(
-            self, transceiver, placement, subedge, graph_mapper,
-            routing_infos, synapse_info, partitioned_graph):
+            self, transceiver, placements, subedges, graph_mapper,
+            routing_infos, synapse_info, partitioned_graph, data_to_get,
+            progress_bar):
         return self._synapse_manager.get_connections_from_machine(
-            transceiver, placement, subedge, graph_mapper,
-            routing_infos, synapse_info, partitioned_graph)
+            transceiver, placements, subedges, graph_mapper,
+            routing_infos, synapse_info, partitioned_graph, data_to_get,
+            progress_bar)
+
+    def clear_connection_cache(self, remapped):
+        self._synapse_manager.clear_connection_cache(remapped)
 
     def is_data_specable(self):
         return True
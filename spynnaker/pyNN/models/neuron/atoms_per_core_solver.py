@@ -0,0 +1,158 @@
+from pacman.model.graph_mapper.slice import Slice
+from pacman.model.constraints.partitioner_constraints\
+    .partitioner_maximum_size_constraint \
+    import PartitionerMaximumSizeConstraint
+
+import logging
+
+logger = logging.getLogger(__name__)
+
+# The DTCM of a core, less that used by the stack and the spin1 API
+_DTCM_BYTES = (64 - 8) * 1024
+
+# The SDRAM of a chip left after the system allocations
+_DEFAULT_SDRAM_BYTES = 117 * 1024 * 1024
+
+# The clock speed of a core in MHz, i.e. the cycles per microsecond
+_CPU_CLOCK_MHZ = 200
+
+# The names of the limits on the number of atoms per core
+DTCM = "DTCM"
+SDRAM = "SDRAM"
+CPU = "CPU"
+MODEL_MAXIMUM = "model maximum"
+POPULATION_SIZE = "population size"
+
+
+class AtomsPerCoreSolution(object):
+    """ The number of atoms per core chosen for a vertex and why
+    """
+
+    __slots__ = [
+        "_vertex", "_max_atoms_per_core", "_binding_resource", "_usage"]
+
+    def __init__(self, vertex, max_atoms_per_core, binding_resource, usage):
+        self._vertex = vertex
+        self._max_atoms_per_core = max_atoms_per_core
+        self._binding_resource = binding_resource
+        self._usage = usage
+
+    @property
+    def vertex(self):
+        return self._vertex
+
+    @property
+    def max_atoms_per_core(self):
+        return self._max_atoms_per_core
+
+    @property
+    def binding_resource(self):
+        """ The limit that stops more atoms fitting on a core; one of DTCM,\
+            SDRAM, CPU, MODEL_MAXIMUM or POPULATION_SIZE
+        """
+        return self._binding_resource
+
+    @property
+    def usage(self):
+        """ dict of DTCM, SDRAM and CPU to the estimated usage of a core with\
+            max_atoms_per_core atoms
+        """
+        return self._usage
+
+
+class AtomsPerCoreSolver(object):
+    """ Chooses the largest number of atoms per core of population vertices\
+        for which the estimated DTCM, SDRAM (apart from recording) and CPU\
+        cycles per timestep of a core fit within the budget of the core
+    """
+
+    def __init__(
+            self, machine_time_step, timescale_factor, cpu_fraction,
+            sdram_bytes=None):
+        """
+
+        :param machine_time_step: The timestep in microseconds
+        :param timescale_factor: The slow down of the simulation
+        :param cpu_fraction: The fraction of each timestep a core may use
+        :param sdram_bytes: The SDRAM available on a chip, or None for the\
+            default
+        """
+        self._budget = {
+            DTCM: _DTCM_BYTES,
+            SDRAM: sdram_bytes if sdram_bytes is not None
+            else _DEFAULT_SDRAM_BYTES,
+            CPU: int(machine_time_step * timescale_factor * _CPU_CLOCK_MHZ *
+                     cpu_fraction)}
+
+    @property
+    def budget(self):
+        """ dict of DTCM, SDRAM and CPU to the amount available to a core
+        """
+        return self._budget
+
+    def _get_usage(self, vertex, graph, n_atoms):
+        vertex_slice = Slice(0, n_atoms - 1)
+        return {
+            DTCM: vertex.get_dtcm_usage_for_atoms(vertex_slice, graph),
+            SDRAM: vertex.get_sdram_usage_for_atoms_without_recording(
+                vertex_slice, graph),
+            CPU: vertex.get_cpu_usage_for_atoms(vertex_slice, graph)}
+
+    def _get_exceeded_resource(self, usage):
+        for resource in (DTCM, SDRAM, CPU):
+            if usage[resource] > self._budget[resource]:
+                return resource
+        return None
+
+    def solve(self, vertex, graph):
+        """ Find the largest number of atoms of the vertex that fit on a core
+
+        :param vertex: The population vertex
+        :param graph: The partitionable graph containing the vertex
+        :rtype: :py:class:`AtomsPerCoreSolution`
+        """
+        model_maximum = vertex.get_max_atoms_per_core()
+        upper = min(vertex.n_atoms, model_maximum)
+        upper_usage = self._get_usage(vertex, graph, upper)
+        if self._get_exceeded_resource(upper_usage) is None:
+            limit = MODEL_MAXIMUM
+            if vertex.n_atoms <= model_maximum:
+                limit = POPULATION_SIZE
+            return AtomsPerCoreSolution(vertex, upper, limit, upper_usage)
+
+        # The usage grows with the number of atoms, so binary search for the
+        # largest number that fits; lower always fits unless it is 1
+        lower = 1
+        lower_usage = self._get_usage(vertex, graph, lower)
+        binding = self._get_exceeded_resource(lower_usage)
+        if binding is not None:
+            logger.warn(
+                "A single atom of {} is estimated to need more {} than a core"
+                " has".format(vertex.label, binding))
+            return AtomsPerCoreSolution(vertex, lower, binding, lower_usage)
+        binding = self._get_exceeded_resource(upper_usage)
+        while upper - lower > 1:
+            middle = (lower + upper) // 2
+            middle_usage = self._get_usage(vertex, graph, middle)
+            exceeded = self._get_exceeded_resource(middle_usage)
+            if exceeded is None:
+                lower, lower_usage = middle, middle_usage
+            else:
+                upper, binding = middle, exceeded
+        return AtomsPerCoreSolution(vertex, lower, binding, lower_usage)
+
+    def apply(self, vertices, graph):
+        """ Solve each vertex and constrain the partitioner to the solution\
+            where it is smaller than both the model maximum and the vertex
+
+        :return: list of :py:class:`AtomsPerCoreSolution`
+        """
+        solutions = list()
+        for vertex in vertices:
+            solution = self.solve(vertex, graph)
+            if solution.max_atoms_per_core < min(
+                    vertex.n_atoms, vertex.get_max_atoms_per_core()):
+                vertex.add_constraint(PartitionerMaximumSizeConstraint(
+                    solution.max_atoms_per_core))
+            solutions.append(solution)
+        return solutions
@@ -16,28 +16,135 @@ def float_to_fixed(value, fixed_point_one):
     return int(round(float(value) * float(fixed_point_one)))
 
 
-def write_exp_lut(spec, time_constant, size, shift,
-                  fixed_point_one=STDP_FIXED_POINT_ONE):
-    # Calculate time constant reciprocal
+# The fixed point of the entries of the composed exponential decay tables, so
+# that the product of two entries fits in a 32-bit integer
+EXP_DECAY_FIXED_POINT_ONE = (1 << 14)
+
+# The largest fine and coarse tables of a composed exponential decay
+MAX_EXP_DECAY_FINE_SIZE = 256
+MAX_EXP_DECAY_COARSE_SIZE = 64
+
+# The fine shift, fine size and coarse size words before the tables
+_EXP_DECAY_HEADER_WORDS = 3
+
+
+def get_exp_decay_lut_shape(time_constant,
+                            fixed_point_one=STDP_FIXED_POINT_ONE):
+    """ Choose the tables of a composed exponential decay, as read by\
+        exp_decay.h, for a time constant in time steps.  The fine table\
+        covers times up to its size, and the coarse table steps of that,\
+        up to the time at which the decay rounds to zero; only if that\
+        would need too many coarse entries is the fine table made coarser.
+
+    :return: a tuple of (fine shift, fine size, coarse size), where the\
+        coarse size includes the last entry of zero
+    """
+    zero_time = float(time_constant) * math.log(2.0 * fixed_point_one)
+    fine_size = 1
+    while fine_size < zero_time and fine_size < MAX_EXP_DECAY_FINE_SIZE:
+        fine_size <<= 1
+    fine_shift = 0
+    while True:
+        coarse_step = fine_size << fine_shift
+        coarse_size = int(math.ceil(zero_time / coarse_step)) + 1
+        if coarse_size <= MAX_EXP_DECAY_COARSE_SIZE:
+            return fine_shift, fine_size, coarse_size
+        fine_shift += 1
+
+
+def _words(n_int16_entries):
+    return (n_int16_entries + 1) // 2
+
+
+def get_exp_decay_lut_size_in_bytes(time_constant,
+                                    fixed_point_one=STDP_FIXED_POINT_ONE):
+    """ Get the size of the composed exponential decay tables of a time\
+        constant, including their header
+    """
+    _, fine_size, coarse_size = get_exp_decay_lut_shape(
+        time_constant, fixed_point_one)
+    return 4 * (_EXP_DECAY_HEADER_WORDS + _words(fine_size) +
+                _words(coarse_size))
+
+
+def get_exp_decay_luts(time_constant, fixed_point_one=STDP_FIXED_POINT_ONE):
+    """ Generate the composed exponential decay tables of a time constant
+
+    :return: a tuple of (fine shift, fine entries, coarse entries)
+    """
+    fine_shift, fine_size, coarse_size = get_exp_decay_lut_shape(
+        time_constant, fixed_point_one)
+    coarse_shift = fine_shift + int(math.log(fine_size, 2))
     time_constant_reciprocal = 1.0 / float(time_constant)
+    fine = [float_to_fixed(
+                math.exp(-float(i << fine_shift) * time_constant_reciprocal),
+                EXP_DECAY_FIXED_POINT_ONE)
+            for i in range(fine_size)]
+    coarse = [float_to_fixed(
+                  math.exp(-float(i << coarse_shift) *
+                           time_constant_reciprocal),
+                  EXP_DECAY_FIXED_POINT_ONE)
+              for i in range(coarse_size - 1)]
+    coarse.append(0)
+    return fine_shift, fine, coarse
+
+
+def exp_decay_lookup(time, fine_shift, fine, coarse,
+                     fixed_point_one=STDP_FIXED_POINT_ONE):
+    """ Look up a decay in composed tables as exp_decay_lookup in\
+        exp_decay.h does
 
-    # Generate LUT
-    last_value = None
-    for i in range(size):
+    :return: the decay in the fixed point of fixed_point_one
+    """
+    coarse_shift = fine_shift + int(math.log(len(fine), 2))
+    coarse_index = min(time >> coarse_shift, len(coarse) - 1)
+    fine_index = (time >> fine_shift) & (len(fine) - 1)
+    product_shift = (2 * int(math.log(EXP_DECAY_FIXED_POINT_ONE, 2)) -
+                     int(math.log(fixed_point_one, 2)))
+    product = coarse[coarse_index] * fine[fine_index]
+    return (product + (1 << (product_shift - 1))) >> product_shift
 
-        # Apply shift to get time from index
-        time = (i << shift)
 
-        # Multiply by time constant and calculate negative exponential
-        value = float(time) * time_constant_reciprocal
-        exp_float = math.exp(-value)
+def write_exp_decay_lut(spec, time_constant,
+                        fixed_point_one=STDP_FIXED_POINT_ONE):
+    """ Write the composed exponential decay tables of a time constant, as\
+        read by exp_decay_lut_initialise in exp_decay.h
 
-        # Convert to fixed-point and write to spec
-        last_value = float_to_fixed(exp_float, fixed_point_one)
-        spec.write_value(data=last_value, data_type=DataType.INT16)
+    :return: the decay at the first time past the tables reverted to\
+        float, which should be 0
+    """
+    fine_shift, fine, coarse = get_exp_decay_luts(
+        time_constant, fixed_point_one)
+    spec.write_value(data=fine_shift, data_type=DataType.UINT32)
+    spec.write_value(data=len(fine), data_type=DataType.UINT32)
+    spec.write_value(data=len(coarse), data_type=DataType.UINT32)
+    for table in (fine, coarse):
+        for value in table:
+            spec.write_value(data=value, data_type=DataType.INT16)
+        if len(table) % 2 != 0:
+            spec.write_value(data=0, data_type=DataType.INT16)
 
-    # return last value reverted to float (should be 0 if correct)
-    return float(last_value) / float(fixed_point_one)
+    end_time = (len(coarse) - 1) * (len(fine) << fine_shift)
+    return float(float_to_fixed(
+        math.exp(-float(end_time) / float(time_constant)),
+        fixed_point_one)) / float(fixed_point_one)
+
+
+def get_exp_decay_lut_max_error(
+        time_constant, n_times, lookup, fixed_point_one=STDP_FIXED_POINT_ONE):
+    """ Get the largest error of a decay lookup over the first n_times\
+        time steps, in units of the last place of fixed_point_one; used to\
+        compare the accuracy of composed and single tables
+
+    :param lookup: a function of time returning the fixed-point decay
+    """
+    time_constant_reciprocal = 1.0 / float(time_constant)
+    max_error = 0.0
+    for time in range(n_times):
+        exact = math.exp(-float(time) * time_constant_reciprocal)
+        error = abs(float(lookup(time)) - (exact * fixed_point_one))
+        max_error = max(max_error, error)
+    return max_error
 
 
 def get_lut_provenance(
@@ -22,6 +22,12 @@ class AbstractTimingDependence(object):
         """ The number of bytes used by the pre-trace of the rule per neuron
         """
 
+    @abstractproperty
+    def post_trace_n_bytes(self):
+        """ The number of bytes used by each post-synaptic event stored in the\
+            post-synaptic history of each neuron
+        """
+
     @abstractmethod
     def get_parameters_sdram_usage_in_bytes(self):
         """ Get the amount of SDRAM used by the parameters of this rule
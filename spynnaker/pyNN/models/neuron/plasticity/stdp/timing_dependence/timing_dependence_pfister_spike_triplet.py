@@ -9,15 +9,6 @@ from spynnaker.pyNN.models.neuron.plasticity.stdp.synapse_structure\
 import logging
 logger = logging.getLogger(__name__)
 
-LOOKUP_TAU_PLUS_SIZE = 256
-LOOKUP_TAU_PLUS_SHIFT = 0
-LOOKUP_TAU_MINUS_SIZE = 256
-LOOKUP_TAU_MINUS_SHIFT = 0
-LOOKUP_TAU_X_SIZE = 256
-LOOKUP_TAU_X_SHIFT = 2
-LOOKUP_TAU_Y_SIZE = 256
-LOOKUP_TAU_Y_SHIFT = 2
-
 
 class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
 
@@ -74,9 +65,17 @@ class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
         # Triplet rule trace entries consists of two 16-bit traces - R1 and R2
         return 4
 
+    @property
+    def post_trace_n_bytes(self):
+
+        # Triplet rule trace entries consists of two 16-bit traces - O1 and O2
+        return 4
+
     def get_parameters_sdram_usage_in_bytes(self):
-        return (2 * (LOOKUP_TAU_PLUS_SIZE + LOOKUP_TAU_MINUS_SIZE +
-                     LOOKUP_TAU_X_SIZE + LOOKUP_TAU_Y_SIZE))
+        return sum(
+            plasticity_helpers.get_exp_decay_lut_size_in_bytes(tau)
+            for tau in (
+                self._tau_plus, self._tau_minus, self._tau_x, self._tau_y))
 
     @property
     def n_weight_terms(self):
@@ -90,16 +89,14 @@ class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
                 "STDP LUT generation currently only supports 1ms timesteps")
 
         # Write lookup tables
-        self._tau_plus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_plus, LOOKUP_TAU_PLUS_SIZE,
-            LOOKUP_TAU_PLUS_SHIFT)
-        self._tau_minus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_minus, LOOKUP_TAU_MINUS_SIZE,
-            LOOKUP_TAU_MINUS_SHIFT)
-        self._tau_x_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_x, LOOKUP_TAU_X_SIZE, LOOKUP_TAU_X_SHIFT)
-        self._tau_y_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_y, LOOKUP_TAU_Y_SIZE, LOOKUP_TAU_Y_SHIFT)
+        self._tau_plus_last_entry = plasticity_helpers.write_exp_decay_lut(
+            spec, self._tau_plus)
+        self._tau_minus_last_entry = plasticity_helpers.write_exp_decay_lut(
+            spec, self._tau_minus)
+        self._tau_x_last_entry = plasticity_helpers.write_exp_decay_lut(
+            spec, self._tau_x)
+        self._tau_y_last_entry = plasticity_helpers.write_exp_decay_lut(
+            spec, self._tau_y)
 
     @property
     def synaptic_structure(self):
@@ -10,11 +10,6 @@ from spynnaker.pyNN.models.neuron.plasticity.stdp.synapse_structure\
 import logging
 logger = logging.getLogger(__name__)
 
-LOOKUP_TAU_PLUS_SIZE = 256
-LOOKUP_TAU_PLUS_SHIFT = 0
-LOOKUP_TAU_MINUS_SIZE = 256
-LOOKUP_TAU_MINUS_SHIFT = 0
-
 
 class TimingDependenceSpikePair(AbstractTimingDependence):
 
@@ -61,8 +56,18 @@ class TimingDependenceSpikePair(AbstractTimingDependence):
         # Neighbours are considered and, a single 16-bit R1 trace
         return 0 if self._nearest else 2
 
+    @property
+    def post_trace_n_bytes(self):
+
+        # As for the pre-synaptic trace
+        return 0 if self._nearest else 2
+
     def get_parameters_sdram_usage_in_bytes(self):
-        return 2 * (LOOKUP_TAU_PLUS_SIZE + LOOKUP_TAU_MINUS_SIZE)
+        return (
+            plasticity_helpers.get_exp_decay_lut_size_in_bytes(
+                self._tau_plus) +
+            plasticity_helpers.get_exp_decay_lut_size_in_bytes(
+                self._tau_minus))
 
     @property
     def n_weight_terms(self):
@@ -76,12 +81,10 @@ class TimingDependenceSpikePair(AbstractTimingDependence):
                 "STDP LUT generation currently only supports 1ms timesteps")
 
         # Write lookup tables
-        self._tau_plus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_plus, LOOKUP_TAU_PLUS_SIZE,
-            LOOKUP_TAU_PLUS_SHIFT)
-        self._tau_minus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_minus, LOOKUP_TAU_MINUS_SIZE,
-            LOOKUP_TAU_MINUS_SHIFT)
+        self._tau_plus_last_entry = plasticity_helpers.write_exp_decay_lut(
+            spec, self._tau_plus)
+        self._tau_minus_last_entry = plasticity_helpers.write_exp_decay_lut(
+            spec, self._tau_minus)
 
     @property
     def synaptic_structure(self):
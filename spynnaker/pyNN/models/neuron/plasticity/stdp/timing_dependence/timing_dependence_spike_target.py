@@ -10,9 +10,6 @@ from spynnaker.pyNN.models.neuron.plasticity.stdp.synapse_structure\
 import logging
 logger = logging.getLogger(__name__)
 
-LOOKUP_TAU_PLUS_SIZE = 256
-LOOKUP_TAU_PLUS_SHIFT = 0
-
 
 class TimingDependenceSpikeTarget(AbstractTimingDependence):
 
@@ -52,10 +49,17 @@ class TimingDependenceSpikeTarget(AbstractTimingDependence):
         # Neighbours are considered and, a single 16-bit R1 trace
         return 0 # if self._nearest else 2
 
+    @property
+    def post_trace_n_bytes(self):
+
+        # A single 16-bit trace
+        return 2
+
     def get_parameters_sdram_usage_in_bytes(self):
         # 2*16bit for the two accumulators plus
-        # 16bit weight * lookup tables
-        return (2*2) + (2 * LOOKUP_TAU_PLUS_SIZE)
+        # the lookup tables
+        return (2*2) + plasticity_helpers.get_exp_decay_lut_size_in_bytes(
+            self._tau_plus)
 
     @property
     def n_weight_terms(self):
@@ -69,9 +73,8 @@ class TimingDependenceSpikeTarget(AbstractTimingDependence):
                 "STDP LUT generation currently only supports 1ms timesteps")
 
         # Write lookup tables
-        self._tau_plus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self._tau_plus, LOOKUP_TAU_PLUS_SIZE,
-            LOOKUP_TAU_PLUS_SHIFT)
+        self._tau_plus_last_entry = plasticity_helpers.write_exp_decay_lut(
+            spec, self._tau_plus)
 
     @property
     def synaptic_structure(self):
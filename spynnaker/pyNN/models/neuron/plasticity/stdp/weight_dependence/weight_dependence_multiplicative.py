@@ -5,12 +5,23 @@ from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence\
 
 class WeightDependenceMultiplicative(AbstractWeightDependence):
 
-    def __init__(self, w_min=0.0, w_max=1.0, A_plus=0.01, A_minus=0.01):
+    def __init__(self, w_min=0.0, w_max=1.0, A_plus=0.01, A_minus=0.01,
+                 deferred=False):
+        """
+
+        :param deferred: If True, the potentiation and depression of all the\
+            events of a synapse update are applied together at the end, each\
+            scaled by the distance of the weight from its bound before the\
+            update; this differs from applying each event in turn by the\
+            product of the learning rates, but lets the events be processed\
+            once for all the synapses that see them
+        """
         AbstractWeightDependence.__init__(self)
         self._w_min = w_min
         self._w_max = w_max
         self._A_plus = A_plus
         self._A_minus = A_minus
+        self._deferred = deferred
 
     @property
     def w_min(self):
@@ -28,6 +39,10 @@ class WeightDependenceMultiplicative(AbstractWeightDependence):
     def A_minus(self):
         return self._A_minus
 
+    @property
+    def deferred(self):
+        return self._deferred
+
     def is_same_as(self, weight_dependence):
         if not isinstance(weight_dependence, WeightDependenceMultiplicative):
             return False
@@ -35,10 +50,13 @@ class WeightDependenceMultiplicative(AbstractWeightDependence):
             (self._w_min == weight_dependence._w_min) and
             (self._w_max == weight_dependence._w_max) and
             (self._A_plus == weight_dependence._A_plus) and
-            (self._A_minus == weight_dependence._A_minus))
+            (self._A_minus == weight_dependence._A_minus) and
+            (self._deferred == weight_dependence._deferred))
 
     @property
     def vertex_executable_suffix(self):
+        if self._deferred:
+            return "multiplicative_deferred"
         return "multiplicative"
 
     def get_parameters_sdram_usage_in_bytes(
@@ -15,6 +15,13 @@ from spinn_front_end_common.abstract_models.abstract_recordable \
 
 # spynnaker imports
 from spynnaker.pyNN.utilities import constants
+from spynnaker.pyNN.utilities import input_buffer_losses
+from spynnaker.pyNN.utilities import spike_latency
+from spynnaker.pyNN.utilities import tick_profile
+from spynnaker.pyNN.utilities import weight_recording
+from spynnaker.pyNN.utilities.input_buffer_losses import InputBufferLosses
+from spynnaker.pyNN.utilities.spike_latency import SpikeLatencies
+from spynnaker.pyNN.utilities.tick_profile import TickProfile
 
 from enum import Enum
 
@@ -29,9 +36,38 @@ class PopulationPartitionedVertex(
         names=[("PRE_SYNAPTIC_EVENT_COUNT", 0),
                ("SATURATION_COUNT", 1),
                ("BUFFER_OVERFLOW_COUNT", 2),
-               ("CURRENT_TIMER_TIC", 3)])
+               ("CURRENT_TIMER_TIC", 3),
+               ("MAX_OUT_SPIKE_QUEUE_DEPTH", 4),
+               ("SEND_STALL_TIME", 5),
+               ("DIRECT_ROW_COUNT", 6),
+               ("ROW_DMA_COUNT", 7),
+               ("ROW_CACHE_HIT_COUNT", 8),
+               ("MERGED_SPIKE_COUNT", 9),
+               ("LATE_SPIKE_COUNT", 10),
+               ("LATE_ROW_COUNT", 11),
+               ("TICKS_WITH_LATE_ROWS", 12),
+               ("MAX_LATE_ROWS_IN_A_TICK", 13),
+               ("PLASTIC_BYTES_WRITTEN", 14),
+               ("PLASTIC_BYTES_SKIPPED", 15),
+               ("INPUT_BUFFER_START", 16),
+               ("TICK_PROFILE_START",
+                16 + input_buffer_losses.N_PROVENANCE_WORDS),
+               ("SPIKE_LATENCY_START",
+                16 + input_buffer_losses.N_PROVENANCE_WORDS +
+                tick_profile.N_PROVENANCE_WORDS),
+               ("WEIGHT_CHANGES_RECORDED",
+                16 + input_buffer_losses.N_PROVENANCE_WORDS +
+                tick_profile.N_PROVENANCE_WORDS +
+                spike_latency.N_PROVENANCE_WORDS),
+               ("WEIGHT_CHANGES_LOST",
+                17 + input_buffer_losses.N_PROVENANCE_WORDS +
+                tick_profile.N_PROVENANCE_WORDS +
+                spike_latency.N_PROVENANCE_WORDS)])
 
-    N_ADDITIONAL_PROVENANCE_DATA_ITEMS = 4
+    N_ADDITIONAL_PROVENANCE_DATA_ITEMS = (
+        16 + input_buffer_losses.N_PROVENANCE_WORDS +
+        tick_profile.N_PROVENANCE_WORDS + spike_latency.N_PROVENANCE_WORDS +
+        weight_recording.N_PROVENANCE_WORDS)
 
     def __init__(
             self, resources_required, label, is_recording, constraints=None):
@@ -43,10 +79,45 @@ class PopulationPartitionedVertex(
             self.N_ADDITIONAL_PROVENANCE_DATA_ITEMS)
         AbstractRecordable.__init__(self)
         self._is_recording = is_recording
+        self._input_key_range_labels = list()
+        self._input_buffer_losses = None
+        self._tick_profile = None
+        self._spike_latencies = None
 
     def is_recording(self):
         return self._is_recording
 
+    @property
+    def input_key_range_labels(self):
+        """ The labels of the edges of the key ranges written to the input\
+            buffer region, in the order written
+        """
+        return self._input_key_range_labels
+
+    @input_key_range_labels.setter
+    def input_key_range_labels(self, input_key_range_labels):
+        self._input_key_range_labels = input_key_range_labels
+
+    @property
+    def input_buffer_losses(self):
+        """ The input spike losses read with the provenance data
+        """
+        return self._input_buffer_losses
+
+    @property
+    def tick_profile(self):
+        """ The timer tick profile read with the provenance data, or None if\
+            the binary was not built with TICK_PROFILE
+        """
+        return self._tick_profile
+
+    @property
+    def spike_latencies(self):
+        """ The spike processing latencies read with the provenance data, or\
+            None if the binary was not built with SPIKE_LATENCY
+        """
+        return self._spike_latencies
+
     def get_provenance_data_from_machine(self, transceiver, placement):
         provenance_data = self._read_provenance_data(transceiver, placement)
         provenance_items = self._read_basic_provenance_items(
@@ -62,6 +133,52 @@ class PopulationPartitionedVertex(
             self.EXTRA_PROVENANCE_DATA_ENTRIES.PRE_SYNAPTIC_EVENT_COUNT.value]
         last_timer_tick = provenance_data[
             self.EXTRA_PROVENANCE_DATA_ENTRIES.CURRENT_TIMER_TIC.value]
+        max_out_spike_queue_depth = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.MAX_OUT_SPIKE_QUEUE_DEPTH.value]
+        send_stall_time = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.SEND_STALL_TIME.value]
+        n_direct_rows = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.DIRECT_ROW_COUNT.value]
+        n_row_dmas = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.ROW_DMA_COUNT.value]
+        n_row_cache_hits = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.ROW_CACHE_HIT_COUNT.value]
+        n_merged_spikes = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.MERGED_SPIKE_COUNT.value]
+        n_late_spikes = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.LATE_SPIKE_COUNT.value]
+        n_late_rows = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.LATE_ROW_COUNT.value]
+        n_ticks_with_late_rows = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.TICKS_WITH_LATE_ROWS.value]
+        max_late_rows_in_a_tick = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.MAX_LATE_ROWS_IN_A_TICK.value]
+        n_plastic_bytes_written = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.PLASTIC_BYTES_WRITTEN.value]
+        n_plastic_bytes_skipped = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.PLASTIC_BYTES_SKIPPED.value]
+        n_weight_changes_recorded = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.WEIGHT_CHANGES_RECORDED.value]
+        n_weight_changes_lost = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.WEIGHT_CHANGES_LOST.value]
+        input_buffer_start = \
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.INPUT_BUFFER_START.value
+        self._input_buffer_losses = InputBufferLosses(
+            provenance_data[input_buffer_start:
+                            input_buffer_start +
+                            input_buffer_losses.N_PROVENANCE_WORDS])
+        tick_profile_start = \
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.TICK_PROFILE_START.value
+        self._tick_profile = TickProfile.from_provenance_words(
+            provenance_data[tick_profile_start:
+                            tick_profile_start +
+                            tick_profile.N_PROVENANCE_WORDS])
+        spike_latency_start = \
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.SPIKE_LATENCY_START.value
+        self._spike_latencies = SpikeLatencies.from_provenance_words(
+            provenance_data[spike_latency_start:
+                            spike_latency_start +
+                            spike_latency.N_PROVENANCE_WORDS])
 
         label, x, y, p, names = self._get_placement_details(placement)
 
@@ -93,4 +210,172 @@ class PopulationPartitionedVertex(
         provenance_items.append(ProvenanceDataItem(
             self._add_name(names, "Last_timer_tic_the_core_ran_to"),
             last_timer_tick))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Max_spikes_sent_in_one_timer_tic"),
+            max_out_spike_queue_depth))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Time_stalled_sending_spikes_in_us"),
+            send_stall_time,
+            report=send_stall_time > 0,
+            message=(
+                "The population {} on {}, {}, {} spent {} microseconds "
+                "waiting for the router to accept its spikes.  This is a "
+                "sign that the network is congested; try spreading the "
+                "spiking neurons over more cores or increasing the "
+                "time_scale_factor.".format(
+                    label, x, y, p, send_stall_time))))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Synaptic_rows_read_from_direct_matrix"),
+            n_direct_rows))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Synaptic_rows_read_by_DMA"),
+            n_row_dmas))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Synaptic_rows_read_from_row_cache"),
+            n_row_cache_hits))
+        if n_row_cache_hits + n_row_dmas > 0:
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(names, "Row_cache_hit_percentage"),
+                (100.0 * n_row_cache_hits) / (n_row_cache_hits + n_row_dmas)))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Spikes_merged_with_the_previous_spike"),
+            n_merged_spikes))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Spikes_processed_after_their_timer_tic"),
+            n_late_spikes))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Synaptic_rows_too_late_for_their_delay"),
+            n_late_rows,
+            report=n_late_rows > 0,
+            message=(
+                "{} synaptic rows of {} on {}, {}, {} were processed after "
+                "the input of their shortest delays was needed, in {} timer "
+                "tics with at most {} in one tic, so some synapses took "
+                "effect a tic late.  Try reducing the number of neurons per "
+                "core, increasing the time_scale_factor or setting "
+                "incoming_spike_drain_guard_us.".format(
+                    n_late_rows, label, x, y, p, n_ticks_with_late_rows,
+                    max_late_rows_in_a_tick))))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Timer_tics_with_late_synaptic_rows"),
+            n_ticks_with_late_rows))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Max_late_synaptic_rows_in_one_timer_tic"),
+            max_late_rows_in_a_tick))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Plastic_synapse_bytes_written_back"),
+            n_plastic_bytes_written))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(
+                names, "Plastic_synapse_bytes_unchanged_and_not_written_back"),
+            n_plastic_bytes_skipped))
+        if n_weight_changes_recorded + n_weight_changes_lost > 0:
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(names, "Weight_changes_recorded"),
+                n_weight_changes_recorded))
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(names, "Weight_changes_lost"),
+                n_weight_changes_lost,
+                report=n_weight_changes_lost > 0,
+                message=(
+                    "{} changes to the weights recorded by {} on {}, {}, {}"
+                    " were lost as the buffer filled before it was sent."
+                    "  Try a shorter interval for record_weights.".format(
+                        n_weight_changes_lost, label, x, y, p))))
+        self._add_input_buffer_items(provenance_items, names, label, x, y, p)
+        if self._tick_profile is not None:
+            self._add_tick_profile_items(
+                provenance_items, names, label, x, y, p)
+        if self._spike_latencies is not None:
+            self._add_spike_latency_items(provenance_items, names)
         return provenance_items
+
+    def _add_input_buffer_items(self, provenance_items, names, label, x, y, p):
+        losses = self._input_buffer_losses
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Input_buffer_size"), losses.buffer_size))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Spikes_dropped_early_from_input_buffer"),
+            losses.n_early_drops))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Timer_tics_with_input_spike_losses"),
+            losses.n_ticks_with_losses))
+        if losses.first_tick_with_losses is None:
+            return
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "First_timer_tic_with_input_spike_losses"),
+            losses.first_tick_with_losses))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Max_input_spikes_lost_in_one_timer_tic"),
+            losses.max_losses_in_a_tick))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Timer_tic_of_max_input_spike_losses"),
+            losses.tick_of_max_losses))
+
+        # Report the losses of each projection so that the one flooding the
+        # core can be found
+        edge_losses = list()
+        for edge_label, n_lost in zip(
+                self._input_key_range_labels, losses.range_losses):
+            if n_lost > 0:
+                edge_losses.append((edge_label, n_lost))
+        if losses.other_losses > 0:
+            edge_losses.append(("other edges", losses.other_losses))
+        for edge_label, n_lost in edge_losses:
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(
+                    names, "Input_spikes_lost_from_{}".format(edge_label)),
+                n_lost,
+                report=True,
+                message=(
+                    "{} spikes from {} were lost by the input buffer for {}"
+                    " on {}, {}, {}.  If these are more than expected, the"
+                    " source may be firing faster than the core can"
+                    " process; consider a larger incoming_spike_buffer_size,"
+                    " a lower input_priority for the projection or fewer"
+                    " neurons per core.".format(
+                        n_lost, edge_label, label, x, y, p))))
+
+    def _add_tick_profile_items(self, provenance_items, names, label, x, y, p):
+        profile = self._tick_profile
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Timer_tics_that_overran"),
+            profile.n_late_ticks,
+            report=profile.n_late_ticks > 0,
+            message=(
+                "{} of the {} timer tics of {} on {}, {}, {} finished after "
+                "the next tic was due.  Try reducing the number of neurons "
+                "per core or increasing the time_scale_factor; the tick "
+                "profile report shows which phase of the tic takes the "
+                "time.".format(
+                    profile.n_late_ticks, profile.n_ticks, label, x, y, p))))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(
+                names, "Timer_tics_started_with_spike_processing_busy"),
+            profile.n_spike_processing_busy_ticks))
+        for phase_name in tick_profile.PHASES:
+            phase = profile.phase(phase_name)
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(
+                    names, "Mean_{}_time_per_tic_in_us".format(phase_name)),
+                phase.mean_us))
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(
+                    names, "Max_{}_time_per_tic_in_us".format(phase_name)),
+                phase.max_us))
+
+    def _add_spike_latency_items(self, provenance_items, names):
+        latencies = self._spike_latencies
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Spikes_with_latency_measured"),
+            latencies.n_spikes))
+        for stage in spike_latency.STAGES:
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(
+                    names, "Max_spike_{}_latency_in_us".format(stage)),
+                latencies.max_us(stage)))
+            provenance_items.append(ProvenanceDataItem(
+                self._add_name(
+                    names,
+                    "99th_percentile_spike_{}_latency_in_us".format(stage)),
+                latencies.percentile_us(stage, 0.99)))
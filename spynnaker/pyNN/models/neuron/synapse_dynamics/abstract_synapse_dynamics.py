@@ -37,6 +37,22 @@ class AbstractSynapseDynamics(object):
         """ Write the synapse parameters to the spec
         """
 
+    @abstractmethod
+    def get_dtcm_usage_in_bytes(self, n_neurons):
+        """ Get the DTCM used by the synapse dynamics for n_neurons neurons
+        """
+
+    @abstractmethod
+    def get_n_cpu_cycles_per_row(self):
+        """ Get the CPU cycles taken to look up, read and finish each row of\
+            synapses, not including the synapses themselves
+        """
+
+    @abstractmethod
+    def get_n_cpu_cycles_per_synapse(self):
+        """ Get the CPU cycles taken to process each synapse in a row
+        """
+
     def get_provenance_data(self, pre_population_label, post_population_label):
         """ Get the provenance data from this synapse dynamics object
         """
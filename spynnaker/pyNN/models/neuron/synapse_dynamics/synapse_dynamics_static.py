@@ -7,6 +7,22 @@ from spynnaker.pyNN.models.neuron.synapse_dynamics\
 
 class SynapseDynamicsStatic(AbstractStaticSynapseDynamics):
 
+    # The CPU cycles of a row, counted from the instructions of
+    # spike_processing.c and synapses.c on the ARM968 (1 cycle per data
+    # operation, 2 per load and 3 per taken branch), as no build has yet been
+    # measured; these should be checked against the spike processing time in
+    # the tick profile report of a TICK_PROFILE build.  The row is taken from
+    # the input buffer (15), looked up in the master population table (a
+    # binary search of about 6 levels of 10), read by DMA (20 to start it and
+    # 40 to enter and leave the callback) and its header decoded (15)
+    N_CPU_CYCLES_PER_ROW = 150
+
+    # The CPU cycles of a synapse in _process_fixed_synapses: loading the
+    # word (2), extracting the delay, index, type and weight (4), the ring
+    # buffer index (4), loading, adding to, saturating and storing the ring
+    # buffer entry (6) and the loop (4)
+    N_CPU_CYCLES_PER_SYNAPSE = 20
+
     def __init__(self):
         AbstractStaticSynapseDynamics.__init__(self)
 
@@ -25,6 +41,15 @@ class SynapseDynamicsStatic(AbstractStaticSynapseDynamics):
     def write_parameters(self, spec, region, machine_time_step, weight_scales):
         pass
 
+    def get_dtcm_usage_in_bytes(self, n_neurons):
+        return 0
+
+    def get_n_cpu_cycles_per_row(self):
+        return self.N_CPU_CYCLES_PER_ROW
+
+    def get_n_cpu_cycles_per_synapse(self):
+        return self.N_CPU_CYCLES_PER_SYNAPSE
+
     def get_n_words_for_static_connections(self, n_connections):
         return n_connections
 
@@ -3,6 +3,9 @@ import numpy
 
 from spynnaker.pyNN.models.neuron.synapse_dynamics\
     .abstract_plastic_synapse_dynamics import AbstractPlasticSynapseDynamics
+from spynnaker.pyNN.models.neuron.synapse_dynamics.synapse_dynamics_static \
+    import SynapseDynamicsStatic
+from spynnaker.pyNN.utilities import constants
 
 # How large are the time-stamps stored with each event
 TIME_STAMP_BYTES = 4
@@ -10,29 +13,125 @@ TIME_STAMP_BYTES = 4
 # When not using the MAD scheme, how many pre-synaptic events are buffered
 NUM_PRE_SYNAPTIC_EVENTS = 4
 
+# The CPU cycles of processing plastic rows and synapses are counted from the
+# instructions of the loops of the synapse dynamics on the ARM968 (1 cycle per
+# data operation, 2 per load or multiply and 3 per taken branch), as no build
+# has yet been measured; a SYNAPSE_BENCHMARK build logs the cycles of its
+# plastic rows and of its weight updates (weight_update_benchmark.h), against
+# which these should be checked and replaced.
+#
+# Per row, on top of the static row: the update of the pre-synaptic trace in
+# the header (a decay lookup and multiply) and the write-back DMA of the
+# plastic region; without MAD, the buffer of pre-synaptic events is also
+# searched and shifted
+_N_CPU_CYCLES_PER_ROW_MAD = 60
+_N_CPU_CYCLES_PER_ROW = 110
+
+# Per synapse: loading and decoding the control and plastic words, finding the
+# post-synaptic window, the update state, storing the synapse and adding to
+# the ring buffer; without MAD, each buffered pre-synaptic event is also
+# visited
+_N_CPU_CYCLES_PER_SYNAPSE_MAD = 50
+_N_CPU_CYCLES_PER_SYNAPSE = 70
+
+# Per event applied to a synapse by each timing rule: the decay lookup and
+# multiply of each trace the rule uses (timing_*_impl.h)
+_TIMING_N_CPU_CYCLES_PER_EVENT = {
+    "pair": 12, "nearest_pair": 8, "pfister_triplet": 24}
+
+# Per update applied to the weight state by each weight dependence, and to
+# finish the weight (weight_*_impl.h); the deferred multiplicative dependence
+# only adds each update, and scales the sums when it finishes
+_WEIGHT_N_CPU_CYCLES_PER_UPDATE = {
+    "additive": 6, "multiplicative": 10, "multiplicative_deferred": 2}
+_WEIGHT_N_CPU_CYCLES_FINAL = {
+    "additive": 8, "multiplicative": 6, "multiplicative_deferred": 16}
+
+# The post-synaptic events assumed to be applied to each synapse per
+# pre-synaptic spike, as when the pre- and post-synaptic rates are equal
+_N_POST_EVENTS_PER_SYNAPSE = 1
+
+# When the window cache is used, the updates of the window are added to each
+# synapse, for one cycle per weight term, after a lookup of the cache
+_N_CPU_CYCLES_WINDOW_CACHE_LOOKUP = 8
+
+# The compact post-synaptic history expands the times of each window it finds
+# and rebuilds the traces of its events (post_events.h)
+_N_CPU_CYCLES_COMPACT_WINDOW = 12
+_N_CPU_CYCLES_COMPACT_PER_EVENT = 14
+
+# The compact post-synaptic history keeps the trace of every this many events,
+# from which the traces of a window are rebuilt, from post_events.h
+_COMPACT_CHECKPOINT_INTERVAL = 8
+
+# The number of post-synaptic events kept per neuron, from post_events.h
+MAX_POST_SYNAPTIC_EVENTS = 64
+
+# The bytes of the time of an event in the compact post-synaptic history, and
+# of the epoch, count of events and number of the first event before the
+# times, from post_events.h
+COMPACT_TIME_STAMP_BYTES = 2
+_COMPACT_HISTORY_HEADER_BYTES = 8
+
+# The number of bits in a plastic control word, and the number of these used
+# by the dendritic delay, from synapse_row.h; the axonal delay gets the bits
+# left over by the synapse type and index, from
+# synapse_dynamics_stdp_mad_impl.c
+_N_CONTROL_WORD_BITS = 16
+_N_DENDRITIC_DELAY_BITS = 4
+
+# The weight dependencies whose updates are accumulated apart from the weight,
+# for which synapse_dynamics_stdp_mad_impl.c caches the updates of the
+# post-synaptic window last found for each neuron
+_COMMUTING_WEIGHT_DEPENDENCIES = ("additive", "multiplicative_deferred")
+
 
 class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
 
     def __init__(
             self, timing_dependence=None, weight_dependence=None,
             voltage_dependence=None,
-            dendritic_delay_fraction=1.0, mad=True):
+            dendritic_delay_fraction=1.0, mad=True,
+            compact_post_history=False, interleaved_rows=False):
         AbstractPlasticSynapseDynamics.__init__(self)
         self._timing_dependence = timing_dependence
         self._weight_dependence = weight_dependence
         self._dendritic_delay_fraction = float(dendritic_delay_fraction)
         self._mad = mad
+        self._compact_post_history = compact_post_history
+        self._interleaved_rows = interleaved_rows
 
         if (self._dendritic_delay_fraction < 0.5 or
                 self._dendritic_delay_fraction > 1.0):
             raise NotImplementedError(
                 "dendritic_delay_fraction must be in the interval [0.5, 1.0]")
 
+        # Only the MAD implementation splits the delay; the other reads the
+        # whole delay as dendritic
+        if not self._mad and self._dendritic_delay_fraction != 1.0:
+            raise NotImplementedError(
+                "dendritic_delay_fraction must be 1.0 unless mad is True")
+
+        # Only the MAD builds have a compact post-synaptic history
+        if not self._mad and self._compact_post_history:
+            raise NotImplementedError(
+                "compact_post_history is only available when mad is True")
+
         if self._timing_dependence is None or self._weight_dependence is None:
             raise NotImplementedError(
                 "Both timing_dependence and weight_dependence must be"
                 "specified")
 
+        # Only the MAD builds read interleaved rows, and only a 16-bit plastic
+        # synapse fits in a word with its control word
+        if self._interleaved_rows and (
+                not self._mad or
+                self._timing_dependence.synaptic_structure
+                .get_n_bytes_per_connection() != _N_CONTROL_WORD_BITS // 8):
+            raise NotImplementedError(
+                "interleaved_rows is only available when mad is True and the"
+                " plastic synapses are 16-bit weights")
+
         if voltage_dependence is not None:
             raise NotImplementedError(
                 "Voltage dependence has not been implemented")
@@ -49,6 +148,18 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
     def dendritic_delay_fraction(self):
         return self._dendritic_delay_fraction
 
+    @property
+    def mad(self):
+        return self._mad
+
+    @property
+    def compact_post_history(self):
+        return self._compact_post_history
+
+    @property
+    def interleaved_rows(self):
+        return self._interleaved_rows
+
     def is_same_as(self, synapse_dynamics):
         if not isinstance(synapse_dynamics, SynapseDynamicsSTDP):
             return False
@@ -59,13 +170,20 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
                 synapse_dynamics._weight_dependence) and
             (self._dendritic_delay_fraction ==
              synapse_dynamics._dendritic_delay_fraction) and
-            (self._mad == synapse_dynamics._mad))
+            (self._mad == synapse_dynamics._mad) and
+            (self._compact_post_history ==
+             synapse_dynamics._compact_post_history) and
+            (self._interleaved_rows == synapse_dynamics._interleaved_rows))
 
     def are_weights_signed(self):
         return False
 
     def get_vertex_executable_suffix(self):
         name = "_stdp_mad" if self._mad else "_stdp"
+        if self._compact_post_history:
+            name += "_compact"
+        if self._interleaved_rows:
+            name += "_interleaved"
         name += "_" + self._timing_dependence.vertex_executable_suffix
         name += "_" + self._weight_dependence.vertex_executable_suffix
         return name
@@ -94,6 +212,99 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
             spec, machine_time_step, weight_scales,
             self._timing_dependence.n_weight_terms)
 
+    def get_dtcm_usage_in_bytes(self, n_neurons):
+
+        # Each neuron has a post-synaptic event history of a count followed by
+        # the time and trace of each event
+        post_trace_n_bytes = self._timing_dependence.post_trace_n_bytes
+        full_history_bytes = 4 + (MAX_POST_SYNAPTIC_EVENTS * (
+            TIME_STAMP_BYTES + post_trace_n_bytes))
+        history_bytes = n_neurons * full_history_bytes
+        if self._compact_post_history:
+
+            # The compact history has a shorter time and no trace per event,
+            # and one history at a time is expanded to full when it is used
+            history_bytes = full_history_bytes + (
+                n_neurons *
+                self.get_compact_post_history_bytes(post_trace_n_bytes))
+
+        # The decay lookup tables of the timing dependence are copied to DTCM
+        return (history_bytes + (n_neurons * self._window_cache_bytes) +
+                self._timing_dependence.get_parameters_sdram_usage_in_bytes())
+
+    @staticmethod
+    def get_compact_post_history_bytes(post_trace_n_bytes):
+        """ The bytes per neuron of the compact post-synaptic history
+        """
+        n_traces = 2 + (
+            MAX_POST_SYNAPTIC_EVENTS // _COMPACT_CHECKPOINT_INTERVAL)
+        n_bytes = (
+            _COMPACT_HISTORY_HEADER_BYTES +
+            (MAX_POST_SYNAPTIC_EVENTS * COMPACT_TIME_STAMP_BYTES) +
+            (n_traces * post_trace_n_bytes))
+        return 4 * int(math.ceil(n_bytes / 4.0))
+
+    @property
+    def _window_cache_bytes(self):
+        """ The bytes per neuron of the cache of post-synaptic window updates
+        """
+        if (not self._mad or
+                self._weight_dependence.vertex_executable_suffix not in
+                _COMMUTING_WEIGHT_DEPENDENCIES):
+            return 0
+
+        def _words(n_bytes):
+            return 4 * int(math.ceil(n_bytes / 4.0))
+
+        # The window (last pre-synaptic time and trace, end time and
+        # dendritic delay), and its updates (the weight state, of an initial
+        # weight, a potentiation and depression per term and the weight
+        # region, and the time and trace of the last event of the window)
+        window_bytes = 12 + _words(self._timing_dependence.pre_trace_n_bytes)
+        update_bytes = (
+            4 * (2 + 2 * self._timing_dependence.n_weight_terms) + 4 +
+            _words(self._timing_dependence.post_trace_n_bytes))
+        return window_bytes + update_bytes
+
+    def get_n_cpu_cycles_per_row(self):
+        n_cycles = (
+            _N_CPU_CYCLES_PER_ROW_MAD if self._mad else _N_CPU_CYCLES_PER_ROW)
+        return SynapseDynamicsStatic.N_CPU_CYCLES_PER_ROW + n_cycles
+
+    def get_n_cpu_cycles_per_synapse(self):
+        timing_cycles = _TIMING_N_CPU_CYCLES_PER_EVENT[
+            self._timing_dependence.vertex_executable_suffix]
+        weight_suffix = self._weight_dependence.vertex_executable_suffix
+        update_cycles = _WEIGHT_N_CPU_CYCLES_PER_UPDATE[weight_suffix]
+        n_cycles = (
+            _N_CPU_CYCLES_PER_SYNAPSE_MAD if self._mad
+            else _N_CPU_CYCLES_PER_SYNAPSE)
+
+        # The pre-synaptic event, and the post-synaptic events, unless their
+        # updates are found once for the window and added to each synapse
+        n_cycles += timing_cycles + update_cycles
+        if self._window_cache_bytes > 0:
+            n_cycles += (
+                _N_CPU_CYCLES_WINDOW_CACHE_LOOKUP +
+                self._timing_dependence.n_weight_terms)
+        else:
+            n_cycles += _N_POST_EVENTS_PER_SYNAPSE * (
+                timing_cycles + update_cycles)
+        if self._compact_post_history:
+            n_cycles += self._compact_window_n_cpu_cycles
+        return n_cycles + _WEIGHT_N_CPU_CYCLES_FINAL[weight_suffix]
+
+    @property
+    def _compact_window_n_cpu_cycles(self):
+        """ The cycles of expanding a window of the compact post-synaptic\
+            history, which follows the trace on from the checkpoint before\
+            the window, and then rebuilds the traces from the window start
+        """
+        n_events = (
+            (_COMPACT_CHECKPOINT_INTERVAL - 1) + _N_POST_EVENTS_PER_SYNAPSE)
+        return _N_CPU_CYCLES_COMPACT_WINDOW + (
+            n_events * _N_CPU_CYCLES_COMPACT_PER_EVENT)
+
     @property
     def _n_header_bytes(self):
 
@@ -118,6 +329,11 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
         return int(math.ceil(float(n_bytes) / 4.0)) * 4
 
     def get_n_words_for_plastic_connections(self, n_connections):
+
+        # An interleaved row has a word per connection after the header
+        if self._interleaved_rows:
+            return (self._n_header_bytes // 4) + n_connections
+
         synapse_structure = self._timing_dependence.synaptic_structure
         fp_size_words = \
             n_connections if n_connections % 2 == 0 else n_connections + 1
@@ -128,37 +344,84 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
 
         return fp_size_words + pp_size_words
 
+    @staticmethod
+    def get_n_axonal_delay_bits(n_synapse_type_bits):
+        """ Get the number of bits of a plastic control word left for the\
+            axonal delay
+        """
+        return max(0, _N_CONTROL_WORD_BITS - (
+            _N_DENDRITIC_DELAY_BITS + n_synapse_type_bits +
+            constants.SYNAPSE_INDEX_BITS))
+
+    def split_delays(self, delays, n_synapse_type_bits):
+        """ Split delays in time steps into dendritic and axonal parts
+
+        :param delays: The delays of the connections, from 1 to 16 time steps
+        :param n_synapse_type_bits: The number of bits of the synapse type
+        :return: The dendritic and axonal delays; the axonal delay is at most\
+            the dendritic delay, as the post-synaptic spikes that reach the\
+            synapse by the time a pre-synaptic spike does must already have\
+            happened, and any of it that does not fit in the control word is\
+            moved to the dendritic delay
+        :rtype: (numpy.ndarray, numpy.ndarray)
+        """
+        delays = numpy.rint(delays).astype("uint32")
+
+        # Rounded before the floor so that a fraction that is not exact in
+        # binary still gives whole time steps where it should
+        max_axonal_delay = (
+            1 << self.get_n_axonal_delay_bits(n_synapse_type_bits)) - 1
+        axonal_delays = numpy.floor(numpy.round(
+            delays * (1.0 - self._dendritic_delay_fraction), 6))
+        axonal_delays = numpy.minimum(
+            axonal_delays, max_axonal_delay).astype("uint32")
+        return delays - axonal_delays, axonal_delays
+
     def get_plastic_synaptic_data(
             self, connections, connection_row_indices, n_rows,
             post_vertex_slice, n_synapse_types):
         n_synapse_type_bits = int(math.ceil(math.log(n_synapse_types, 2)))
-        dendritic_delays = (
-            connections["delay"] * self._dendritic_delay_fraction)
-        axonal_delays = (
-            connections["delay"] * (1.0 - self._dendritic_delay_fraction))
+        dendritic_delays, axonal_delays = self.split_delays(
+            connections["delay"], n_synapse_type_bits)
 
-        # Get the fixed data
+        # Get the fixed data; a dendritic delay of 16 is stored as 0
         fixed_plastic = (
             ((dendritic_delays.astype("uint16") & 0xF) <<
              (8 + n_synapse_type_bits)) |
-            ((axonal_delays.astype("uint16") & 0xF) <<
+            (axonal_delays.astype("uint16") <<
              (12 + n_synapse_type_bits)) |
             (connections["synapse_type"].astype("uint16") << 8) |
             ((connections["target"].astype("uint16") -
               post_vertex_slice.lo_atom) & 0xFF))
-        fixed_plastic_rows = self.convert_per_connection_data_to_rows(
-            connection_row_indices, n_rows,
-            fixed_plastic.view(dtype="uint8").reshape((-1, 2)))
-        fp_size = self.get_n_items(fixed_plastic_rows, 2)
-        fp_data = self.get_words(fixed_plastic_rows)
+        fixed_plastic = fixed_plastic.view(dtype="uint8").reshape((-1, 2))
 
         # Get the plastic data
         synapse_structure = self._timing_dependence.synaptic_structure
         plastic_plastic = synapse_structure.get_synaptic_data(connections)
+
+        if self._interleaved_rows:
+
+            # Each control word goes in the lower half of a word of the
+            # plastic data, with its plastic synapse in the upper half, and
+            # the fixed-plastic data is just the count of synapses
+            interleaved = numpy.concatenate(
+                (fixed_plastic, plastic_plastic), axis=1)
+            plastic_plastic_row_data = \
+                self.convert_per_connection_data_to_rows(
+                    connection_row_indices, n_rows, interleaved)
+            fp_size = self.get_n_items(plastic_plastic_row_data, 4)
+            fp_data = [numpy.zeros(0, dtype="uint32") for _ in range(n_rows)]
+        else:
+            fixed_plastic_rows = self.convert_per_connection_data_to_rows(
+                connection_row_indices, n_rows, fixed_plastic)
+            fp_size = self.get_n_items(fixed_plastic_rows, 2)
+            fp_data = self.get_words(fixed_plastic_rows)
+            plastic_plastic_row_data = \
+                self.convert_per_connection_data_to_rows(
+                    connection_row_indices, n_rows, plastic_plastic)
+
         plastic_headers = numpy.zeros(
             (n_rows, self._n_header_bytes), dtype="uint8")
-        plastic_plastic_row_data = self.convert_per_connection_data_to_rows(
-            connection_row_indices, n_rows, plastic_plastic)
         plastic_plastic_rows = [
             numpy.concatenate((
                 plastic_headers[i], plastic_plastic_row_data[i]))
@@ -175,13 +438,19 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
 
     def get_n_fixed_plastic_words_per_row(self, fp_size):
 
+        # An interleaved row has no fixed-plastic words, as the control words
+        # are in the plastic-plastic data
+        if self._interleaved_rows:
+            return numpy.zeros_like(fp_size, dtype="uint32")
+
         # fp_size is in half-words
         return numpy.ceil(fp_size / 2.0).astype(dtype="uint32")
 
     def get_n_synapses_in_rows(self, pp_size, fp_size):
 
         # Each fixed-plastic synapse is a half-word and fp_size is in half
-        # words so just return it
+        # words, or for interleaved rows is the number of synapses, so just
+        # return it
         return fp_size
 
     def read_plastic_synaptic_data(
@@ -189,11 +458,25 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
             fp_size, fp_data):
         n_rows = len(fp_size)
         n_synapse_type_bits = int(math.ceil(math.log(n_synapse_types, 2)))
-        data_fixed = numpy.concatenate([
-            fp_data[i].view(dtype="uint16")[0:fp_size[i]]
-            for i in range(n_rows)])
-        pp_without_headers = [
-            row.view(dtype="uint8")[self._n_header_bytes:] for row in pp_data]
+        if self._interleaved_rows:
+
+            # Split the words of each row into the control words in their
+            # lower halves and the plastic synapses in their upper halves
+            pp_halves = [
+                pp_data[i].view(dtype="uint8")[self._n_header_bytes:]
+                .view(dtype="uint16")[0:2 * fp_size[i]]
+                for i in range(n_rows)]
+            data_fixed = numpy.concatenate(
+                [halves[0::2] for halves in pp_halves])
+            pp_without_headers = [
+                numpy.ascontiguousarray(halves[1::2]) for halves in pp_halves]
+        else:
+            data_fixed = numpy.concatenate([
+                fp_data[i].view(dtype="uint16")[0:fp_size[i]]
+                for i in range(n_rows)])
+            pp_without_headers = [
+                row.view(dtype="uint8")[self._n_header_bytes:]
+                for row in pp_data]
         synapse_structure = self._timing_dependence.synaptic_structure
 
         connections = numpy.zeros(
@@ -203,8 +486,10 @@ class SynapseDynamicsSTDP(AbstractPlasticSynapseDynamics):
         connections["target"] = (data_fixed & 0xFF) + post_vertex_slice.lo_atom
         connections["weight"] = synapse_structure.read_synaptic_data(
             fp_size, pp_without_headers)
-        connections["delay"] = (data_fixed >> (8 + n_synapse_type_bits)) & 0xF
-        connections["delay"][connections["delay"] == 0] = 16
+        dendritic_delays = (data_fixed >> (8 + n_synapse_type_bits)) & 0xF
+        dendritic_delays[dendritic_delays == 0] = 16
+        axonal_delays = data_fixed >> (12 + n_synapse_type_bits)
+        connections["delay"] = dendritic_delays + axonal_delays
         return connections
 
     def get_weight_mean(
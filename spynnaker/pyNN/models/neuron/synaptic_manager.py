@@ -1,11 +1,13 @@
+from spynnaker.pyNN.utilities import batched_memory_reader
 from spynnaker.pyNN.utilities import conf
 from spynnaker.pyNN.utilities import constants
+from spynnaker.pyNN.utilities import input_buffer_losses
 from spynnaker.pyNN.utilities import utility_calls
+from spynnaker.pyNN.utilities import weight_recording
+from spynnaker.pyNN.utilities.weight_recording import RecordedBlock
 from spynnaker.pyNN import exceptions
 from spynnaker.pyNN.models.neuron import master_pop_table_generators
 from spynnaker.pyNN.utilities.running_stats import RunningStats
-from spynnaker.pyNN.models.neural_projections.connectors.one_to_one_connector \
-    import OneToOneConnector
 from spynnaker.pyNN.models.spike_source.spike_source_poisson \
     import SpikeSourcePoisson
 from spynnaker.pyNN.models.utility_models.delay_extension_vertex \
@@ -14,8 +16,12 @@ from spynnaker.pyNN.models.neuron.synapse_io.synapse_io_row_based \
     import SynapseIORowBased
 from spynnaker.pyNN.models.neural_projections.projection_partitionable_edge \
     import ProjectionPartitionableEdge
+from spynnaker.pyNN.models.neural_projections.delayed_partitionable_edge \
+    import DelayedPartitionableEdge
 from spynnaker.pyNN.models.neuron.synapse_dynamics.synapse_dynamics_static \
     import SynapseDynamicsStatic
+from spynnaker.pyNN.models.neuron.synapse_dynamics\
+    .abstract_static_synapse_dynamics import AbstractStaticSynapseDynamics
 
 from pacman.model.partitionable_graph.abstract_partitionable_vertex \
     import AbstractPartitionableVertex
@@ -40,6 +46,32 @@ _SYNAPSES_BASE_SDRAM_USAGE_IN_BYTES = 0
 _SYNAPSES_BASE_N_CPU_CYCLES_PER_NEURON = 10
 _SYNAPSES_BASE_N_CPU_CYCLES = 8
 
+# The sizes of the entries of the ring buffers and input buffers in synapses.c
+_RING_BUFFER_ENTRY_BYTES = 2
+_INPUT_BUFFER_ENTRY_BYTES = 4
+
+# The number of row DMA buffers in spike_processing.c
+_N_DMA_BUFFERS = 2
+
+# The shift of the weight in a static synapse word; the word of a row in
+# the direct matrix that has no synapse sets a bit between the delay and the
+# weight, which no synapse sets, as every other word can be a real synapse
+_SYNAPSE_WEIGHT_SHIFT = 16
+
+# The maximum number of blocks of rows that can be cached in DTCM, and the
+# size of the table of the cached blocks written after the direct matrix
+_MAX_CACHED_BLOCKS = 16
+_ROW_CACHE_TABLE_BYTES = 4 + (_MAX_CACHED_BLOCKS * 8)
+
+# The size of the entries of the input spike buffer in in_spikes.h
+_INPUT_SPIKE_ENTRY_BYTES = 4
+
+# The input buffer region holds the policy, the high water mark, the drain
+# guard and the number of key ranges, followed by the key, mask and priority
+# of each range
+_INPUT_BUFFER_HEADER_BYTES = 16
+_INPUT_BUFFER_KEY_RANGE_BYTES = 12
+
 
 class SynapticManager(object):
     """ Deals with synapses
@@ -47,7 +79,7 @@ class SynapticManager(object):
 
     def __init__(self, synapse_type, machine_time_step, ring_buffer_sigma,
                  spikes_per_second, population_table_type=None,
-                 synapse_io=None):
+                 synapse_io=None, incoming_spike_buffer_size=None):
 
         self._synapse_type = synapse_type
         self._ring_buffer_sigma = ring_buffer_sigma
@@ -75,6 +107,33 @@ class SynapticManager(object):
         if self._spikes_per_second is None:
             self._spikes_per_second = conf.config.getfloat(
                 "Simulation", "spikes_per_second")
+        self._direct_matrix_max_bytes = conf.config.getint(
+            "Simulation", "direct_matrix_max_bytes")
+        self._row_cache_max_bytes = conf.config.getint(
+            "Simulation", "row_cache_max_bytes")
+
+        # The input spike buffer is sized from the expected input unless the
+        # population sets the size
+        self._incoming_spike_buffer_size = incoming_spike_buffer_size
+        self._adaptive_incoming_spike_buffer = False
+        if incoming_spike_buffer_size is None:
+            self._incoming_spike_buffer_size = conf.config.getint(
+                "Simulation", "incoming_spike_buffer_size")
+            self._adaptive_incoming_spike_buffer = conf.config.getboolean(
+                "Simulation", "adaptive_incoming_spike_buffer")
+        self._incoming_spike_buffer_max_size = conf.config.getint(
+            "Simulation", "incoming_spike_buffer_max_size")
+        policy = conf.config.get(
+            "Simulation", "incoming_spike_buffer_overflow_policy")
+        if policy not in input_buffer_losses.POLICIES:
+            raise exceptions.ConfigurationException(
+                "incoming_spike_buffer_overflow_policy must be one of {}"
+                .format(", ".join(input_buffer_losses.POLICIES)))
+        self._input_buffer_policy = input_buffer_losses.POLICIES.index(policy)
+        self._input_buffer_high_water = conf.config.getfloat(
+            "Simulation", "incoming_spike_buffer_high_water")
+        self._input_drain_guard_us = conf.config.getint(
+            "Simulation", "incoming_spike_drain_guard_us")
         self._spikes_per_tick = max(
             1.0,
             self._spikes_per_second /
@@ -89,6 +148,25 @@ class SynapticManager(object):
         self._delay_key_index = dict()
         self._retrieved_blocks = dict()
 
+        # The blocks read before the last run that only hold the right delays
+        self._stale_blocks = set()
+
+        # The addresses of the synaptic matrix of each core, and the blocks
+        # of each key, found when blocks are first read after mapping
+        self._synaptic_matrix_addresses = dict()
+        self._synaptic_block_items = dict()
+
+        # How synaptic blocks are read back
+        self._synaptic_read_max_bytes = conf.config.getint(
+            "Buffers", "synaptic_read_max_bytes")
+        self._synaptic_read_max_gap_bytes = conf.config.getint(
+            "Buffers", "synaptic_read_max_gap_bytes")
+        self._synaptic_read_threads = conf.config.getint(
+            "Buffers", "synaptic_read_threads")
+
+        # The blocks of rows whose weight changes each core records
+        self._weight_recording_blocks = dict()
+
         # A list of connection holders to be filled in pre-run, indexed by
         # the edge the connection is for
         self._pre_run_connection_holders = defaultdict(list)
@@ -114,6 +192,13 @@ class SynapticManager(object):
                 "Synapse dynamics must match exactly when using multiple edges"
                 "to the same population")
 
+    @property
+    def weight_recording_blocks(self):
+        """ The RecordedBlock of each block of rows whose weight changes\
+            are recorded, by placement
+        """
+        return self._weight_recording_blocks
+
     @property
     def synapse_type(self):
         return self._synapse_type
@@ -147,15 +232,260 @@ class SynapticManager(object):
         self._pre_run_connection_holders[(edge, synapse_info)].append(
             connection_holder)
 
-    def get_n_cpu_cycles(self, vertex_slice, graph):
+    def _get_estimated_row_lengths(self, post_vertex_slice, in_edges):
+        """ Get an estimate of the maximum row length of each projection\
+            into the vertex slice from each estimated pre-vertex slice
 
-        # TODO: Calculate this correctly
-        return 0
+        :return: iterable of (in_edge, pre_vertex_slice, synapse_info,\
+            row_length)
+        """
+        for in_edge in in_edges:
+            if isinstance(in_edge, ProjectionPartitionableEdge):
+                pre_slices, post_slices, post_slice_index = \
+                    self._get_estimated_slices(in_edge, post_vertex_slice)
+                for pre_slice_index, pre_vertex_slice in enumerate(
+                        pre_slices):
+                    for synapse_info in in_edge.synapse_information:
+                        row_length = synapse_info.connector\
+                            .get_n_connections_from_pre_vertex_maximum(
+                                pre_slices, pre_slice_index, post_slices,
+                                post_slice_index, pre_vertex_slice,
+                                post_vertex_slice)
+                        yield (in_edge, pre_vertex_slice, synapse_info,
+                               row_length)
+
+    def get_n_cpu_cycles(self, vertex_slice, in_edges):
+        """ Get an estimate of the CPU cycles used per timestep to process\
+            the synapses of the vertex slice, from the number of rows and\
+            synapses expected to arrive each timestep and the cost of each\
+            to the synapse dynamics
+        """
+        n_synapse_types = self._synapse_type.get_n_synapse_types()
+        n_cycles = (
+            _SYNAPSES_BASE_N_CPU_CYCLES +
+            (_SYNAPSES_BASE_N_CPU_CYCLES_PER_NEURON * vertex_slice.n_atoms *
+             n_synapse_types))
+
+        timestep_in_seconds = self._machine_time_step / 1000000.0
+        for in_edge, pre_vertex_slice, synapse_info, row_length in \
+                self._get_estimated_row_lengths(vertex_slice, in_edges):
+            if row_length == 0:
+                continue
+
+            # Delayed connections arrive as separate rows from the delay
+            # extension
+            n_rows_per_spike = 1
+            if in_edge.n_delay_stages > 0:
+                n_rows_per_spike = 2
+
+            spikes_per_tick = (
+                self._get_spikes_per_second(
+                    in_edge.pre_vertex, pre_vertex_slice) *
+                timestep_in_seconds * pre_vertex_slice.n_atoms)
+            dynamics = synapse_info.synapse_dynamics
+            n_cycles += spikes_per_tick * (
+                (dynamics.get_n_cpu_cycles_per_row() * n_rows_per_spike) +
+                (dynamics.get_n_cpu_cycles_per_synapse() * row_length))
+
+        return int(math.ceil(n_cycles))
+
+    def get_dtcm_usage_in_bytes(self, vertex_slice, in_edges):
+        """ Get an estimate of the DTCM used by the synapses of the vertex\
+            slice, counting the statically sized ring buffers, the row DMA\
+            buffers, the input spike buffer, the master population table, the\
+            direct matrix and the synapse dynamics
+        """
+        n_synapse_types = self._synapse_type.get_n_synapse_types()
+        synapse_type_bits = int(math.ceil(math.log(n_synapse_types, 2)))
+        delay_bits = int(math.log(constants.MAX_SUPPORTED_DELAY_TICS, 2))
+        ring_buffer_bytes = _RING_BUFFER_ENTRY_BYTES * (2 ** (
+            delay_bits + synapse_type_bits + constants.SYNAPSE_INDEX_BITS))
+        input_buffer_bytes = _INPUT_BUFFER_ENTRY_BYTES * (2 ** (
+            synapse_type_bits + constants.SYNAPSE_INDEX_BITS))
+
+        # Direct rows are read from DTCM; all other rows are read into one of
+        # the DMA buffers, which are as big as the longest row
+        max_row_n_words = 0
+        n_direct_words = 0
+        n_cacheable_bytes = 0
+        for synapse_info, blocks in self._get_estimated_row_blocks(
+                vertex_slice, in_edges):
+            dynamics = synapse_info.synapse_dynamics
+            is_direct, n_direct_words = self._choose_direct_blocks(
+                synapse_info, blocks, n_direct_words)
+            for (row_length, n_rows), direct in zip(blocks, is_direct):
+                if n_rows == 0 or direct:
+                    continue
+                if isinstance(dynamics, AbstractStaticSynapseDynamics):
+                    row_n_words = dynamics.get_n_words_for_static_connections(
+                        row_length)
+                    max_row_n_words = max(max_row_n_words, row_n_words)
+                    n_cacheable_bytes += n_rows * 4 * (
+                        self._population_table_type.get_allowed_row_length(
+                            row_n_words) + constants.SYNAPTIC_ROW_HEADER_WORDS)
+                else:
+                    max_row_n_words = max(
+                        max_row_n_words,
+                        dynamics.get_n_words_for_plastic_connections(
+                            row_length))
+        max_row_n_words = (
+            self._population_table_type.get_allowed_row_length(
+                max_row_n_words) + constants.SYNAPTIC_ROW_HEADER_WORDS)
 
-    def get_dtcm_usage_in_bytes(self, vertex_slice, graph):
+        return (
+            _SYNAPSES_BASE_DTCM_USAGE_IN_BYTES +
+            ring_buffer_bytes + input_buffer_bytes +
+            (self._synapse_type.get_dtcm_usage_per_neuron_in_bytes() *
+             vertex_slice.n_atoms) +
+            (_N_DMA_BUFFERS * max_row_n_words * 4) +
+            (n_direct_words * 4) +
+            min(n_cacheable_bytes, self._row_cache_max_bytes) +
+            (_INPUT_SPIKE_ENTRY_BYTES *
+             self.get_incoming_spike_buffer_size(vertex_slice, in_edges)) +
+            self._get_input_buffer_region_size(vertex_slice, in_edges) +
+            self._get_weight_recording_region_size(vertex_slice, in_edges) +
+            self._population_table_type.get_master_population_table_size(
+                vertex_slice, in_edges) +
+            self._synapse_dynamics.get_dtcm_usage_in_bytes(
+                vertex_slice.n_atoms))
+
+    def _get_estimated_row_blocks(self, post_vertex_slice, in_edges):
+        """ Get an estimate of the blocks of rows that are written for each\
+            projection into the vertex slice from each estimated pre-vertex\
+            slice; these are the undelayed rows and the rows from the delay\
+            extension, each with its own maximum row length as written
+
+        :return: iterable of (synapse_info, [(row_length, n_rows), ...]),\
+            where n_rows is 0 for a block with no connections, which is not\
+            written
+        """
+        max_delay = self._synapse_io.get_maximum_delay_supported_in_ms()
+        min_delay_for_delay_extension = (
+            max_delay + numpy.finfo(numpy.double).tiny)
+        for in_edge in in_edges:
+            if isinstance(in_edge, ProjectionPartitionableEdge):
+                n_delay_stages = in_edge.n_delay_stages
+                pre_slices, post_slices, post_slice_index = \
+                    self._get_estimated_slices(in_edge, post_vertex_slice)
+                for pre_slice_index, pre_vertex_slice in enumerate(
+                        pre_slices):
+                    for synapse_info in in_edge.synapse_information:
+                        connector = synapse_info.connector
+                        row_length = connector\
+                            .get_n_connections_from_pre_vertex_maximum(
+                                pre_slices, pre_slice_index, post_slices,
+                                post_slice_index, pre_vertex_slice,
+                                post_vertex_slice, 0, max_delay)
+                        blocks = [(
+                            row_length,
+                            pre_vertex_slice.n_atoms if row_length > 0
+                            else 0)]
+                        if n_delay_stages > 0:
+                            row_length = connector\
+                                .get_n_connections_from_pre_vertex_maximum(
+                                    pre_slices, pre_slice_index, post_slices,
+                                    post_slice_index, pre_vertex_slice,
+                                    post_vertex_slice,
+                                    min_delay_for_delay_extension,
+                                    max_delay * (n_delay_stages + 1))
+                            blocks.append((
+                                row_length,
+                                pre_vertex_slice.n_atoms * n_delay_stages
+                                if row_length > 0 else 0))
+                        yield synapse_info, blocks
+
+    def _choose_direct_blocks(self, synapse_info, blocks, n_direct_words):
+        """ Choose which of the blocks of rows of a projection from a\
+            pre-vertex slice go in the direct matrix, taking the blocks in\
+            the order that they are written; the estimate of the DTCM used\
+            and the writing of the matrix both use this, so that they agree
+
+        :param blocks: list of (row_length, n_rows) of each block, where\
+            n_rows is 0 for a block that is not written
+        :param n_direct_words: The words of the direct matrix already used
+        :return: tuple of (list of whether each block is direct, words of\
+            the direct matrix used after the blocks)
+        """
+        is_direct = list()
+        for row_length, n_rows in blocks:
+            direct = n_rows > 0 and self._can_use_direct_rows(
+                synapse_info, row_length, n_direct_words, n_rows)
+            if direct:
+                n_direct_words += n_rows
+            is_direct.append(direct)
+        return is_direct, n_direct_words
+
+    def _can_use_direct_rows(
+            self, synapse_info, row_length, n_direct_words, n_rows):
+        """ Determine if a block of rows can be written to the direct matrix,\
+            which is copied to DTCM so that the rows are read without a DMA;\
+            this is possible for static rows of at most one synapse, while\
+            the direct matrix stays within direct_matrix_max_bytes
+        """
+        return (
+            row_length <= 1 and
+            isinstance(synapse_info.synapse_dynamics,
+                       AbstractStaticSynapseDynamics) and
+            self._get_direct_row_empty() is not None and
+            (n_direct_words + n_rows) * 4 <= self._direct_matrix_max_bytes)
+
+    def _get_direct_row_empty(self):
+        """ Get the word of a row in the direct matrix that has no synapse,\
+            as DIRECT_ROW_EMPTY in spike_processing.c: the bit above the\
+            delay, type and index of a static synapse
+
+        :return: the word, or None if the delay, type and index leave no bit\
+            below the weight, so that rows can't be direct
+        """
+        n_synapse_types = self._synapse_type.get_n_synapse_types()
+        empty_bit = (
+            int(math.log(constants.MAX_SUPPORTED_DELAY_TICS, 2)) +
+            int(math.ceil(math.log(n_synapse_types, 2))) +
+            constants.SYNAPSE_INDEX_BITS)
+        if empty_bit >= _SYNAPSE_WEIGHT_SHIFT:
+            return None
+        return 1 << empty_bit
 
-        # TODO: Calculate this correctly
-        return 0
+    def _get_direct_rows(self, row_data):
+        """ Get the direct matrix words of a block of static rows of length\
+            one, marking the rows with no synapse as empty
+        """
+        rows = row_data.reshape(-1, constants.SYNAPTIC_ROW_HEADER_WORDS + 1)
+        return numpy.where(
+            rows[:, 1] == 0, self._get_direct_row_empty(),
+            rows[:, constants.SYNAPTIC_ROW_HEADER_WORDS]).astype("uint32")
+
+    def _get_rows_from_direct_block(self, block):
+        """ Get the static rows of length one of a block read from the\
+            direct matrix, with no synapse in the rows marked as empty
+
+        :return: the rows, with the row headers, as bytes
+        """
+        single_block = numpy.asarray(block, dtype="uint8").view("uint32")
+        numpy_block = numpy.zeros(
+            (len(single_block), constants.SYNAPTIC_ROW_HEADER_WORDS + 1),
+            dtype="uint32")
+        numpy_block[:, constants.SYNAPTIC_ROW_HEADER_WORDS] = single_block
+        numpy_block[:, 1] = single_block != self._get_direct_row_empty()
+        return bytearray(numpy_block.tobytes())
+
+    def _choose_cached_blocks(self, candidates):
+        """ Choose the blocks of static rows to copy to DTCM, preferring those\
+            with the most spikes per second for each byte of a row
+
+        :param candidates: list of (spikes per second per row byte, offset,\
+            size in bytes) of the blocks that could be cached
+        :return: list of (offset, size in bytes) of the chosen blocks
+        """
+        chosen = list()
+        n_bytes_chosen = 0
+        for _, offset, n_bytes in sorted(candidates, reverse=True):
+            if len(chosen) == _MAX_CACHED_BLOCKS:
+                break
+            if n_bytes_chosen + n_bytes <= self._row_cache_max_bytes:
+                chosen.append((offset, n_bytes))
+                n_bytes_chosen += n_bytes
+        return sorted(chosen)
 
     def _get_synapse_params_size(self, vertex_slice):
         per_neuron_usage = (
@@ -174,7 +504,9 @@ class SynapticManager(object):
         """ Get the exact size all of the synaptic blocks
         """
 
-        memory_size = self._get_static_synaptic_matrix_sdram_requirements()
+        memory_size = (
+            self._get_static_synaptic_matrix_sdram_requirements() +
+            _ROW_CACHE_TABLE_BYTES)
 
         # Go through the subedges and add up the memory
         for subedge in subvertex_in_edges:
@@ -197,43 +529,71 @@ class SynapticManager(object):
 
         return memory_size
 
+    @staticmethod
+    def _get_estimated_slices(in_edge, post_vertex_slice):
+        """ Get an estimate of the slices of the pre- and post-vertices of an\
+            edge before partitioning is complete
+
+        :return: tuple of (pre_slices, post_slices, post_slice_index)
+        """
+
+        # Get an estimate of the number of post sub-vertices by
+        # assuming that all of them are the same size as this one
+        post_slices = [Slice(
+            lo_atom, min(
+                in_edge.post_vertex.n_atoms,
+                lo_atom + post_vertex_slice.n_atoms - 1))
+            for lo_atom in range(
+                0, in_edge.post_vertex.n_atoms,
+                post_vertex_slice.n_atoms)]
+        post_slice_index = int(math.floor(
+            float(post_vertex_slice.lo_atom) /
+            float(post_vertex_slice.n_atoms)))
+
+        # Get an estimate of the number of pre-sub-vertices - clearly
+        # this will not be correct if the SDRAM usage is high!
+        # TODO: Can be removed once we move to population-based keys
+        n_atoms_per_subvertex = sys.maxint
+        if isinstance(in_edge.pre_vertex, AbstractPartitionableVertex):
+            n_atoms_per_subvertex = \
+                in_edge.pre_vertex.get_max_atoms_per_core()
+        if in_edge.pre_vertex.n_atoms < n_atoms_per_subvertex:
+            n_atoms_per_subvertex = in_edge.pre_vertex.n_atoms
+        pre_slices = [Slice(
+            lo_atom, min(
+                in_edge.pre_vertex.n_atoms,
+                lo_atom + n_atoms_per_subvertex - 1))
+            for lo_atom in range(
+                0, in_edge.pre_vertex.n_atoms, n_atoms_per_subvertex)]
+        return pre_slices, post_slices, post_slice_index
+
+    def _get_spikes_per_second(self, pre_vertex, pre_vertex_slice):
+        """ Get the maximum expected firing rate of the neurons in a slice of\
+            a pre-vertex; this is known for Poisson sources, and otherwise\
+            the configured spikes_per_second
+        """
+        if not isinstance(pre_vertex, SpikeSourcePoisson):
+            return self._spikes_per_second
+        spikes_per_second = pre_vertex.rate
+        if hasattr(spikes_per_second, "__getitem__"):
+            return max(spikes_per_second)
+        if isinstance(spikes_per_second, RandomDistribution):
+            return utility_calls.get_maximum_probable_value(
+                spikes_per_second, pre_vertex_slice.n_atoms)
+        return spikes_per_second
+
     def _get_estimate_synaptic_blocks_size(self, post_vertex_slice, in_edges):
         """ Get an estimate of the synaptic blocks memory size
         """
 
-        memory_size = self._get_static_synaptic_matrix_sdram_requirements()
+        memory_size = (
+            self._get_static_synaptic_matrix_sdram_requirements() +
+            _ROW_CACHE_TABLE_BYTES)
 
         for in_edge in in_edges:
             if isinstance(in_edge, ProjectionPartitionableEdge):
-
-                # Get an estimate of the number of post sub-vertices by
-                # assuming that all of them are the same size as this one
-                post_slices = [Slice(
-                    lo_atom, min(
-                        in_edge.post_vertex.n_atoms,
-                        lo_atom + post_vertex_slice.n_atoms - 1))
-                    for lo_atom in range(
-                        0, in_edge.post_vertex.n_atoms,
-                        post_vertex_slice.n_atoms)]
-                post_slice_index = int(math.floor(
-                    float(post_vertex_slice.lo_atom) /
-                    float(post_vertex_slice.n_atoms)))
-
-                # Get an estimate of the number of pre-sub-vertices - clearly
-                # this will not be correct if the SDRAM usage is high!
-                # TODO: Can be removed once we move to population-based keys
-                n_atoms_per_subvertex = sys.maxint
-                if isinstance(in_edge.pre_vertex, AbstractPartitionableVertex):
-                    n_atoms_per_subvertex = \
-                        in_edge.pre_vertex.get_max_atoms_per_core()
-                if in_edge.pre_vertex.n_atoms < n_atoms_per_subvertex:
-                    n_atoms_per_subvertex = in_edge.pre_vertex.n_atoms
-                pre_slices = [Slice(
-                    lo_atom, min(
-                        in_edge.pre_vertex.n_atoms,
-                        lo_atom + n_atoms_per_subvertex - 1))
-                    for lo_atom in range(
-                        0, in_edge.pre_vertex.n_atoms, n_atoms_per_subvertex)]
+                pre_slices, post_slices, post_slice_index = \
+                    self._get_estimated_slices(in_edge, post_vertex_slice)
 
                 pre_slice_index = 0
                 for pre_vertex_slice in pre_slices:
@@ -279,12 +639,158 @@ class SynapticManager(object):
             self._get_synapse_params_size(vertex_slice) +
             self._get_synapse_dynamics_parameter_size(vertex_slice, in_edges) +
             self._get_estimate_synaptic_blocks_size(vertex_slice, in_edges) +
+            self._get_input_buffer_region_size(vertex_slice, in_edges) +
+            self._get_weight_recording_region_size(vertex_slice, in_edges) +
             self._population_table_type.get_master_population_table_size(
                 vertex_slice, in_edges))
 
+    def _get_expected_incoming_spikes_per_tick(self, vertex_slice, in_edges):
+        """ Get the mean number of spikes expected to arrive at the vertex\
+            slice in each timestep
+        """
+        timestep_in_seconds = self._machine_time_step / 1000000.0
+        n_spikes = 0.0
+        counted = set()
+        for in_edge, pre_vertex_slice, _, row_length in \
+                self._get_estimated_row_lengths(vertex_slice, in_edges):
+            if row_length == 0 or (in_edge, pre_vertex_slice.lo_atom) in \
+                    counted:
+                continue
+            counted.add((in_edge, pre_vertex_slice.lo_atom))
+
+            # Delayed spikes arrive again from the delay extension
+            n_packets_per_spike = 1
+            if in_edge.n_delay_stages > 0:
+                n_packets_per_spike = 2
+            n_spikes += (
+                self._get_spikes_per_second(
+                    in_edge.pre_vertex, pre_vertex_slice) *
+                timestep_in_seconds * pre_vertex_slice.n_atoms *
+                n_packets_per_spike)
+        return n_spikes
+
+    def get_incoming_spike_buffer_size(self, vertex_slice, in_edges):
+        """ Get the number of spikes that the input spike buffer of the\
+            vertex slice holds.  Unless the population sets the size, this\
+            is enough for the spikes expected to arrive in a timestep plus\
+            ring_buffer_sigma standard deviations of Poisson arrivals, kept\
+            between the configured incoming_spike_buffer_size and\
+            incoming_spike_buffer_max_size.  The core rounds the size up to a\
+            power of two, so this does too.
+        """
+        n_spikes = self._incoming_spike_buffer_size
+        if self._adaptive_incoming_spike_buffer:
+            expected = self._get_expected_incoming_spikes_per_tick(
+                vertex_slice, in_edges)
+            upper_bound = int(math.ceil(
+                expected + (self._ring_buffer_sigma * math.sqrt(expected))))
+            n_spikes = max(n_spikes, min(
+                upper_bound, self._incoming_spike_buffer_max_size))
+        size = 1
+        while size < n_spikes:
+            size <<= 1
+        return size
+
+    def _get_input_buffer_region_size(self, vertex_slice, in_edges):
+        """ Get an estimate of the size of the input buffer region, with a\
+            key range for each estimated pre-vertex slice of each edge
+        """
+        n_key_ranges = 0
+        for in_edge in in_edges:
+            if isinstance(in_edge, (ProjectionPartitionableEdge,
+                                    DelayedPartitionableEdge)):
+                pre_slices, _, _ = self._get_estimated_slices(
+                    in_edge, vertex_slice)
+                n_key_ranges += len(pre_slices)
+        return (_INPUT_BUFFER_HEADER_BYTES +
+                (n_key_ranges * _INPUT_BUFFER_KEY_RANGE_BYTES))
+
+    @staticmethod
+    def _get_n_weight_recording_blocks(edge):
+        """ Get the number of blocks of rows whose weight changes are\
+            recorded for each pre-vertex slice of an edge: one for each\
+            recorded projection, and one more for its delayed rows
+        """
+        if not isinstance(edge, ProjectionPartitionableEdge):
+            return 0
+        n_recorded = len([
+            synapse_info for synapse_info in edge.synapse_information
+            if synapse_info.record_weights])
+        if edge.n_delay_stages > 0:
+            return n_recorded * 2
+        return n_recorded
+
+    def _get_weight_recording_region_size(self, vertex_slice, in_edges):
+        """ Get an estimate of the size of the weight recording region, with\
+            the blocks of each estimated pre-vertex slice of each edge
+        """
+        n_blocks = 0
+        for in_edge in in_edges:
+            n_edge_blocks = self._get_n_weight_recording_blocks(in_edge)
+            if n_edge_blocks > 0:
+                pre_slices, _, _ = self._get_estimated_slices(
+                    in_edge, vertex_slice)
+                n_blocks += len(pre_slices) * n_edge_blocks
+        return weight_recording.get_params_size(n_blocks)
+
+    def _get_input_key_ranges(
+            self, subvertex, partitioned_graph, graph_mapper, routing_info):
+        """ Get the key ranges of the projections into the subvertex, with\
+            the sources expected to send the most spikes first, as these are\
+            searched first by the core and have their losses reported\
+            separately
+
+        :return: list of (key, mask, priority, edge label)
+        """
+        key_ranges = list()
+        for subedge in partitioned_graph.incoming_subedges_from_subvertex(
+                subvertex):
+            edge = graph_mapper.get_partitionable_edge_from_partitioned_edge(
+                subedge)
+            if not isinstance(edge, (ProjectionPartitionableEdge,
+                                     DelayedPartitionableEdge)):
+                continue
+            pre_vertex = edge.pre_vertex
+            if isinstance(pre_vertex, DelayExtensionVertex):
+                pre_vertex = pre_vertex.source_vertex
+            pre_vertex_slice = graph_mapper.get_subvertex_slice(
+                subedge.pre_subvertex)
+            spikes_per_second = (
+                self._get_spikes_per_second(pre_vertex, pre_vertex_slice) *
+                pre_vertex_slice.n_atoms)
+            priority = max(
+                synapse_info.input_priority
+                for synapse_info in edge.synapse_information)
+            partition = partitioned_graph.get_partition_of_subedge(subedge)
+            for key_and_mask in \
+                    routing_info.get_keys_and_masks_from_partition(partition):
+                key_ranges.append((
+                    spikes_per_second, key_and_mask.key, key_and_mask.mask,
+                    priority, edge.label))
+        key_ranges.sort(key=lambda key_range: key_range[0], reverse=True)
+        return [key_range[1:] for key_range in key_ranges]
+
+    def _write_input_buffer_policy(
+            self, spec, input_buffer_region, key_ranges,
+            incoming_spike_buffer_size):
+        spec.comment("\nWriting Input Buffer Policy:\n")
+        spec.switch_write_focus(input_buffer_region)
+        high_water = min(
+            incoming_spike_buffer_size - 1,
+            int(incoming_spike_buffer_size * self._input_buffer_high_water))
+        spec.write_value(self._input_buffer_policy)
+        spec.write_value(max(0, high_water))
+        spec.write_value(self._input_drain_guard_us)
+        spec.write_value(len(key_ranges))
+        for key, mask, priority, _ in key_ranges:
+            spec.write_value(key)
+            spec.write_value(mask)
+            spec.write_value(priority)
+
     def _reserve_memory_regions(
             self, spec, vertex, subvertex, vertex_slice, graph, sub_graph,
-            all_syn_block_sz, graph_mapper):
+            all_syn_block_sz, graph_mapper, n_input_key_ranges,
+            n_weight_recording_blocks):
 
         spec.reserve_memory_region(
             region=constants.POPULATION_BASED_REGIONS.SYNAPSE_PARAMS.value,
@@ -314,8 +820,19 @@ class SynapticManager(object):
                                                          .value,
                 size=synapse_dynamics_sz, label='synapseDynamicsParams')
 
+        spec.reserve_memory_region(
+            region=constants.POPULATION_BASED_REGIONS.INPUT_BUFFER.value,
+            size=(_INPUT_BUFFER_HEADER_BYTES +
+                  (n_input_key_ranges * _INPUT_BUFFER_KEY_RANGE_BYTES)),
+            label='InputBuffer')
+
+        spec.reserve_memory_region(
+            region=constants.POPULATION_BASED_REGIONS.WEIGHT_RECORDING.value,
+            size=weight_recording.get_params_size(n_weight_recording_blocks),
+            label='WeightRecording')
+
     def get_number_of_mallocs_used_by_dsg(self):
-        return 4
+        return 6
 
     @staticmethod
     def _ring_buffer_expected_upper_bound(
@@ -459,14 +976,8 @@ class SynapticManager(object):
                     spikes_per_tick = self._spikes_per_tick
                     spikes_per_second = self._spikes_per_second
                     if isinstance(edge.pre_vertex, SpikeSourcePoisson):
-                        spikes_per_second = edge.pre_vertex.rate
-                        if hasattr(spikes_per_second, "__getitem__"):
-                            spikes_per_second = max(spikes_per_second)
-                        elif isinstance(spikes_per_second, RandomDistribution):
-                            spikes_per_second = \
-                                utility_calls.get_maximum_probable_value(
-                                    spikes_per_second,
-                                    pre_vertex_slice.n_atoms)
+                        spikes_per_second = self._get_spikes_per_second(
+                            edge.pre_vertex, pre_vertex_slice)
                         prob = 1.0 - ((1.0 / 100.0) / pre_vertex_slice.n_atoms)
                         spikes_per_tick = (
                             spikes_per_second /
@@ -572,6 +1083,9 @@ class SynapticManager(object):
             graph_mapper, partitioned_graph):
         """ Simultaneously generates both the master population table and
             the synaptic matrix.
+
+        :return: The RecordedBlock of each block of rows whose weight\
+            changes are to be recorded
         """
         spec.comment(
             "\nWriting Synaptic Matrix and Master Population Table:\n")
@@ -595,6 +1109,12 @@ class SynapticManager(object):
         spec.write_value(0)
         next_single_start_position = 0
 
+        # Blocks of static rows that could be copied to DTCM
+        row_cache_candidates = list()
+
+        # Blocks of plastic rows whose weight changes are recorded
+        recorded_blocks = list()
+
         # For each subedge into the subvertex, create a synaptic list
         for subedge in in_subedges:
 
@@ -643,6 +1163,16 @@ class SynapticManager(object):
                             connection_holder.add_connections(connections)
                             connection_holder.finish()
 
+                    (is_direct, is_delayed_direct), _ = \
+                        self._choose_direct_blocks(
+                            synapse_info, [
+                                (row_length, len(row_data) and
+                                 pre_vertex_slice.n_atoms),
+                                (delayed_row_length, len(delayed_row_data) and
+                                 pre_vertex_slice.n_atoms *
+                                 edge.n_delay_stages)],
+                            next_single_start_position)
+
                     if len(row_data) > 0:
                         partition = partitioned_graph.get_partition_of_subedge(
                             subedge)
@@ -650,9 +1180,8 @@ class SynapticManager(object):
                             routing_info.get_keys_and_masks_from_partition(
                                 partition)
 
-                        if (row_length == 1 and isinstance(
-                                synapse_info.connector, OneToOneConnector)):
-                            single_rows = row_data.reshape(-1, 4)[:, 3]
+                        if is_direct:
+                            single_rows = self._get_direct_rows(row_data)
                             single_synapses.append(single_rows)
                             self._population_table_type\
                                 .update_master_population_table(
@@ -670,6 +1199,15 @@ class SynapticManager(object):
                                 .update_master_population_table(
                                     spec, next_block_start_address, row_length,
                                     keys_and_masks, master_pop_table_region)
+                            self._add_row_cache_candidate(
+                                row_cache_candidates, synapse_info, edge,
+                                pre_vertex_slice, next_block_start_address,
+                                row_length, len(row_data) * 4)
+                            self._add_recorded_block(
+                                recorded_blocks, synapse_info,
+                                pre_vertex_slice, post_vertex_slice,
+                                next_block_start_address, row_length,
+                                len(row_data) * 4, weight_scales)
                             next_block_start_address += len(row_data) * 4
                     del row_data
 
@@ -684,9 +1222,9 @@ class SynapticManager(object):
                             (edge.pre_vertex, pre_vertex_slice.lo_atom,
                              pre_vertex_slice.hi_atom)]
 
-                        if (delayed_row_length == 1 and isinstance(
-                                synapse_info.connector, OneToOneConnector)):
-                            single_rows = delayed_row_data.reshape(-1, 4)[:, 3]
+                        if is_delayed_direct:
+                            single_rows = self._get_direct_rows(
+                                delayed_row_data)
                             single_synapses.append(single_rows)
                             self._population_table_type\
                                 .update_master_population_table(
@@ -705,6 +1243,16 @@ class SynapticManager(object):
                                     spec, next_block_start_address,
                                     delayed_row_length, keys_and_masks,
                                     master_pop_table_region)
+                            self._add_row_cache_candidate(
+                                row_cache_candidates, synapse_info, edge,
+                                pre_vertex_slice, next_block_start_address,
+                                delayed_row_length,
+                                len(delayed_row_data) * 4)
+                            self._add_recorded_block(
+                                recorded_blocks, synapse_info,
+                                pre_vertex_slice, post_vertex_slice,
+                                next_block_start_address, delayed_row_length,
+                                len(delayed_row_data) * 4, weight_scales)
                             next_block_start_address += len(
                                 delayed_row_data) * 4
                     del delayed_row_data
@@ -727,14 +1275,50 @@ class SynapticManager(object):
         else:
             spec.write_value(0)
 
+        # Write the blocks of rows to copy to DTCM after the direct matrix
+        cached_blocks = self._choose_cached_blocks(row_cache_candidates)
+        spec.write_value(len(cached_blocks))
+        for offset, n_bytes in cached_blocks:
+            spec.write_value(offset)
+            spec.write_value(n_bytes)
+
         # Write the position of the single synapses
         spec.set_write_pointer(0)
         spec.write_value(next_block_start_address)
+        return recorded_blocks
 
+    def _add_row_cache_candidate(
+            self, candidates, synapse_info, edge, pre_vertex_slice, offset,
+            row_length, n_bytes):
+        """ Add a block of rows that has been written to the candidates for\
+            the row cache, if the rows are static
+        """
+        if isinstance(synapse_info.synapse_dynamics,
+                      AbstractStaticSynapseDynamics):
+            row_n_bytes = 4 * (
+                row_length + constants.SYNAPTIC_ROW_HEADER_WORDS)
+            spikes_per_second = self._get_spikes_per_second(
+                edge.pre_vertex, pre_vertex_slice)
+            candidates.append(
+                (float(spikes_per_second) / row_n_bytes, offset, n_bytes))
+
+    def _add_recorded_block(
+            self, recorded_blocks, synapse_info, pre_vertex_slice,
+            post_vertex_slice, offset, row_length, n_bytes, weight_scales):
+        """ Add a block of rows that has been written to the blocks whose\
+            weight changes are recorded, if its projection is recorded
+        """
+        if synapse_info.record_weights:
+            recorded_blocks.append(RecordedBlock(
+                synapse_info, offset, n_bytes,
+                self._synapse_io.get_block_n_bytes(row_length, 1),
+                pre_vertex_slice, post_vertex_slice,
+                weight_scales[synapse_info.synapse_type]))
 
     def write_data_spec(
             self, spec, vertex, post_vertex_slice, subvertex, placement,
-            partitioned_graph, graph, routing_info, graph_mapper, input_type):
+            partitioned_graph, graph, routing_info, graph_mapper, input_type,
+            weight_recording_interval=0):
 
         # Create an index of delay keys into this subvertex
         for subedge in partitioned_graph.incoming_subedges_from_subvertex(
@@ -759,152 +1343,264 @@ class SynapticManager(object):
         all_syn_block_sz = self._get_exact_synaptic_blocks_size(
             post_slices, post_slice_index, post_vertex_slice, graph_mapper,
             subvert_in_edges)
+        key_ranges = self._get_input_key_ranges(
+            subvertex, partitioned_graph, graph_mapper, routing_info)
+        n_weight_recording_blocks = sum(
+            self._get_n_weight_recording_blocks(
+                graph_mapper.get_partitionable_edge_from_partitioned_edge(
+                    subedge))
+            for subedge in subvert_in_edges)
         self._reserve_memory_regions(
             spec, vertex, subvertex, post_vertex_slice, graph,
-            partitioned_graph, all_syn_block_sz, graph_mapper)
+            partitioned_graph, all_syn_block_sz, graph_mapper,
+            len(key_ranges), n_weight_recording_blocks)
 
         weight_scales = self._write_synapse_parameters(
             spec, subvertex, partitioned_graph, graph_mapper, post_slices,
             post_slice_index, post_vertex_slice, input_type)
 
-        self._write_synaptic_matrix_and_master_population_table(
-            spec, post_slices, post_slice_index, subvertex, post_vertex_slice,
-            all_syn_block_sz, weight_scales,
-            constants.POPULATION_BASED_REGIONS.POPULATION_TABLE.value,
-            constants.POPULATION_BASED_REGIONS.SYNAPTIC_MATRIX.value,
-            routing_info, graph_mapper, partitioned_graph)
+        recorded_blocks = \
+            self._write_synaptic_matrix_and_master_population_table(
+                spec, post_slices, post_slice_index, subvertex,
+                post_vertex_slice, all_syn_block_sz, weight_scales,
+                constants.POPULATION_BASED_REGIONS.POPULATION_TABLE.value,
+                constants.POPULATION_BASED_REGIONS.SYNAPTIC_MATRIX.value,
+                routing_info, graph_mapper, partitioned_graph)
 
         self._synapse_dynamics.write_parameters(
             spec, constants.POPULATION_BASED_REGIONS.SYNAPSE_DYNAMICS.value,
             self._machine_time_step, weight_scales)
 
+        self._write_input_buffer_policy(
+            spec, constants.POPULATION_BASED_REGIONS.INPUT_BUFFER.value,
+            key_ranges, self.get_incoming_spike_buffer_size(
+                post_vertex_slice, graph.incoming_edges_to_vertex(vertex)))
+        subvertex.input_key_range_labels = [
+            key_range[3] for key_range in key_ranges]
+
+        spec.comment("\nWriting Weight Recording Parameters:\n")
+        weight_recording.write_params(
+            spec, constants.POPULATION_BASED_REGIONS.WEIGHT_RECORDING.value,
+            weight_recording_interval, recorded_blocks)
+        self._weight_recording_blocks[placement] = recorded_blocks
+
         self._weight_scales[placement] = weight_scales
 
     def get_connections_from_machine(
-            self, transceiver, placement, subedge, graph_mapper,
-            routing_infos, synapse_info, partitioned_graph):
-
-        edge = graph_mapper.get_partitionable_edge_from_partitioned_edge(
-            subedge)
-        if not isinstance(edge, ProjectionPartitionableEdge):
-            return None
+            self, transceiver, placements, subedges, graph_mapper,
+            routing_infos, synapse_info, partitioned_graph, data_to_get,
+            progress_bar):
+        """ Read the connections of a projection from the subedges into the\
+            vertex; the blocks that are not already read are read together,\
+            merged into a few large reads on each chip, with the chips read\
+            in parallel
+
+        :param data_to_get: "weight" or "delay"; the blocks of plastic\
+            synapses read before a run are still used to get the delays, as\
+            only the weights change as the simulation runs
+        :param progress_bar: updated once the connections of each subedge\
+            are read
+        :return: list of the connections of each subedge
+        """
+        is_plastic = not isinstance(
+            synapse_info.synapse_dynamics, AbstractStaticSynapseDynamics)
 
-        # Get details for extraction
-        pre_vertex_slice = graph_mapper.get_subvertex_slice(
-            subedge.pre_subvertex)
-        post_vertex_slice = graph_mapper.get_subvertex_slice(
-            subedge.post_subvertex)
+        # Work out the blocks of each subedge, and which need to be read
+        subedge_blocks = list()
+        to_read = defaultdict(list)
+        for subedge in subedges:
+            edge = graph_mapper.get_partitionable_edge_from_partitioned_edge(
+                subedge)
+            if not isinstance(edge, ProjectionPartitionableEdge):
+                progress_bar.update()
+                continue
+            placement = placements.get_placement_of_subvertex(
+                subedge.post_subvertex)
+            pre_vertex_slice = graph_mapper.get_subvertex_slice(
+                subedge.pre_subvertex)
+            post_vertex_slice = graph_mapper.get_subvertex_slice(
+                subedge.post_subvertex)
+
+            # Get the key for the pre_subvertex
+            partition = partitioned_graph.get_partition_of_subedge(subedge)
+            key = routing_infos.get_keys_and_masks_from_partition(
+                partition)[0].key
+            block = (placement, key, synapse_info.index)
+            blocks = [(block, pre_vertex_slice.n_atoms)]
+
+            # Get the key for the delayed pre_subvertex
+            delayed_block = None
+            if edge.delay_edge is not None:
+                delayed_key = self._delay_key_index[
+                    (edge.pre_vertex, pre_vertex_slice.lo_atom,
+                     pre_vertex_slice.hi_atom)][0].key
+                delayed_block = (placement, delayed_key, synapse_info.index)
+                blocks.append((
+                    delayed_block,
+                    pre_vertex_slice.n_atoms * edge.n_delay_stages))
+
+            for block_id, n_rows in blocks:
+                if (block_id not in self._retrieved_blocks or (
+                        block_id in self._stale_blocks and
+                        data_to_get != "delay")):
+                    to_read[(placement.x, placement.y)].append(
+                        (block_id, n_rows))
+            subedge_blocks.append((
+                placement, edge, pre_vertex_slice, post_vertex_slice, block,
+                delayed_block))
+
+        # Read the blocks, and convert them into connections
+        self._retrieve_synaptic_blocks(transceiver, to_read, is_plastic)
         n_synapse_types = self._synapse_type.get_n_synapse_types()
-
-        # Get the key for the pre_subvertex
-        partition = partitioned_graph.get_partition_of_subedge(subedge)
-        key = routing_infos.get_keys_and_masks_from_partition(
-            partition)[0].key
-
-        # Get the key for the delayed pre_subvertex
-        delayed_key = None
-        if edge.delay_edge is not None:
-            delayed_key = self._delay_key_index[
-                (edge.pre_vertex, pre_vertex_slice.lo_atom,
-                 pre_vertex_slice.hi_atom)][0].key
-
-        # Get the block for the connections from the pre_subvertex
-        master_pop_table_address = \
-            helpful_functions.locate_memory_region_for_placement(
-                placement,
-                constants.POPULATION_BASED_REGIONS.POPULATION_TABLE.value,
-                transceiver)
-        synaptic_matrix_address = \
-            helpful_functions.locate_memory_region_for_placement(
-                placement,
-                constants.POPULATION_BASED_REGIONS.SYNAPTIC_MATRIX.value,
-                transceiver)
-        direct_synapses_address = (
-            self._get_static_synaptic_matrix_sdram_requirements() +
-            synaptic_matrix_address + struct.unpack_from(
-                "<I", transceiver.read_memory(
-                    placement.x, placement.y, synaptic_matrix_address, 4))[0])
-        indirect_synapses_address = synaptic_matrix_address + 4
-        data, max_row_length = self._retrieve_synaptic_block(
-            transceiver, placement, master_pop_table_address,
-            indirect_synapses_address, direct_synapses_address,
-            key, pre_vertex_slice.n_atoms, synapse_info.index)
-
-        # Get the block for the connections from the delayed pre_subvertex
-        delayed_data = None
-        delayed_max_row_length = 0
-        if delayed_key is not None:
-            delayed_data, delayed_max_row_length = \
-                self._retrieve_synaptic_block(
-                    transceiver, placement, master_pop_table_address,
-                    indirect_synapses_address, direct_synapses_address,
-                    delayed_key,
-                    pre_vertex_slice.n_atoms * edge.n_delay_stages,
-                    synapse_info.index)
-
-        # Convert the blocks into connections
-        return self._synapse_io.read_synapses(
-            synapse_info, pre_vertex_slice, post_vertex_slice,
-            max_row_length, delayed_max_row_length, n_synapse_types,
-            self._weight_scales[placement], data, delayed_data,
-            edge.n_delay_stages)
-
-    def _retrieve_synaptic_block(
-            self, transceiver, placement, master_pop_table_address,
-            indirect_synapses_address, direct_synapses_address,
-            key, n_rows, index):
-        """ Read in a synaptic block from a given processor and subvertex on\
-            the machine
-        """
-
-        # See if we have already got this block
-        if (placement, key, index) in self._retrieved_blocks:
-            return self._retrieved_blocks[(placement, key, index)]
-
-        items = \
-            self._population_table_type.extract_synaptic_matrix_data_location(
-                key, master_pop_table_address, transceiver,
-                placement.x, placement.y)
-        if index >= len(items):
-            return None, None
-
-        max_row_length, synaptic_block_offset, is_single = items[index]
-
-        block = None
-        if max_row_length > 0 and synaptic_block_offset is not None:
-
-            if not is_single:
-
-                # calculate the synaptic block size in bytes
-                synaptic_block_size = self._synapse_io.get_block_n_bytes(
-                    max_row_length, n_rows)
-
-                # read in the synaptic block
-                block = transceiver.read_memory(
-                    placement.x, placement.y,
+        connections = list()
+        for (placement, edge, pre_vertex_slice, post_vertex_slice, block,
+                delayed_block) in subedge_blocks:
+            data, max_row_length, _ = self._retrieved_blocks[block]
+            delayed_data = None
+            delayed_max_row_length = 0
+            if delayed_block is not None:
+                delayed_data, delayed_max_row_length, _ = \
+                    self._retrieved_blocks[delayed_block]
+            connections.append(self._synapse_io.read_synapses(
+                synapse_info, pre_vertex_slice, post_vertex_slice,
+                max_row_length, delayed_max_row_length, n_synapse_types,
+                self._weight_scales[placement], data, delayed_data,
+                edge.n_delay_stages))
+            progress_bar.update()
+        return connections
+
+    def _locate_synaptic_blocks(self, transceiver, chip_blocks):
+        """ Find where the blocks to be read on a chip are, reading the\
+            master population table of each core the first time each block\
+            is read after the graph is mapped
+
+        :param chip_blocks: list of ((placement, key, index), n_rows) of\
+            each block to read on the chip
+        :return: list of (block_id, address, n_bytes, max_row_length,\
+            is_single, n_rows) of each block, with address None if there is\
+            no block
+        """
+        locations = list()
+        for block_id, n_rows in chip_blocks:
+            placement, key, index = block_id
+            if placement not in self._synaptic_matrix_addresses:
+                master_pop_table_address = \
+                    helpful_functions.locate_memory_region_for_placement(
+                        placement,
+                        constants.POPULATION_BASED_REGIONS.POPULATION_TABLE
+                        .value, transceiver)
+                synaptic_matrix_address = \
+                    helpful_functions.locate_memory_region_for_placement(
+                        placement,
+                        constants.POPULATION_BASED_REGIONS.SYNAPTIC_MATRIX
+                        .value, transceiver)
+                direct_synapses_address = (
+                    self._get_static_synaptic_matrix_sdram_requirements() +
+                    synaptic_matrix_address + struct.unpack_from(
+                        "<I", transceiver.read_memory(
+                            placement.x, placement.y,
+                            synaptic_matrix_address, 4))[0])
+                indirect_synapses_address = synaptic_matrix_address + 4
+                self._synaptic_matrix_addresses[placement] = (
+                    master_pop_table_address, indirect_synapses_address,
+                    direct_synapses_address)
+            master_pop_table_address, indirect_synapses_address, \
+                direct_synapses_address = \
+                self._synaptic_matrix_addresses[placement]
+
+            if (placement, key) not in self._synaptic_block_items:
+                self._synaptic_block_items[(placement, key)] = \
+                    self._population_table_type\
+                    .extract_synaptic_matrix_data_location(
+                        key, master_pop_table_address, transceiver,
+                        placement.x, placement.y)
+            items = self._synaptic_block_items[(placement, key)]
+            if index >= len(items):
+                locations.append((block_id, None, 0, None, False, n_rows))
+                continue
+
+            max_row_length, synaptic_block_offset, is_single = items[index]
+            if max_row_length == 0 or synaptic_block_offset is None:
+                locations.append(
+                    (block_id, None, 0, max_row_length, False, n_rows))
+            elif not is_single:
+                locations.append((
+                    block_id,
                     indirect_synapses_address + synaptic_block_offset,
-                    synaptic_block_size)
-
+                    self._synapse_io.get_block_n_bytes(
+                        max_row_length, n_rows),
+                    max_row_length, False, n_rows))
             else:
-                # The data is one per row
-                synaptic_block_size = n_rows * 4
 
-                # read in the synaptic row data
-                single_block = numpy.asarray(transceiver.read_memory(
-                    placement.x, placement.y,
+                # The data is one word per row
+                locations.append((
+                    block_id,
                     direct_synapses_address + (synaptic_block_offset * 4),
-                    synaptic_block_size), dtype="uint8").view("uint32")
-
-                # Convert the block into a set of rows
-                numpy_block = numpy.zeros((n_rows, 4), dtype="uint32")
-                numpy_block[:, 3] = single_block
-                numpy_block[:, 1] = 1
-                block = bytearray(numpy_block.tobytes())
-                max_row_length = 1
-
-        self._retrieved_blocks[(placement, key, index)] = (
-            block, max_row_length)
-        return block, max_row_length
+                    n_rows * 4, max_row_length, True, n_rows))
+        return locations
+
+    def _retrieve_synaptic_blocks(self, transceiver, to_read, is_plastic):
+        """ Read in synaptic blocks from the machine
+
+        :param to_read: dict of (x, y) of a chip to a list of\
+            ((placement, key, index), n_rows) of each block to read from it
+        :param is_plastic: True if the blocks hold plastic synapses, so will\
+            be out of date after the next run
+        """
+        if len(to_read) == 0:
+            return
+
+        # Find the blocks on each chip in parallel
+        chips = list(to_read.keys())
+        chip_locations = batched_memory_reader.map_over_chips(
+            lambda chip: self._locate_synaptic_blocks(
+                transceiver, to_read[chip]),
+            chips, self._synaptic_read_threads)
+
+        # Read the blocks of each chip together, and the chips in parallel
+        reader = batched_memory_reader.BatchedMemoryReader(
+            self._synaptic_read_max_gap_bytes,
+            self._synaptic_read_max_bytes, self._synaptic_read_threads)
+        ranges = list()
+        for (x, y), locations in zip(chips, chip_locations):
+            for location in locations:
+                address, n_bytes = location[1:3]
+                range_id = None
+                if address is not None:
+                    range_id = reader.add_range(x, y, address, n_bytes)
+                ranges.append((location, range_id))
+        reader.read(transceiver)
+
+        for location, range_id in ranges:
+            block_id, _, _, max_row_length, is_single, _ = location
+            block = None
+            if range_id is not None:
+                block = reader.get_data(range_id)
+                if is_single:
+                    block = self._get_rows_from_direct_block(block)
+                    max_row_length = 1
+            self._retrieved_blocks[block_id] = (
+                block, max_row_length, is_plastic)
+            self._stale_blocks.discard(block_id)
+
+    def clear_connection_cache(self, remapped):
+        """ Mark the synaptic blocks read from the machine as out of date,\
+            as the simulation is about to run again
+
+        :param remapped: True if the graph is to be mapped again, after which\
+            the blocks may have moved; otherwise only the weights of the\
+            plastic blocks change
+        """
+        if remapped:
+            self._retrieved_blocks.clear()
+            self._stale_blocks.clear()
+            self._synaptic_matrix_addresses.clear()
+            self._synaptic_block_items.clear()
+        else:
+            self._stale_blocks.update(
+                block_id
+                for block_id, (_, _, is_plastic) in
+                self._retrieved_blocks.items() if is_plastic)
 
     # inherited from AbstractProvidesIncomingPartitionConstraints
     def get_incoming_partition_constraints(self):
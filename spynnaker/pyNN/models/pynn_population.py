@@ -166,24 +166,8 @@ class Population(object):
             logger.warn("Spynnaker only supports gather = true, will "
                         " execute as if gather was true anyhow")
 
-        if isinstance(self._vertex, AbstractSpikeRecordable):
-            if not self._vertex.is_recording_spikes():
-                raise exceptions.ConfigurationException(
-                    "This population has not been set to record spikes")
-        else:
-            raise exceptions.ConfigurationException(
-                "This population has not got the capability to record spikes")
-
-        if not self._spinnaker.has_ran:
-            logger.warn(
-                "The simulation has not yet run, therefore spikes cannot"
-                " be retrieved, hence the list will be empty")
-            return numpy.zeros((0, 2))
-
-        if self._spinnaker.use_virtual_board:
-            logger.warn(
-                "The simulation is using a virtual machine and so has not"
-                " truly ran, hence the list will be empty")
+        self._check_recording(AbstractSpikeRecordable, "spikes")
+        if not self._has_recorded("spikes", "the list will be empty"):
             return numpy.zeros((0, 2))
 
         spikes = self._vertex.get_spikes(
@@ -216,24 +200,8 @@ class Population(object):
         :type compatible_output: bool
         """
 
-        if isinstance(self._vertex, AbstractGSynRecordable):
-            if not self._vertex.is_recording_gsyn():
-                raise exceptions.ConfigurationException(
-                    "This population has not been set to record gsyn")
-        else:
-            raise exceptions.ConfigurationException(
-                "This population has not got the capability to record gsyn")
-
-        if not self._spinnaker.has_ran:
-            logger.warn(
-                "The simulation has not yet run, therefore gsyn cannot"
-                " be retrieved, hence the list will be empty")
-            return numpy.zeros((0, 4))
-
-        if self._spinnaker.use_virtual_board:
-            logger.warn(
-                "The simulation is using a virtual machine and so has not"
-                " truly ran, hence the list will be empty")
+        self._check_recording(AbstractGSynRecordable, "gsyn")
+        if not self._has_recorded("gsyn", "the list will be empty"):
             return numpy.zeros((0, 4))
 
         return self._vertex.get_gsyn(
@@ -253,29 +221,97 @@ class Population(object):
             not used - inserted to match PyNN specs
         :type compatible_output: bool
         """
-        if isinstance(self._vertex, AbstractVRecordable):
-            if not self._vertex.is_recording_v():
+        self._check_recording(AbstractVRecordable, "v")
+        if not self._has_recorded("v", "the list will be empty"):
+            return numpy.zeros((0, 3))
+
+        return self._vertex.get_v(
+            self._spinnaker.no_machine_time_steps, self._spinnaker.placements,
+            self._spinnaker.graph_mapper, self._spinnaker.buffer_manager)
+
+    def save_spikes(self, filename):
+        """ Write the spikes of recorded cells to a binary spike file as\
+            they are extracted from the machine, rather than gathering them\
+            in memory.  The file can be read with\
+            spike_file.read_spikes, which can select ranges of cells and\
+            times without loading the whole file.
+
+        :param filename: the binary spike file to write
+        :return: the number of spikes written
+        """
+        self._check_recording(AbstractSpikeRecordable, "spikes")
+        if not self._has_recorded("spikes", "no spikes will be saved"):
+            return 0
+        utility_calls.check_directory_exists_and_create_if_not(filename)
+        return self._vertex.get_spikes(
+            self._spinnaker.placements, self._spinnaker.graph_mapper,
+            self._spinnaker.buffer_manager, filename)
+
+    def save_gsyn(self, directory):
+        """ Write the synaptic conductances of recorded cells to a\
+            recording store as they are extracted from the machine, rather\
+            than gathering them in memory
+
+        :param directory: the directory of the store
+        :return: a RecordingStore to read ranges of cells and times from,\
+            or None if there is nothing to save
+        """
+        self._check_recording(AbstractGSynRecordable, "gsyn")
+        if not self._has_recorded("gsyn", "no gsyn will be saved"):
+            return None
+        return self._vertex.get_gsyn(
+            self._spinnaker.no_machine_time_steps, self._spinnaker.placements,
+            self._spinnaker.graph_mapper, self._spinnaker.buffer_manager,
+            directory)
+
+    def save_v(self, directory):
+        """ Write the membrane voltages of recorded cells to a recording\
+            store as they are extracted from the machine, rather than\
+            gathering them in memory
+
+        :param directory: the directory of the store
+        :return: a RecordingStore to read ranges of cells and times from,\
+            or None if there is nothing to save
+        """
+        self._check_recording(AbstractVRecordable, "v")
+        if not self._has_recorded("v", "no v will be saved"):
+            return None
+        return self._vertex.get_v(
+            self._spinnaker.no_machine_time_steps, self._spinnaker.placements,
+            self._spinnaker.graph_mapper, self._spinnaker.buffer_manager,
+            directory)
+
+    def _check_recording(self, recordable_type, variable):
+        """ Check that the vertex is recording a variable
+
+        :raise ConfigurationException: if it is not
+        """
+        if isinstance(self._vertex, recordable_type):
+            if not getattr(self._vertex, "is_recording_" + variable)():
                 raise exceptions.ConfigurationException(
-                    "This population has not been set to record v")
+                    "This population has not been set to record {}".format(
+                        variable))
         else:
             raise exceptions.ConfigurationException(
-                "This population has not got the capability to record v")
+                "This population has not got the capability to record"
+                " {}".format(variable))
 
+    def _has_recorded(self, variable, consequence):
+        """ Determine if the machine has run and so has recorded data,\
+            warning of the consequence if not
+        """
         if not self._spinnaker.has_ran:
             logger.warn(
-                "The simulation has not yet run, therefore v cannot"
-                " be retrieved, hence the list will be empty")
-            return numpy.zeros((0, 3))
+                "The simulation has not yet run, therefore {} cannot"
+                " be retrieved, hence {}".format(variable, consequence))
+            return False
 
         if self._spinnaker.use_virtual_board:
             logger.warn(
                 "The simulation is using a virtual machine and so has not"
-                " truly ran, hence the list will be empty")
-            return numpy.zeros((0, 3))
-
-        return self._vertex.get_v(
-            self._spinnaker.no_machine_time_steps, self._spinnaker.placements,
-            self._spinnaker.graph_mapper, self._spinnaker.buffer_manager)
+                " truly ran, hence {}".format(consequence))
+            return False
+        return True
 
     def id_to_index(self, cell_id):
         """ Given the ID(s) of cell(s) in the Population, return its (their)\
@@ -8,6 +8,8 @@ from spynnaker.pyNN.models.neural_projections.synapse_information \
     import SynapseInformation
 from spynnaker.pyNN.models.neuron.synapse_dynamics.synapse_dynamics_static \
     import SynapseDynamicsStatic
+from spynnaker.pyNN.models.neuron.synapse_dynamics.synapse_dynamics_stdp \
+    import SynapseDynamicsSTDP
 from spynnaker.pyNN.models.neuron.abstract_population_vertex \
     import AbstractPopulationVertex
 from spynnaker.pyNN.models.utility_models.delay_extension_vertex \
@@ -167,6 +169,57 @@ class Projection(object):
         if isinstance(self._projection_edge, AbstractChangableAfterRun):
             self._projection_edge.mark_no_changes()
 
+    @property
+    def input_priority(self):
+        """ The priority of the spikes of this projection in the input buffer\
+            of the post-synaptic cores, used when the buffer fills and the\
+            incoming_spike_buffer_overflow_policy is priority; spikes of\
+            projections of lower priority than the highest into a core are\
+            dropped first.  Set before the simulation is run.
+        """
+        return self._synapse_information.input_priority
+
+    @input_priority.setter
+    def input_priority(self, input_priority):
+        self._synapse_information.input_priority = input_priority
+
+    def record_weights(self, interval=1.0):
+        """ Record the changes to the weights of this plastic projection\
+            while the simulation runs, so that they can be read with\
+            get_weight_history.  The post-synaptic cores send the weights\
+            that changed at least every interval milliseconds; the cores\
+            of a population use the shortest interval of the projections\
+            into it.  Only supported for STDP with mad=True.  Set before the\
+            simulation is run.
+        """
+        synapse_dynamics = self._synapse_information.synapse_dynamics
+        if (not isinstance(synapse_dynamics, SynapseDynamicsSTDP) or
+                not synapse_dynamics.mad):
+            raise exceptions.ConfigurationException(
+                "Weight recording is only supported for STDP projections"
+                " with mad=True")
+        self._synapse_information.record_weights = True
+        self._projection_edge.post_vertex.set_recording_weights(interval)
+
+    def get_weight_history(self):
+        """ Get the weight changes recorded during the simulation
+
+        :return: numpy array with fields time (in milliseconds), source,\
+            target and weight, with an entry for each change of the weight\
+            of a synapse, in time order; the weights at the start are those\
+            that the connector gave
+        """
+        if not self._synapse_information.record_weights:
+            raise exceptions.ConfigurationException(
+                "This projection is not recording its weights; call"
+                " record_weights before running the simulation")
+        if not self._spinnaker.has_ran:
+            raise exceptions.ConfigurationException(
+                "The simulation has not been run")
+        return self._projection_edge.post_vertex.get_weight_history(
+            self._synapse_information, self._spinnaker.placements,
+            self._spinnaker.graph_mapper, self._spinnaker.buffer_manager)
+
     def _find_existing_edge(self, presynaptic_vertex, postsynaptic_vertex):
         """ Searches though the partitionable graph's edges to locate any\
             edge which has the same post and pre vertex
@@ -301,15 +354,11 @@ class Projection(object):
             len(subedges),
             "Getting {}s for projection between {} and {}".format(
                 data_to_get, pre_vertex.label, post_vertex.label))
-        for subedge in subedges:
-            placement = placements.get_placement_of_subvertex(
-                subedge.post_subvertex)
-            connections = post_vertex.get_connections_from_machine(
-                transceiver, placement, subedge, graph_mapper, routing_infos,
-                self._synapse_information, partitioned_graph)
-            if connections is not None:
-                connection_holder.add_connections(connections)
-            progress.update()
+        for connections in post_vertex.get_connections_from_machine(
+                transceiver, placements, subedges, graph_mapper,
+                routing_infos, self._synapse_information, partitioned_graph,
+                data_to_get, progress):
+            connection_holder.add_connections(connections)
         progress.end()
         connection_holder.finish()
         return connection_holder
@@ -164,7 +164,8 @@ class SpikeSourceArray(
         self._requires_mapping = not self._spike_recorder.record
         self._spike_recorder.record = True
 
-    def get_spikes(self, placements, graph_mapper, buffer_manager):
+    def get_spikes(self, placements, graph_mapper, buffer_manager,
+                   spike_file_path=None):
 
         return self._spike_recorder.get_spikes(
             self.label, buffer_manager,
@@ -175,7 +176,7 @@ class SpikeSourceArray(
             placements, graph_mapper, self,
             lambda subvertex:
                 subvertex.virtual_key if subvertex.virtual_key is not None
-                else 0)
+                else 0, spike_file_path)
 
     @property
     def model_name(self):
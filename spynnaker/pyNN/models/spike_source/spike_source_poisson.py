@@ -489,14 +489,15 @@ class SpikeSourcePoisson(
     def get_binary_file_name(self):
         return "spike_source_poisson.aplx"
 
-    def get_spikes(self, placements, graph_mapper, buffer_manager):
+    def get_spikes(self, placements, graph_mapper, buffer_manager,
+                   spike_file_path=None):
         return self._spike_recorder.get_spikes(
             self._label, buffer_manager,
             (SpikeSourcePoissonPartitionedVertex.
                 _POISSON_SPIKE_SOURCE_REGIONS.SPIKE_HISTORY_REGION.value),
             (SpikeSourcePoissonPartitionedVertex.
                 _POISSON_SPIKE_SOURCE_REGIONS.BUFFERING_OUT_STATE.value),
-            placements, graph_mapper, self)
+            placements, graph_mapper, self, spike_file_path)
 
     def get_outgoing_partition_constraints(self, partition, graph_mapper):
         return [KeyAllocatorContiguousRangeContraint()]
@@ -24,6 +24,11 @@ from spynnaker.pyNN.models.abstract_models\
     .abstract_vertex_with_dependent_vertices \
     import AbstractVertexWithEdgeToDependentVertices
 from spynnaker.pyNN.utilities import constants
+from spynnaker.pyNN.utilities import reports
+from spynnaker.pyNN.models.neuron.abstract_population_vertex \
+    import AbstractPopulationVertex
+from spynnaker.pyNN.models.neuron.atoms_per_core_solver \
+    import AtomsPerCoreSolver
 
 # general imports
 import logging
@@ -314,12 +319,57 @@ class Spinnaker(SpinnakerMainInterface):
             self, turn_off_machine, clear_routing_tables, clear_tags,
             extract_provenance_data, extract_iobuf)
 
+        # the tick profiles and spike latencies are read with the
+        # provenance data
+        if (extract_provenance_data and self.has_ran and
+                config.getboolean("Reports", "reportsEnabled")):
+            if config.getboolean("Reports", "writeTickProfileReport"):
+                reports.generate_tick_profile_report(
+                    self._report_default_directory, self.placements)
+            if config.getboolean("Reports", "writeSpikeLatencyReport"):
+                reports.generate_spike_latency_report(
+                    self._report_default_directory, self.placements)
+
     def run(self, run_time):
         """ Run the model created
 
         :param run_time: the time in ms to run the simulation for
         """
 
+        # Fit the populations to the cores before they are first partitioned
+        if (not self.has_ran and
+                config.getboolean("Mapping", "choose_atoms_per_core")):
+            self._choose_atoms_per_core()
+
+        # The synaptic data read back so far is out of date once this runs
+        if self.has_ran:
+            remapped = self._detect_if_graph_has_changed(reset_flags=False)
+            for vertex in self._partitionable_graph.vertices:
+                if isinstance(vertex, AbstractPopulationVertex):
+                    vertex.clear_connection_cache(remapped)
+
         # extra post run algorithms
         self._dsg_algorithm = "SpynnakerDataSpecificationWriter"
         SpinnakerMainInterface.run(self, run_time)
+
+    def _choose_atoms_per_core(self):
+        """ Limit the atoms per core of each population to those that are\
+            estimated to fit the DTCM, SDRAM and CPU time of a core
+        """
+        sdram_bytes = None
+        if config.get("Machine", "max_sdram_allowed_per_chip") != "None":
+            sdram_bytes = config.getint(
+                "Machine", "max_sdram_allowed_per_chip")
+        solver = AtomsPerCoreSolver(
+            self._machine_time_step, self._time_scale_factor,
+            config.getfloat("Mapping", "choose_atoms_per_core_cpu_fraction"),
+            sdram_bytes)
+        vertices = [
+            vertex for vertex in self._partitionable_graph.vertices
+            if isinstance(vertex, AbstractPopulationVertex)]
+        solutions = solver.apply(vertices, self._partitionable_graph)
+
+        if (config.getboolean("Reports", "reportsEnabled") and
+                config.getboolean("Reports", "writeAtomsPerCoreReport")):
+            reports.generate_atoms_per_core_report(
+                self._report_default_directory, solutions, solver.budget)
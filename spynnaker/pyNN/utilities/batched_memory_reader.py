@@ -0,0 +1,112 @@
+"""
+Reading of many ranges of the SDRAM of the chips of a machine as a few large\
+reads per chip, with the chips read concurrently
+"""
+from multiprocessing.pool import ThreadPool
+from collections import defaultdict
+
+
+def coalesce_ranges(ranges, max_gap_bytes, max_read_bytes):
+    """ Merge ranges of memory into as few reads as possible
+
+    :param ranges: list of (address, n_bytes) of each range
+    :param max_gap_bytes: The largest gap between ranges read as one, as\
+        reading the gap costs less than starting another read
+    :param max_read_bytes: The largest read that ranges are merged into;\
+        a larger range is still read on its own
+    :return: list of (address, n_bytes, ranges) of each read, where ranges\
+        is a list of (index, offset) of each range in the read
+    """
+    reads = list()
+    order = sorted(range(len(ranges)), key=lambda index: ranges[index][0])
+    for index in order:
+        address, n_bytes = ranges[index]
+        if len(reads) > 0:
+            read_address, read_n_bytes, read_ranges = reads[-1]
+            end = max(read_address + read_n_bytes, address + n_bytes)
+            if (address - (read_address + read_n_bytes) <= max_gap_bytes and
+                    end - read_address <= max_read_bytes):
+                reads[-1] = (
+                    read_address, end - read_address,
+                    read_ranges + [(index, address - read_address)])
+                continue
+        reads.append((address, n_bytes, [(index, 0)]))
+    return reads
+
+
+def map_over_chips(function, chips, n_threads):
+    """ Call a function for each chip, calling it for up to n_threads chips\
+        at once
+
+    :param function: The function, taking the (x, y) of a chip
+    :param chips: The (x, y) of each chip
+    :return: list of the result for each chip, in the order of chips
+    """
+    chips = list(chips)
+    if n_threads <= 1 or len(chips) <= 1:
+        return [function(chip) for chip in chips]
+    pool = ThreadPool(min(n_threads, len(chips)))
+    try:
+        return pool.map(function, chips)
+    finally:
+        pool.close()
+        pool.join()
+
+
+class BatchedMemoryReader(object):
+    """ Collects ranges of the SDRAM of chips to read, and then reads them\
+        together, merging the ranges of each chip into few reads
+    """
+
+    __slots__ = [
+        "_max_gap_bytes", "_max_read_bytes", "_n_threads", "_ranges",
+        "_data"]
+
+    def __init__(self, max_gap_bytes, max_read_bytes, n_threads):
+        """
+
+        :param max_gap_bytes: The largest gap between ranges read as one
+        :param max_read_bytes: The largest read that ranges are merged into
+        :param n_threads: The number of chips read at once
+        """
+        self._max_gap_bytes = max_gap_bytes
+        self._max_read_bytes = max_read_bytes
+        self._n_threads = n_threads
+        self._ranges = defaultdict(list)
+        self._data = dict()
+
+    def add_range(self, x, y, address, n_bytes):
+        """ Add a range to be read
+
+        :return: The id of the range, with which to get its data once read
+        """
+        chip_ranges = self._ranges[(x, y)]
+        chip_ranges.append((address, n_bytes))
+        return (x, y, len(chip_ranges) - 1)
+
+    def read(self, transceiver):
+        """ Read all of the ranges added
+        """
+        def read_chip(chip):
+            x, y = chip
+            ranges = self._ranges[chip]
+            data = [None] * len(ranges)
+            for address, n_bytes, read_ranges in coalesce_ranges(
+                    ranges, self._max_gap_bytes, self._max_read_bytes):
+                read_data = transceiver.read_memory(x, y, address, n_bytes)
+                for index, offset in read_ranges:
+                    data[index] = read_data[
+                        offset:offset + ranges[index][1]]
+            return data
+
+        chips = list(self._ranges.keys())
+        for chip, data in zip(
+                chips, map_over_chips(read_chip, chips, self._n_threads)):
+            x, y = chip
+            for index, range_data in enumerate(data):
+                self._data[(x, y, index)] = range_data
+
+    def get_data(self, range_id):
+        """ Get the data read for a range
+        """
+        return self._data[range_id]
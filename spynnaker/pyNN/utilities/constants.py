@@ -57,4 +57,7 @@ POPULATION_BASED_REGIONS = Enum(
            ('POTENTIAL_HISTORY', 7),
            ('GSYN_HISTORY', 8),
            ('BUFFERING_OUT_STATE', 9),
-           ('PROVENANCE_DATA', 10)])
+           ('PROVENANCE_DATA', 10),
+           ('INPUT_BUFFER', 11),
+           ('WEIGHT_RECORDING', 12),
+           ('WEIGHT_HISTORY', 13)])
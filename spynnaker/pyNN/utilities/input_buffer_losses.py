@@ -0,0 +1,93 @@
+"""
+The policies for the input spike buffer of neuron cores, and decoding of the\
+input spike losses that they write to their provenance data
+"""
+
+# The overflow policies, in the order of input_buffer_policy_e
+POLICIES = ["drop_newest", "drop_oldest", "priority"]
+
+# The number of key ranges whose losses are reported separately; the losses of
+# any other keys are reported together
+N_REPORTED_RANGES = 8
+
+# buffer size, early drops, ticks with losses, max losses in a tick, the tick
+# of the max and the first tick with losses
+N_HEADER_WORDS = 6
+
+# The total number of provenance words
+N_PROVENANCE_WORDS = N_HEADER_WORDS + N_REPORTED_RANGES + 1
+
+# The value of the first tick with losses when there were none
+_NO_TICK = 0xFFFFFFFF
+
+
+class InputBufferLosses(object):
+    """ The spikes lost by the input spike buffer of a single core
+    """
+
+    __slots__ = [
+        "_buffer_size", "_n_early_drops", "_n_ticks_with_losses",
+        "_max_losses_in_a_tick", "_tick_of_max_losses",
+        "_first_tick_with_losses", "_range_losses", "_other_losses"]
+
+    def __init__(self, words):
+        """
+
+        :param words: The N_PROVENANCE_WORDS provenance words written by\
+            the core
+        """
+        self._buffer_size = words[0]
+        self._n_early_drops = words[1]
+        self._n_ticks_with_losses = words[2]
+        self._max_losses_in_a_tick = words[3]
+        self._tick_of_max_losses = words[4]
+        self._first_tick_with_losses = words[5]
+        if self._first_tick_with_losses == _NO_TICK:
+            self._first_tick_with_losses = None
+        self._range_losses = list(
+            words[N_HEADER_WORDS:N_HEADER_WORDS + N_REPORTED_RANGES])
+        self._other_losses = words[N_HEADER_WORDS + N_REPORTED_RANGES]
+
+    @property
+    def buffer_size(self):
+        """ The number of spikes the buffer held
+        """
+        return self._buffer_size
+
+    @property
+    def n_early_drops(self):
+        """ The number of spikes dropped by the overflow policy before the\
+            buffer was full
+        """
+        return self._n_early_drops
+
+    @property
+    def n_ticks_with_losses(self):
+        return self._n_ticks_with_losses
+
+    @property
+    def max_losses_in_a_tick(self):
+        return self._max_losses_in_a_tick
+
+    @property
+    def tick_of_max_losses(self):
+        return self._tick_of_max_losses
+
+    @property
+    def first_tick_with_losses(self):
+        """ The first tick in which spikes were lost, or None if none were
+        """
+        return self._first_tick_with_losses
+
+    @property
+    def range_losses(self):
+        """ The spikes lost from each of the first N_REPORTED_RANGES key\
+            ranges written to the input buffer region
+        """
+        return self._range_losses
+
+    @property
+    def other_losses(self):
+        """ The spikes lost from any other keys
+        """
+        return self._other_losses
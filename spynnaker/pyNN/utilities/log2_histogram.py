@@ -0,0 +1,69 @@
+"""
+Helpers for the log2 histograms written by cores to their provenance data\
+(see common/log2_histogram.h in the C code)
+"""
+
+# The number of bins in each histogram
+N_BINS = 16
+
+
+def bin_limits(unit):
+    """ Get the lower (inclusive) and upper (exclusive) limits of each bin;\
+        bin 0 counts values of 0, bin n counts values in the range\
+        [2^(n-1), 2^n) and the last bin has no upper limit
+
+    :param unit: The size of one count of the binned value
+    :rtype: list of (float, float or None)
+    """
+    limits = [(0.0, float(unit))]
+    for i in range(1, N_BINS):
+        limits.append(((2 ** (i - 1)) * float(unit), (2 ** i) * float(unit)))
+    limits[-1] = (limits[-1][0], None)
+    return limits
+
+
+def merge(histograms):
+    """ Add together histograms, e.g. from several cores
+
+    :param histograms: iterable of lists of N_BINS counts
+    :rtype: list of int
+    """
+    total = [0] * N_BINS
+    for histogram in histograms:
+        for i in range(N_BINS):
+            total[i] += histogram[i]
+    return total
+
+
+def percentile_upper_limit(histogram, unit, fraction):
+    """ Get the upper limit of the bin that contains the given fraction of\
+        the values, i.e. an upper bound on that percentile of the values
+
+    :param histogram: The N_BINS counts
+    :param unit: The size of one count of the binned value
+    :param fraction: The fraction of the values, between 0 and 1
+    :return: The upper limit, None if in the unbounded last bin, or 0 if\
+        the histogram is empty
+    """
+    n_values = sum(histogram)
+    if n_values == 0:
+        return 0.0
+    limits = bin_limits(unit)
+    needed = fraction * n_values
+    count = 0
+    for (_, upper), n_in_bin in zip(limits, histogram):
+        count += n_in_bin
+        if count >= needed:
+            return upper
+    return None
+
+
+def format_histogram(histogram, unit, units_name):
+    """ Format the non-empty bins of a histogram for a report
+    """
+    return ", ".join(
+        "<{:.2f}{}: {}".format(upper, units_name, count)
+        if upper is not None else
+        ">={:.2f}{}: {}".format(lower, units_name, count)
+        for (lower, upper), count in zip(bin_limits(unit), histogram)
+        if count > 0)
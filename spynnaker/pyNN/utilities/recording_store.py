@@ -0,0 +1,163 @@
+"""
+An on-disk store of values recorded from every neuron at every time step,\
+such as the membrane voltage or conductances of a population.  The store is\
+a directory with a shard for each core, holding a column of the recorded\
+times and a matrix of (time, neuron, value), written as numpy files as each\
+core is read so that the whole recording never needs to be in memory.  The\
+shards are memory-mapped when read, so that a range of neurons and times\
+can be selected by reading only the rows and columns needed.
+"""
+import numpy
+import os
+
+# The index of the shards, with a row of (first atom, number of atoms) for
+# each, and the number of values recorded per atom in the first row
+_INDEX_FILE = "index.npy"
+_TIMES_FILE = "times_{}.npy"
+_VALUES_FILE = "values_{}.npy"
+
+
+class RecordingStoreWriter(object):
+    """ Writes a recording store a core at a time
+    """
+
+    __slots__ = ["_directory", "_n_values", "_shards"]
+
+    def __init__(self, directory, n_values):
+        """
+
+        :param directory: The directory to write the store to, which will be\
+            created if it does not exist
+        :param n_values: The number of values recorded per atom per time step
+        """
+        if not os.path.isdir(directory):
+            os.makedirs(directory)
+        self._directory = directory
+        self._n_values = n_values
+        self._shards = list()
+
+    def add_core(self, lo_atom, times, values):
+        """ Write the values recorded by a core
+
+        :param lo_atom: The first atom of the core
+        :param times: The time of each row of values, in increasing order;\
+            there must be at least one
+        :param values: The values, of any shape that can be reshaped to\
+            (time, atom, value)
+        """
+        shard = len(self._shards)
+        values = values.reshape((len(times), -1, self._n_values))
+        numpy.save(
+            os.path.join(self._directory, _TIMES_FILE.format(shard)),
+            numpy.asarray(times, dtype="float64"))
+        numpy.save(
+            os.path.join(self._directory, _VALUES_FILE.format(shard)),
+            numpy.asarray(values, dtype="float64"))
+        self._shards.append((lo_atom, values.shape[1]))
+
+    def close(self):
+        """ Finish writing the store
+
+        :return: A reader of the store
+        :rtype: :py:class:`RecordingStore`
+        """
+        index = numpy.zeros((len(self._shards) + 1, 2), dtype="int64")
+        index[0, 0] = self._n_values
+        if len(self._shards) > 0:
+            index[1:] = self._shards
+        numpy.save(os.path.join(self._directory, _INDEX_FILE), index)
+        return RecordingStore(self._directory)
+
+
+class RecordingStore(object):
+    """ Reads a recording store written by a RecordingStoreWriter
+    """
+
+    __slots__ = ["_directory", "_n_values", "_shards"]
+
+    def __init__(self, directory):
+        """
+
+        :param directory: The directory of the store
+        """
+        index = numpy.load(os.path.join(directory, _INDEX_FILE))
+        self._directory = directory
+        self._n_values = int(index[0, 0])
+
+        # The shards are read in order of their first atom, whatever order
+        # the cores were written in
+        self._shards = sorted(
+            (int(lo_atom), int(n_atoms), shard)
+            for shard, (lo_atom, n_atoms) in enumerate(index[1:]))
+
+    @property
+    def directory(self):
+        return self._directory
+
+    @property
+    def n_values(self):
+        """ The number of values recorded per atom per time step
+        """
+        return self._n_values
+
+    @property
+    def n_atoms(self):
+        """ The number of atoms, from 0 to the last atom recorded
+        """
+        if len(self._shards) == 0:
+            return 0
+        lo_atom, n_atoms, _ = self._shards[-1]
+        return lo_atom + n_atoms
+
+    def _load(self, file_name, shard):
+        return numpy.load(
+            os.path.join(self._directory, file_name.format(shard)),
+            mmap_mode="r")
+
+    def read(self, min_atom=None, max_atom=None, min_time=None,
+             max_time=None):
+        """ Read the values of atoms min_atom <= atom < max_atom at times\
+            min_time <= time < max_time, where any limit can be None to be\
+            ignored
+
+        :return: An array of (atom, time, value...) rows, ordered by atom\
+            and then time, as returned by get_v and get_gsyn
+        """
+        parts = list()
+        for lo_atom, n_atoms, shard in self._shards:
+            first = lo_atom
+            last = lo_atom + n_atoms
+            if min_atom is not None:
+                first = max(first, min_atom)
+            if max_atom is not None:
+                last = min(last, max_atom)
+            if first >= last:
+                continue
+
+            # The times of a core are in order, so the range of times is a
+            # range of rows, and only those rows are read from the file
+            times = self._load(_TIMES_FILE, shard)
+            first_row = 0
+            last_row = len(times)
+            if min_time is not None:
+                first_row = numpy.searchsorted(times, min_time, "left")
+            if max_time is not None:
+                last_row = numpy.searchsorted(times, max_time, "left")
+            if first_row >= last_row:
+                continue
+            times = numpy.array(times[first_row:last_row])
+            values = self._load(_VALUES_FILE, shard)[
+                first_row:last_row, first - lo_atom:last - lo_atom]
+
+            # Transpose to (atom, time, value) to order by atom and then time
+            part = numpy.empty(
+                (last - first, len(times), 2 + self._n_values),
+                dtype="float64")
+            part[:, :, 0] = numpy.arange(first, last)[:, None]
+            part[:, :, 1] = times[None, :]
+            part[:, :, 2:] = numpy.transpose(values, (1, 0, 2))
+            parts.append(part.reshape((-1, 2 + self._n_values)))
+
+        if len(parts) == 0:
+            return numpy.zeros((0, 2 + self._n_values), dtype="float64")
+        return numpy.concatenate(parts)
@@ -1,6 +1,10 @@
 import logging
 import os
 
+from spynnaker.pyNN.utilities import log2_histogram
+from spynnaker.pyNN.utilities import spike_latency
+from spynnaker.pyNN.utilities import tick_profile
+
 logger = logging.getLogger(__name__)
 
 
@@ -99,3 +103,163 @@ def generate_synaptic_matrix_report(common_report_directory, partitioned_edge):
         counter += 1
     output.flush()
     output.close()
+
+
+def generate_tick_profile_report(
+        common_report_directory, placements, n_worst_cores=10):
+    """ Write a report of the cores that take longest per timer tick,\
+        using the tick profiles read from the provenance data of cores built\
+        with TICK_PROFILE
+
+    :param common_report_directory: the directory to write the report to
+    :param placements: the placements of the partitioned vertices
+    :param n_worst_cores: the number of cores to list for each population
+    :return: None
+    """
+    profiles_by_label = dict()
+    for placement in placements.placements:
+        profile = getattr(placement.subvertex, "tick_profile", None)
+        if profile is not None:
+            label = placement.subvertex.label
+            profiles_by_label.setdefault(label, list()).append(
+                (placement, profile))
+    if len(profiles_by_label) == 0:
+        return
+
+    file_name = os.path.join(common_report_directory, "tick_profile.rpt")
+    try:
+        output = open(file_name, "w")
+    except IOError:
+        logger.error("Generate_tick_profile_report: Can't open file"
+                     " {} for writing.".format(file_name))
+        return
+
+    for label in sorted(profiles_by_label.keys()):
+        cores = profiles_by_label[label]
+
+        # Order the cores by the total of the worst time of each phase
+        cores.sort(key=lambda core: sum(
+            core[1].phase(phase).max_us for phase in tick_profile.PHASES),
+            reverse=True)
+        output.write("Population {} ({} cores)\n".format(label, len(cores)))
+        for placement, profile in cores[:n_worst_cores]:
+            output.write(
+                "    core {}, {}, {}: {} tics, {} late, {} started with "
+                "spike processing busy\n".format(
+                    placement.x, placement.y, placement.p, profile.n_ticks,
+                    profile.n_late_ticks,
+                    profile.n_spike_processing_busy_ticks))
+            for phase_name in tick_profile.PHASES:
+                phase = profile.phase(phase_name)
+                output.write(
+                    "        {:<17} min {:>9.2f}us mean {:>9.2f}us "
+                    "max {:>9.2f}us\n".format(
+                        phase_name, phase.min_us, phase.mean_us,
+                        phase.max_us))
+                output.write("            {}\n".format(
+                    log2_histogram.format_histogram(
+                        phase.histogram, phase.histogram_unit_us, "us")))
+        output.write("\n")
+    output.flush()
+    output.close()
+
+
+def generate_spike_latency_report(
+        common_report_directory, placements, n_worst_cores=10):
+    """ Write a report of the spike processing latencies of each population,\
+        aggregated over its cores, listing the cores with the longest queueing\
+        of spikes first, using the latencies read from the provenance data of\
+        cores built with SPIKE_LATENCY
+
+    :param common_report_directory: the directory to write the report to
+    :param placements: the placements of the partitioned vertices
+    :param n_worst_cores: the number of cores to list for each population
+    :return: None
+    """
+    latencies_by_label = dict()
+    for placement in placements.placements:
+        latencies = getattr(placement.subvertex, "spike_latencies", None)
+        if latencies is not None:
+            label = placement.subvertex.label
+            latencies_by_label.setdefault(label, list()).append(
+                (placement, latencies))
+    if len(latencies_by_label) == 0:
+        return
+
+    file_name = os.path.join(common_report_directory, "spike_latency.rpt")
+    try:
+        output = open(file_name, "w")
+    except IOError:
+        logger.error("Generate_spike_latency_report: Can't open file"
+                     " {} for writing.".format(file_name))
+        return
+
+    for label in sorted(latencies_by_label.keys()):
+        cores = latencies_by_label[label]
+        merged = spike_latency.SpikeLatencies.merge(
+            latencies for _, latencies in cores)
+        output.write("Population {} ({} cores, {} spikes)\n".format(
+            label, len(cores), merged.n_spikes))
+        for stage in spike_latency.STAGES:
+            output.write(
+                "    {:<10} 99th percentile {:>9.2f}us max {:>9.2f}us\n"
+                "        {}\n".format(
+                    stage, merged.percentile_us(stage, 0.99),
+                    merged.max_us(stage),
+                    log2_histogram.format_histogram(
+                        merged.histogram(stage), merged.histogram_unit_us,
+                        "us")))
+
+        # The cores where spikes wait longest are closest to dropping them
+        cores.sort(
+            key=lambda core: core[1].percentile_us("queued", 0.99),
+            reverse=True)
+        output.write("    Cores by 99th percentile queued latency:\n")
+        for placement, latencies in cores[:n_worst_cores]:
+            output.write(
+                "        core {}, {}, {}: {} spikes, queued {:.2f}us, "
+                "total {:.2f}us\n".format(
+                    placement.x, placement.y, placement.p,
+                    latencies.n_spikes,
+                    latencies.percentile_us("queued", 0.99),
+                    latencies.percentile_us("total", 0.99)))
+        output.write("\n")
+    output.flush()
+    output.close()
+
+
+def generate_atoms_per_core_report(
+        common_report_directory, solutions, budget):
+    """ Write a report of the number of atoms per core chosen for each\
+        population, the resource that limits it and the estimated usage of\
+        each resource
+
+    :param common_report_directory: the directory to write the report to
+    :param solutions: list of AtomsPerCoreSolution
+    :param budget: dict of resource name to the amount available per core
+    :return: None
+    """
+    file_name = os.path.join(common_report_directory, "atoms_per_core.rpt")
+    try:
+        output = open(file_name, "w")
+    except IOError:
+        logger.error("Generate_atoms_per_core_report: Can't open file"
+                     " {} for writing.".format(file_name))
+        return
+
+    resources = sorted(budget.keys())
+    output.write("Budget per core: {}\n\n".format(", ".join(
+        "{} {}".format(resource, budget[resource])
+        for resource in resources)))
+    for solution in solutions:
+        output.write(
+            "{}: {} atoms, {} per core, limited by {}\n".format(
+                solution.vertex.label, solution.vertex.n_atoms,
+                solution.max_atoms_per_core, solution.binding_resource))
+        output.write("    {}\n".format(", ".join(
+            "{} {} ({:.0%})".format(
+                resource, solution.usage[resource],
+                float(solution.usage[resource]) / budget[resource])
+            for resource in resources)))
+    output.flush()
+    output.close()
@@ -0,0 +1,88 @@
+"""
+Decoding of recorded spike bit fields, in which bit i of word j of a row is\
+set if neuron 32 * j + i spiked.  The set bits are found a word at a time\
+rather than by expanding every bit to a byte, so the temporary arrays are no\
+larger than the words with bits set, and the rows are decoded in chunks so\
+that the temporary arrays of a core with a long recording stay small.
+"""
+import numpy
+
+# The number of words decoded at a time
+_CHUNK_WORDS = 1024 * 1024
+
+_ONE = numpy.uint32(1)
+
+# The de Bruijn sequence, and the bit that each top five bits of its product
+# with a power of two belong to, to find the index of the lowest set bit of a
+# word without a loop over the bits
+_DE_BRUIJN = numpy.uint32(0x077CB531)
+_DE_BRUIJN_SHIFT = numpy.uint32(27)
+_DE_BRUIJN_BITS = numpy.zeros(32, dtype="uint32")
+for _bit in range(32):
+    _DE_BRUIJN_BITS[((0x077CB531 << _bit) & 0xFFFFFFFF) >> 27] = _bit
+
+
+def _popcount(words):
+    """ Count the bits set in each of an array of uint32 words
+    """
+    words = words - ((words >> _ONE) & numpy.uint32(0x55555555))
+    words = ((words & numpy.uint32(0x33333333)) +
+             ((words >> numpy.uint32(2)) & numpy.uint32(0x33333333)))
+    words = (words + (words >> numpy.uint32(4))) & numpy.uint32(0x0F0F0F0F)
+    return (words * numpy.uint32(0x01010101)) >> numpy.uint32(24)
+
+
+def _iter_row_chunks(words):
+    """ Split a 2D array of (row, word) into chunks of whole rows, each\
+        flattened into a contiguous array of uint32
+
+    :return: An iterable of (first row, flat words)
+    """
+    n_words = max(words.shape[1], 1)
+    rows_per_chunk = max(_CHUNK_WORDS // n_words, 1)
+    for first_row in xrange(0, words.shape[0], rows_per_chunk):
+        chunk = words[first_row:first_row + rows_per_chunk]
+        yield first_row, numpy.ascontiguousarray(
+            chunk, dtype="uint32").ravel()
+
+
+def decode_spikes(words):
+    """ Find the spikes in a 2D array of (row, word) spike bit fields
+
+    :param words: The bit fields, with a row for each time step or block
+    :return: A tuple of arrays of (row, neuron id) of the spikes, ordered by\
+        row and then neuron id
+    """
+    n_words = words.shape[1]
+    all_rows = list()
+    all_ids = list()
+    for first_row, flat in _iter_row_chunks(words):
+        word_indices = numpy.flatnonzero(flat)
+        if len(word_indices) == 0:
+            continue
+        remaining = flat[word_indices]
+        bit_indices = numpy.empty(
+            int(_popcount(remaining).sum(dtype="uint64")), dtype="int64")
+
+        # Take the lowest set bit of each word with bits left until there
+        # are none, so each pass only touches the words that still have bits
+        offset = 0
+        while len(word_indices) > 0:
+            lowest = remaining & (~remaining + _ONE)
+            bits = _DE_BRUIJN_BITS[(lowest * _DE_BRUIJN) >> _DE_BRUIJN_SHIFT]
+            bit_indices[offset:offset + len(bits)] = word_indices * 32 + bits
+            offset += len(bits)
+            remaining &= remaining - _ONE
+            keep = remaining != 0
+            word_indices = word_indices[keep]
+            remaining = remaining[keep]
+
+        # The index of a bit in the chunk orders the spikes by row and then id
+        bit_indices.sort()
+        row_bits = n_words * 32
+        all_rows.append(bit_indices // row_bits + first_row)
+        all_ids.append(bit_indices % row_bits)
+
+    if len(all_rows) == 0:
+        return numpy.zeros(0, dtype="int64"), numpy.zeros(0, dtype="int64")
+    return numpy.concatenate(all_rows), numpy.concatenate(all_ids)
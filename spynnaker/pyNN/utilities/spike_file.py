@@ -0,0 +1,207 @@
+"""
+Reading of spike and data files, either as text with one record per line\
+and the values separated by a given string, or as compact binary spike\
+files.  Files are parsed in chunks so that only the records selected are\
+held in memory.
+"""
+import numpy
+import os
+import struct
+
+# The number of bytes of text parsed at a time
+_CHUNK_BYTES = 16 * 1024 * 1024
+
+# The header of a binary spike file: magic number and version
+BINARY_SPIKE_FILE_MAGIC = b"SPKB"
+_BINARY_SPIKE_FILE_VERSION = 1
+_BINARY_HEADER = struct.Struct("<4sI")
+
+# The records of a binary spike file, which follow the header
+BINARY_SPIKE_DTYPE = numpy.dtype([("time", "<f8"), ("atom", "<u4")])
+
+# The number of binary records read at a time
+_CHUNK_RECORDS = _CHUNK_BYTES // BINARY_SPIKE_DTYPE.itemsize
+
+
+def is_binary_spike_file(file_path):
+    """ Determine if a file is a binary spike file
+    """
+    with open(file_path, "rb") as source:
+        header = source.read(_BINARY_HEADER.size)
+    return (len(header) == _BINARY_HEADER.size and
+            header[:len(BINARY_SPIKE_FILE_MAGIC)] == BINARY_SPIKE_FILE_MAGIC)
+
+
+def iter_text_chunks(file_path, split_value="\t"):
+    """ Read a text file of records in chunks, ignoring comment lines\
+        starting with # and blank lines
+
+    :param file_path: The file to read
+    :param split_value: The string separating the values of each record
+    :return: An iterable of 2D arrays of (record, value)
+    """
+    n_columns = None
+    with open(file_path, "r") as source:
+        while True:
+            lines = source.readlines(_CHUNK_BYTES)
+            if len(lines) == 0:
+                return
+            lines = [line for line in lines
+                     if not line.startswith("#") and line.strip() != ""]
+            if len(lines) == 0:
+                continue
+            if n_columns is None:
+                n_columns = len(lines[0].split(split_value))
+
+            text = " ".join(lines)
+            if split_value.strip() != "":
+                text = text.replace(split_value, " ")
+            values = numpy.fromstring(text, dtype="float64", sep=" ")
+            if len(values) != len(lines) * n_columns:
+                raise ValueError(
+                    "The records of {} do not all have {} values separated"
+                    " by {}".format(file_path, n_columns, repr(split_value)))
+            yield values.reshape((len(lines), n_columns))
+
+
+def _iter_spike_chunks(file_path, split_value):
+    """ Read the spikes of a text or binary spike file in chunks
+
+    :return: An iterable of (times, atoms) arrays
+    """
+    if is_binary_spike_file(file_path):
+        with open(file_path, "rb") as source:
+            _, version = _BINARY_HEADER.unpack(
+                source.read(_BINARY_HEADER.size))
+        if version != _BINARY_SPIKE_FILE_VERSION:
+            raise ValueError(
+                "Binary spike file {} has unsupported version {}".format(
+                    file_path, version))
+        n_records = ((os.path.getsize(file_path) - _BINARY_HEADER.size) //
+                     BINARY_SPIKE_DTYPE.itemsize)
+        if n_records == 0:
+            return
+        records = numpy.memmap(
+            file_path, dtype=BINARY_SPIKE_DTYPE, mode="r",
+            offset=_BINARY_HEADER.size, shape=(n_records,))
+        for start in xrange(0, n_records, _CHUNK_RECORDS):
+            chunk = records[start:start + _CHUNK_RECORDS]
+            yield chunk["time"], chunk["atom"]
+    else:
+        for chunk in iter_text_chunks(file_path, split_value):
+            yield chunk[:, 0], chunk[:, 1]
+
+
+def _in_range(values, min_value, max_value):
+    """ Get a mask of the values where min_value <= value < max_value, where\
+        either limit can be None to be ignored
+    """
+    mask = numpy.ones(len(values), dtype="bool")
+    if min_value is not None:
+        mask &= values >= min_value
+    if max_value is not None:
+        mask &= values < max_value
+    return mask
+
+
+def _concatenate(arrays, dtype):
+    if len(arrays) == 0:
+        return numpy.zeros(0, dtype=dtype)
+    return numpy.concatenate(arrays)
+
+
+def read_spikes(file_path, min_atom=None, max_atom=None, min_time=None,
+                max_time=None, split_value="\t"):
+    """ Read the spikes in a text file of <time><split_value><atom_id>\
+        records, or a binary spike file, selecting those with\
+        min_atom <= atom_id < max_atom and min_time <= time < max_time
+
+    :param file_path: The file to read
+    :param min_atom: The minimum atom id to read, or None for no minimum
+    :param max_atom: The atom id after the last to read, or None to read up\
+        to the largest atom id in the file
+    :param min_time: The minimum time to read, or None for no minimum
+    :param max_time: The time after the last to read, or None for no maximum
+    :param split_value: The string separating the values of a text record
+    :return: An array indexed by atom id of arrays of spike times, in the\
+        order they appear in the file
+    """
+    all_times = list()
+    all_atoms = list()
+    for times, atoms in _iter_spike_chunks(file_path, split_value):
+        mask = (_in_range(atoms, min_atom, max_atom) &
+                _in_range(times, min_time, max_time))
+        all_times.append(numpy.array(times[mask], dtype="float64"))
+        all_atoms.append(numpy.array(atoms[mask], dtype="int64"))
+    times = _concatenate(all_times, "float64")
+    atoms = _concatenate(all_atoms, "int64")
+
+    n_atoms = max_atom
+    if n_atoms is None:
+        n_atoms = int(numpy.amax(atoms)) + 1 if len(atoms) > 0 else 0
+
+    # A stable sort keeps the spikes of each atom in the file order
+    order = numpy.argsort(atoms, kind="mergesort")
+    times = times[order]
+    bounds = numpy.searchsorted(atoms[order], numpy.arange(n_atoms + 1))
+    result = numpy.empty(n_atoms, dtype=object)
+    for atom in xrange(n_atoms):
+        result[atom] = times[bounds[atom]:bounds[atom + 1]]
+    return result
+
+
+def read_data(file_path, min_atom=None, max_atom=None, min_time=None,
+              max_time=None, split_value="\t"):
+    """ Read the values in a text file of\
+        <time><split_value><atom_id><split_value><value> records, selecting\
+        those with min_atom <= atom_id < max_atom and\
+        min_time <= time < max_time
+
+    :return: An array of (atom_id, time, value) rows sorted by atom id and\
+        then time
+    """
+    selected = list()
+    for chunk in iter_text_chunks(file_path, split_value):
+        mask = (_in_range(chunk[:, 1], min_atom, max_atom) &
+                _in_range(chunk[:, 0], min_time, max_time))
+        selected.append(chunk[mask][:, [1, 0, 2]])
+    if len(selected) == 0:
+        return numpy.zeros((0, 3), dtype="float64")
+    result = numpy.concatenate(selected)
+    return result[numpy.lexsort((result[:, 1], result[:, 0]))]
+
+
+def open_binary_spike_file(file_path):
+    """ Create a binary spike file, to be written with write_binary_spikes\
+        and closed when done
+
+    :return: The open file
+    """
+    target = open(file_path, "wb")
+    target.write(_BINARY_HEADER.pack(
+        BINARY_SPIKE_FILE_MAGIC, _BINARY_SPIKE_FILE_VERSION))
+    return target
+
+
+def write_binary_spikes(target, times, atoms):
+    """ Append spikes to a binary spike file opened by open_binary_spike_file
+    """
+    records = numpy.empty(len(times), dtype=BINARY_SPIKE_DTYPE)
+    records["time"] = times
+    records["atom"] = atoms
+    records.tofile(target)
+
+
+def convert_spike_file_to_binary(text_file_path, binary_file_path,
+                                 split_value="\t"):
+    """ Convert a text file of <time><split_value><atom_id> records to a\
+        binary spike file, which can be read by read_spikes without parsing
+
+    :return: The number of spikes converted
+    """
+    n_spikes = 0
+    with open_binary_spike_file(binary_file_path) as target:
+        for chunk in iter_text_chunks(text_file_path, split_value):
+            write_binary_spikes(target, chunk[:, 0], chunk[:, 1])
+            n_spikes += len(chunk)
+    return n_spikes
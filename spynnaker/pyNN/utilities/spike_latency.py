@@ -0,0 +1,106 @@
+"""
+Decoding of the spike processing latencies that neuron cores write to their\
+provenance data when built with SPIKE_LATENCY
+"""
+from spynnaker.pyNN.utilities import log2_histogram
+
+# The stages measured, in the order written by the core
+STAGES = ["queued", "dma", "processing", "total"]
+
+# The histograms count cycles in units of 2 ** HISTOGRAM_SHIFT
+HISTOGRAM_SHIFT = 6
+
+# n spikes timed and CPU clock in MHz
+N_HEADER_WORDS = 2
+
+# max cycles followed by the histogram
+N_STAGE_WORDS = 1 + log2_histogram.N_BINS
+
+# The total number of provenance words
+N_PROVENANCE_WORDS = N_HEADER_WORDS + (len(STAGES) * N_STAGE_WORDS)
+
+
+class SpikeLatencies(object):
+    """ The spike processing latencies of one or more cores
+    """
+
+    __slots__ = ["_n_spikes", "_max_us", "_histograms", "_histogram_unit_us"]
+
+    def __init__(self, n_spikes, max_us, histograms, histogram_unit_us):
+        """
+
+        :param n_spikes: The number of spikes timed
+        :param max_us: dict of stage to the maximum latency in microseconds
+        :param histograms: dict of stage to histogram counts
+        :param histogram_unit_us: The size of one histogram unit in\
+            microseconds
+        """
+        self._n_spikes = n_spikes
+        self._max_us = max_us
+        self._histograms = histograms
+        self._histogram_unit_us = histogram_unit_us
+
+    @staticmethod
+    def from_provenance_words(words):
+        """ Decode the latencies, or return None if the core was not built\
+            to measure them (in which case all the words are 0)
+        """
+        if len(words) < N_PROVENANCE_WORDS or words[1] == 0:
+            return None
+        cpu_clock_mhz = float(words[1])
+        max_us = dict()
+        histograms = dict()
+        for i, stage in enumerate(STAGES):
+            start = N_HEADER_WORDS + (i * N_STAGE_WORDS)
+            max_us[stage] = words[start] / cpu_clock_mhz
+            histograms[stage] = list(words[start + 1:start + N_STAGE_WORDS])
+        return SpikeLatencies(
+            words[0], max_us, histograms,
+            (2 ** HISTOGRAM_SHIFT) / cpu_clock_mhz)
+
+    @staticmethod
+    def merge(latencies):
+        """ Aggregate the latencies of several cores; they must all run at\
+            the same clock speed
+
+        :param latencies: iterable of :py:class:`SpikeLatencies`
+        :rtype: :py:class:`SpikeLatencies`
+        """
+        latencies = list(latencies)
+        return SpikeLatencies(
+            sum(l.n_spikes for l in latencies),
+            dict((stage, max(l.max_us(stage) for l in latencies))
+                 for stage in STAGES),
+            dict((stage, log2_histogram.merge(
+                l.histogram(stage) for l in latencies))
+                for stage in STAGES),
+            latencies[0].histogram_unit_us)
+
+    @property
+    def n_spikes(self):
+        return self._n_spikes
+
+    @property
+    def histogram_unit_us(self):
+        return self._histogram_unit_us
+
+    def max_us(self, stage):
+        """ The maximum latency of a stage in microseconds
+        """
+        return self._max_us[stage]
+
+    def histogram(self, stage):
+        """ The histogram of the latencies of a stage; see\
+            :py:func:`log2_histogram.bin_limits` for the bins
+        """
+        return self._histograms[stage]
+
+    def percentile_us(self, stage, fraction):
+        """ An upper bound of a percentile of the latency of a stage in\
+            microseconds; the maximum is used if in the unbounded last bin
+        """
+        limit = log2_histogram.percentile_upper_limit(
+            self._histograms[stage], self._histogram_unit_us, fraction)
+        if limit is None:
+            return self._max_us[stage]
+        return min(limit, self._max_us[stage])
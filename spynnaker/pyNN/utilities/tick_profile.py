@@ -0,0 +1,126 @@
+"""
+Decoding of the timer tick profile that neuron cores write to their \
+provenance data when built with TICK_PROFILE
+"""
+from spynnaker.pyNN.utilities import log2_histogram
+
+# The phases measured, in the order written by the core
+PHASES = ["synapses", "neurons", "recording", "spike_processing"]
+
+# The number of bins in each histogram
+N_HISTOGRAM_BINS = log2_histogram.N_BINS
+
+# The histograms count cycles in units of 2 ** HISTOGRAM_SHIFT
+HISTOGRAM_SHIFT = 8
+
+# n ticks, n late ticks, n spike processing busy ticks and CPU clock in MHz
+N_HEADER_WORDS = 4
+
+# min, max and mean cycles followed by the histogram
+N_PHASE_WORDS = 3 + N_HISTOGRAM_BINS
+
+# The total number of provenance words
+N_PROVENANCE_WORDS = N_HEADER_WORDS + (len(PHASES) * N_PHASE_WORDS)
+
+
+class PhaseProfile(object):
+    """ The measured times of one phase of the timer tick
+    """
+
+    __slots__ = [
+        "_min_cycles", "_max_cycles", "_mean_cycles", "_histogram",
+        "_cpu_clock_mhz"]
+
+    def __init__(self, words, cpu_clock_mhz):
+        self._min_cycles = words[0]
+        self._max_cycles = words[1]
+        self._mean_cycles = words[2]
+        self._histogram = list(words[3:N_PHASE_WORDS])
+        self._cpu_clock_mhz = cpu_clock_mhz
+
+    @property
+    def min_us(self):
+        return float(self._min_cycles) / self._cpu_clock_mhz
+
+    @property
+    def max_us(self):
+        return float(self._max_cycles) / self._cpu_clock_mhz
+
+    @property
+    def mean_us(self):
+        return float(self._mean_cycles) / self._cpu_clock_mhz
+
+    @property
+    def histogram_unit_us(self):
+        """ The size of one unit of the histogram in microseconds
+        """
+        return float(2 ** HISTOGRAM_SHIFT) / self._cpu_clock_mhz
+
+    @property
+    def histogram(self):
+        """ The counts of the histogram of the phase times; see\
+            histogram_bin_limits_us for the range of each bin
+        """
+        return self._histogram
+
+    def histogram_bin_limits_us(self):
+        """ Get the lower (inclusive) and upper (exclusive) limits of each\
+            histogram bin in microseconds; the last bin has no upper limit
+
+        :rtype: list of (float, float or None)
+        """
+        return log2_histogram.bin_limits(self.histogram_unit_us)
+
+
+class TickProfile(object):
+    """ The timer tick profile of a single core
+    """
+
+    __slots__ = [
+        "_n_ticks", "_n_late_ticks", "_n_spike_processing_busy_ticks",
+        "_phases"]
+
+    def __init__(self, words):
+        """
+
+        :param words: The N_PROVENANCE_WORDS provenance words written by\
+            the core
+        """
+        self._n_ticks = words[0]
+        self._n_late_ticks = words[1]
+        self._n_spike_processing_busy_ticks = words[2]
+        cpu_clock_mhz = words[3]
+        self._phases = dict()
+        for i, phase in enumerate(PHASES):
+            start = N_HEADER_WORDS + (i * N_PHASE_WORDS)
+            self._phases[phase] = PhaseProfile(
+                words[start:start + N_PHASE_WORDS], cpu_clock_mhz)
+
+    @staticmethod
+    def from_provenance_words(words):
+        """ Decode the profile, or return None if the core was not built\
+            to take one (in which case all the words are 0)
+        """
+        if len(words) < N_PROVENANCE_WORDS or words[0] == 0:
+            return None
+        return TickProfile(words)
+
+    @property
+    def n_ticks(self):
+        return self._n_ticks
+
+    @property
+    def n_late_ticks(self):
+        return self._n_late_ticks
+
+    @property
+    def n_spike_processing_busy_ticks(self):
+        return self._n_spike_processing_busy_ticks
+
+    def phase(self, name):
+        """ Get the profile of a phase
+
+        :param name: One of PHASES
+        :rtype: :py:class:`PhaseProfile`
+        """
+        return self._phases[name]
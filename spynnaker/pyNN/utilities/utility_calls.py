@@ -7,6 +7,7 @@ from spynnaker.pyNN.utilities.random_stats.random_stats_uniform_impl \
     import RandomStatsUniformImpl
 from spynnaker.pyNN.models.neural_properties.randomDistributions \
     import RandomDistribution
+from spynnaker.pyNN.utilities import spike_file
 from spinn_front_end_common.utilities import exceptions
 import numpy
 import os
@@ -83,31 +84,8 @@ def read_in_data_from_file(
     :return: a numpi destacked array containing time stamps, neuron id and the
     data value.
     """
-    times = list()
-    atom_ids = list()
-    data_items = list()
-
-    with open(file_path, 'r') as fsource:
-            read_data = fsource.readlines()
-
-    for line in read_data:
-        if not line.startswith('#'):
-            values = line.split("\t")
-            neuron_id = int(eval(values[1]))
-            time = float(eval(values[0]))
-            data_value = float(eval(values[2]))
-            if (min_atom <= neuron_id < max_atom and
-                    min_time <= time < max_time):
-                times.append(time)
-                atom_ids.append(neuron_id)
-                data_items.append(data_value)
-
-            else:
-                print "failed to enter {}:{}".format(neuron_id, time)
-
-    result = numpy.dstack((atom_ids, times, data_items))[0]
-    result = result[numpy.lexsort((times, atom_ids))]
-    return result
+    return spike_file.read_data(
+        file_path, min_atom, max_atom, min_time, max_time)
 
 
 def read_spikes_from_file(file_path, min_atom, max_atom, min_time, max_time,
@@ -115,45 +93,17 @@ def read_spikes_from_file(file_path, min_atom, max_atom, min_time, max_time,
     """
     helper method for reading spikes from a file
     :param file_path: absolute filepath to a file where spike values have been
-    written
+    written, or a binary spike file written by
+    spike_file.convert_spike_file_to_binary
     :param min_atom: min neuron id to which neurons to read in
     :param max_atom: max neuron id to which neurons to read in
     :param min_time: min time slot to read neurons values of.
     :param max_time:max time slot to read neurons values of.
     :param split_value: the pattern to split by
-    :return: a numpi destacked array containing time stamps, neuron id and the
-    spike times.
+    :return: a numpy array indexed by neuron id of arrays of spike times
     """
-    with open(file_path, 'r') as fsource:
-            read_data = fsource.readlines()
-
-    data = dict()
-    max_atom_found = 0
-    for line in read_data:
-        if not line.startswith('#'):
-            values = line.split(split_value)
-            time = float(eval(values[0]))
-            neuron_id = int(eval(values[1]))
-            if ((min_atom is None or min_atom <= neuron_id) and
-                    (max_atom is None or neuron_id < max_atom) and
-                    (min_time is None or min_time <= time) and
-                    (max_time is None or time < max_time)):
-                if neuron_id not in data:
-                    data[neuron_id] = list()
-                data[neuron_id].append(time)
-                if max_atom is None and neuron_id > max_atom_found:
-                    max_atom_found = neuron_id
-
-    if max_atom is None:
-        result = numpy.ndarray(shape=max_atom_found, dtype=object)
-    else:
-        result = numpy.ndarray(shape=max_atom, dtype=object)
-    for neuron_id in range(0, max_atom):
-        if neuron_id in data:
-            result[neuron_id] = data[neuron_id]
-        else:
-            result[neuron_id] = list()
-    return result
+    return spike_file.read_spikes(
+        file_path, min_atom, max_atom, min_time, max_time, split_value)
 
 
 # Converts between a distribution name, and the appropriate scipy stats for\
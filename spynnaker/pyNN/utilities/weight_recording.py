@@ -0,0 +1,150 @@
+"""
+The layout of the weight recording of neuron cores, and decoding of the\
+weight changes that they record
+"""
+
+import numpy
+
+# The number of words in each of the buffers that the core collects the
+# changes in between flushes
+BUFFER_WORDS = 256
+BUFFER_BYTES = BUFFER_WORDS * 4
+
+# The weight recording region holds the interval, the size of the buffers and
+# the number of blocks, followed by the offset and size of each block
+PARAMS_HEADER_BYTES = 12
+PARAMS_BLOCK_BYTES = 8
+
+# The tick, the row offset and the number of synapses of each entry
+ENTRY_HEADER_WORDS = 3
+
+# The number of changes recorded and the number lost
+N_PROVENANCE_WORDS = 2
+
+# The bits of the control word of a synapse that hold its target
+_TARGET_MASK = 0xFF
+
+WEIGHT_HISTORY_DTYPE = [
+    ("time", "float64"), ("source", "uint32"), ("target", "uint32"),
+    ("weight", "float64")]
+
+
+class RecordedBlock(object):
+    """ A block of rows of a projection written to the synaptic matrix of a\
+        core, whose weight changes the core records
+    """
+
+    __slots__ = [
+        "_synapse_info", "_offset", "_n_bytes", "_row_n_bytes",
+        "_pre_vertex_slice", "_post_vertex_slice", "_weight_scale"]
+
+    def __init__(
+            self, synapse_info, offset, n_bytes, row_n_bytes,
+            pre_vertex_slice, post_vertex_slice, weight_scale):
+        """
+
+        :param synapse_info: The synapse information of the projection
+        :param offset: The offset of the block from the first block
+        :param n_bytes: The size of the block
+        :param row_n_bytes: The size of each row of the block
+        :param pre_vertex_slice: The slice of the sources; rows past the end\
+            of the slice are the delayed rows of later delay stages
+        :param post_vertex_slice: The slice of the targets
+        :param weight_scale: The scale of the weights of the block
+        """
+        self._synapse_info = synapse_info
+        self._offset = offset
+        self._n_bytes = n_bytes
+        self._row_n_bytes = row_n_bytes
+        self._pre_vertex_slice = pre_vertex_slice
+        self._post_vertex_slice = post_vertex_slice
+        self._weight_scale = weight_scale
+
+    @property
+    def synapse_info(self):
+        return self._synapse_info
+
+    @property
+    def offset(self):
+        return self._offset
+
+    @property
+    def n_bytes(self):
+        return self._n_bytes
+
+    def contains(self, offset):
+        """ Determine if a row offset is in the block
+        """
+        return self._offset <= offset < self._offset + self._n_bytes
+
+    def get_source(self, offset):
+        """ Get the source atom of the row at an offset in the block
+        """
+        row = (offset - self._offset) // self._row_n_bytes
+        return self._pre_vertex_slice.lo_atom + (
+            row % self._pre_vertex_slice.n_atoms)
+
+    def get_targets(self, words):
+        """ Get the target atoms of the recorded words of synapses
+        """
+        return (words & _TARGET_MASK) + self._post_vertex_slice.lo_atom
+
+    def get_weights(self, words):
+        """ Get the weights of the recorded words of synapses
+        """
+        return (words >> 16) / self._weight_scale
+
+
+def get_params_size(n_blocks):
+    """ Get the size of the weight recording region for a number of blocks
+    """
+    return PARAMS_HEADER_BYTES + (n_blocks * PARAMS_BLOCK_BYTES)
+
+
+def write_params(spec, region, interval_ticks, blocks):
+    """ Write the weight recording region
+
+    :param interval_ticks: The ticks between flushes, or 0 not to record
+    :param blocks: The RecordedBlock of each block to record
+    """
+    spec.switch_write_focus(region)
+    spec.write_value(interval_ticks)
+    spec.write_value(BUFFER_WORDS)
+    spec.write_value(len(blocks))
+    for block in blocks:
+        spec.write_value(block.offset)
+        spec.write_value(block.n_bytes)
+
+
+def read_weight_changes(data, blocks, synapse_info, ms_per_tick):
+    """ Decode the weight changes recorded by a core for a projection
+
+    :param data: The bytes recorded by the core
+    :param blocks: The RecordedBlock of each block the core recorded
+    :param synapse_info: The synapse information of the projection
+    :param ms_per_tick: The length of a tick in milliseconds
+    :return: numpy array of WEIGHT_HISTORY_DTYPE, in the order recorded
+    """
+    blocks = [block for block in blocks if block.synapse_info is synapse_info]
+    words = numpy.frombuffer(bytes(data), dtype="<u4")
+    changes = list()
+    index = 0
+    while index + ENTRY_HEADER_WORDS <= len(words):
+        time, offset, n_synapses = words[index:index + ENTRY_HEADER_WORDS]
+        synapse_words = words[
+            index + ENTRY_HEADER_WORDS:
+            index + ENTRY_HEADER_WORDS + n_synapses]
+        index += ENTRY_HEADER_WORDS + int(n_synapses)
+        for block in blocks:
+            if block.contains(offset):
+                entry = numpy.zeros(
+                    len(synapse_words), dtype=WEIGHT_HISTORY_DTYPE)
+                entry["time"] = time * ms_per_tick
+                entry["source"] = block.get_source(offset)
+                entry["target"] = block.get_targets(synapse_words)
+                entry["weight"] = block.get_weights(synapse_words)
+                changes.append(entry)
+                break
+    if len(changes) == 0:
+        return numpy.zeros(0, dtype=WEIGHT_HISTORY_DTYPE)
+    return numpy.concatenate(changes)
@@ -0,0 +1,85 @@
+"""
+Compiling and running of small programs on the host that include the\
+headers of the neural models, so that the C code itself is tested
+"""
+import os
+import shutil
+import subprocess
+import tempfile
+import unittest
+
+_TESTS_DIR = os.path.dirname(os.path.abspath(__file__))
+_SRC_DIR = os.path.join(
+    _TESTS_DIR, os.pardir, os.pardir, "neural_modelling", "src")
+
+# The stand-ins for spinnaker_tools come first, then the model sources; the
+# models are built with FLOATING_POINT so that no fixed-point compiler is
+# needed on the host, and without the extensions of the C library, whose
+# key_t would clash with that of the models
+_INCLUDE_DIRS = [
+    os.path.join(_TESTS_DIR, "stubs"),
+    os.path.join(_SRC_DIR, "common"),
+    os.path.join(_SRC_DIR, "neuron")]
+_FLAGS = [
+    "-std=c99", "-D_POSIX_C_SOURCE=200112L", "-O2", "-Wall",
+    "-Wno-unused-variable", "-Wno-format", "-DFLOATING_POINT"]
+
+
+def _find_compiler():
+    names = ["cc", "gcc", "clang"]
+    if "CC" in os.environ:
+        names.insert(0, os.environ["CC"])
+    for name in names:
+        for path in os.environ.get("PATH", "").split(os.pathsep):
+            compiler = os.path.join(path, name)
+            if os.path.isfile(compiler) and os.access(compiler, os.X_OK):
+                return compiler
+    return None
+
+
+def _run_command(command, description):
+    """ Run a command, giving its standard output; the standard error, where\
+        the compiler and the log of a program write, is only shown if the\
+        command fails
+    """
+    process = subprocess.Popen(
+        command, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    output, errors = process.communicate()
+    output = output.decode("ascii", "replace")
+    if process.returncode != 0:
+        raise AssertionError("{} failed with status {}:\n{}{}".format(
+            description, process.returncode, output,
+            errors.decode("ascii", "replace")))
+    return output
+
+
+def run(source, args=(), defines=(), libraries=()):
+    """ Compile a test program from this directory and run it, skipping the\
+        test if there is no C compiler
+
+    :param source: The name of the C file of the program
+    :param args: The arguments to run the program with
+    :param defines: The macros to define when compiling, as NAME or\
+        NAME=VALUE
+    :param libraries: The libraries to link with
+    :return: The output of the program
+    :raise AssertionError: If the program could not be compiled, or did not\
+        exit with status 0
+    """
+    compiler = _find_compiler()
+    if compiler is None:
+        raise unittest.SkipTest("No C compiler found")
+    build_dir = tempfile.mkdtemp()
+    try:
+        executable = os.path.join(build_dir, "test")
+        command = [compiler] + _FLAGS
+        command.extend("-I" + include_dir for include_dir in _INCLUDE_DIRS)
+        command.extend("-D" + define for define in defines)
+        command.extend(["-o", executable, os.path.join(_TESTS_DIR, source)])
+        command.extend("-l" + library for library in libraries)
+        _run_command(command, "Compiling {}".format(source))
+        return _run_command(
+            [executable] + [str(arg) for arg in args],
+            "Running {}".format(source))
+    finally:
+        shutil.rmtree(build_dir)
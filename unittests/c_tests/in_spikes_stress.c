@@ -0,0 +1,100 @@
+//! \file
+//! \brief Runs the producer and consumer of the input spike buffer in two
+//!        threads, checking that every spike added is taken once and in
+//!        order, and that every spike not added is counted as an overflow.
+//!        Each spike is sent twice in a row, so that the consumer also
+//!        merges equal spikes as the spike processing does.
+//!
+//! usage: in_spikes_stress n_spikes buffer_size
+
+#include <pthread.h>
+#include <sched.h>
+#include <in_spikes.h>
+
+static uint32_t n_spikes;
+static uint32_t n_sent = 0;
+static uint32_t n_not_added = 0;
+static volatile bool producer_done = false;
+
+static void *producer(void *arg) {
+    use(arg);
+    for (uint32_t i = 0; i < n_spikes; i++) {
+        if (!in_spikes_add_spike(i >> 1)) {
+            n_not_added++;
+
+            // Let the consumer run, so that the buffer doesn't stay full
+            // when the threads share a processor
+            sched_yield();
+        }
+        n_sent++;
+    }
+    __atomic_store_n(&producer_done, true, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        return 2;
+    }
+    n_spikes = strtoul(argv[1], NULL, 0);
+    if (!in_spikes_initialize_spike_buffer(strtoul(argv[2], NULL, 0))) {
+        return 2;
+    }
+
+    pthread_t producer_thread;
+    pthread_create(&producer_thread, NULL, producer, NULL);
+
+    // Each spike taken must be after the last, and each can be taken at
+    // most twice
+    uint32_t n_taken = 0;
+    uint32_t n_merged = 0;
+    int64_t last_spike = -1;
+    uint32_t n_last_spike = 0;
+    while (true) {
+        bool done = __atomic_load_n(&producer_done, __ATOMIC_ACQUIRE);
+        spike_t spike;
+        if (!in_spikes_get_next_spike(&spike)) {
+            if (done && in_spikes_is_empty()) {
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+        uint32_t n_equal = 1;
+        while (in_spikes_is_next_spike_equal(spike)) {
+            n_equal++;
+        }
+        n_taken += n_equal;
+        n_merged += n_equal - 1;
+        if ((int64_t) spike < last_spike) {
+            printf("Spike %u taken after %u\n", spike, (uint32_t) last_spike);
+            return 1;
+        }
+        if ((int64_t) spike != last_spike) {
+            n_last_spike = 0;
+        }
+        n_last_spike += n_equal;
+        if (n_last_spike > 2) {
+            printf("Spike %u taken %u times\n", spike, n_last_spike);
+            return 1;
+        }
+        last_spike = spike;
+    }
+    pthread_join(producer_thread, NULL);
+
+    uint32_t n_overflows = in_spikes_get_n_buffer_overflows();
+    if (n_overflows != n_not_added) {
+        printf("%u overflows counted, but %u spikes not added\n",
+               n_overflows, n_not_added);
+        return 1;
+    }
+    if (n_taken + n_overflows != n_sent ||
+            n_taken != in_spikes_get_n_taken() ||
+            in_spikes_get_n_added() != in_spikes_get_n_taken()) {
+        printf("%u spikes sent, but %u taken and %u overflows\n",
+               n_sent, n_taken, n_overflows);
+        return 1;
+    }
+    printf("%u %u %u\n", n_taken, n_merged, n_overflows);
+    return 0;
+}
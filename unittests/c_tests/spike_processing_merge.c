@@ -0,0 +1,118 @@
+//! \file
+//! \brief Adds spikes to the input buffer in ticks, then processes them,
+//!        printing the tick, key and multiplicity of each row processed, to
+//!        check how spikes are merged.  The population table gives each key
+//!        a direct row holding the key.
+//!
+//! usage: spike_processing_merge (t<tick> | <key>)...
+//!        where t<tick> starts a tick and <key> adds a spike in it
+
+#include <spin1_api.h>
+#include <stdfix-full-iso.h>
+#include <spike_processing.c>
+
+volatile uint tc[16];
+
+uint spin1_int_disable(void) {
+    return 0;
+}
+
+void spin1_mode_restore(uint cpsr) {
+    use(cpsr);
+}
+
+uint spin1_dma_transfer(
+        uint tag, void *system_address, void *tcm_address, uint direction,
+        uint length) {
+    use(tag);
+    use(system_address);
+    use(tcm_address);
+    use(direction);
+    use(length);
+    return 1;
+}
+
+uint spin1_trigger_user_event(uint arg0, uint arg1) {
+    use(arg0);
+    use(arg1);
+    return 1;
+}
+
+void spin1_callback_on(uint event_id, void *callback, int priority) {
+    use(event_id);
+    use(callback);
+    use(priority);
+}
+
+void rt_error(uint code, ...) {
+    printf("rt_error %u\n", code);
+    exit(1);
+}
+
+static uint32_t direct_row[1];
+
+bool population_table_get_first_address(
+        spike_t spike, address_t* row_address, size_t* n_bytes_to_transfer) {
+    direct_row[0] = spike;
+    *row_address = direct_row;
+    *n_bytes_to_transfer = 0;
+    return true;
+}
+
+bool population_table_get_next_address(
+        address_t* row_address, size_t* n_bytes_to_transfer) {
+    use(row_address);
+    use(n_bytes_to_transfer);
+    return false;
+}
+
+address_t row_cache_get_row(address_t row_address) {
+    use(row_address);
+    return NULL;
+}
+
+void input_buffer_policy_overflowed(spike_t key) {
+    use(key);
+}
+
+bool input_buffer_policy_should_drop(spike_t key, uint32_t n_waiting) {
+    use(key);
+    use(n_waiting);
+    return false;
+}
+
+void weight_recording_start_row(address_t row_address, uint32_t time) {
+    use(row_address);
+    use(time);
+}
+
+void weight_recording_end_row() {
+}
+
+uint32_t synapses_get_plastic_time(uint32_t time) {
+    return time;
+}
+
+bool synapses_process_synaptic_row(
+        uint32_t time, synaptic_row_t row, uint32_t multiplicity, bool write,
+        uint32_t process_id) {
+    use(write);
+    use(process_id);
+    printf("%u %u %u\n", time, row[3], multiplicity);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    if (!in_spikes_initialize_spike_buffer(256)) {
+        return 2;
+    }
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == 't') {
+            spike_processing_start_tick(strtoul(&argv[i][1], NULL, 0));
+        } else if (!in_spikes_add_spike(strtoul(argv[i], NULL, 0))) {
+            return 2;
+        }
+    }
+    _setup_synaptic_dma_read();
+    return 0;
+}
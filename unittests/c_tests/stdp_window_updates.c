@@ -0,0 +1,171 @@
+//! \file
+//! \brief Processes random plastic rows and post-synaptic spikes with the
+//!        MAD pair additive rule, printing the input added to the ring
+//!        buffers each tick, and the weights and event history of each row
+//!        at the end.  Built as is, the rows are processed with the window
+//!        updates and their cache; built with PER_SYNAPSE_LOOP, with the loop
+//!        over the events of each synapse, so the outputs of the two builds
+//!        should be the same.
+//!
+//! usage: stdp_window_updates n_ticks seed
+
+#include <spin1_api.h>
+#include <stdfix-full-iso.h>
+#include <math.h>
+#include <plasticity/stdp/weight_dependence/weight_additive_one_term_impl.h>
+#include <plasticity/stdp/timing_dependence/timing_pair_impl.h>
+#ifdef PER_SYNAPSE_LOOP
+#undef SYNAPSE_UPDATES_COMMUTE
+#endif  // PER_SYNAPSE_LOOP
+#include <plasticity/stdp/synapse_dynamics_stdp_mad_impl.c>
+#include <plasticity/common/post_events.c>
+#include <plasticity/stdp/timing_dependence/timing_pair_impl.c>
+#include <plasticity/stdp/weight_dependence/weight_additive_one_term_impl.c>
+
+// Few neurons, so that many synapses of a row share a neuron and a window,
+// and rows longer than a block of window updates
+#define N_NEURONS 5
+#define N_ROWS 8
+#define N_SYNAPSES 75
+#define N_EVENTS_PER_TICK 6
+#define FINE_SIZE 32
+#define COARSE_SIZE 9
+#define LUT_WORDS (3 + (FINE_SIZE / 2) + ((COARSE_SIZE + 1) / 2))
+#define HISTORY_WORDS (sizeof(pre_event_history_t) / sizeof(uint32_t))
+#define ROW_WORDS (4 + HISTORY_WORDS + N_SYNAPSES)
+#define N_RING_BUFFERS (1 << (SYNAPSE_DELAY_BITS + SYNAPSE_TYPE_INDEX_BITS))
+
+void weight_recording_record_synapse(uint32_t control_word, uint32_t weight) {
+    use(control_word);
+    use(weight);
+}
+
+//---------------------------------------
+// Random inputs
+//---------------------------------------
+static uint32_t random_state;
+
+static uint32_t _random() {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+//! \brief writes the decay table of a time constant, as the host lays it out
+static uint32_t *_write_lut(uint32_t *address, double tau) {
+    address[0] = 0;
+    address[1] = FINE_SIZE;
+    address[2] = COARSE_SIZE;
+    int16_t *fine = (int16_t *) &address[3];
+    int16_t *coarse = (int16_t *) &address[3 + (FINE_SIZE / 2)];
+    for (uint32_t i = 0; i < FINE_SIZE; i++) {
+        fine[i] = (int16_t) round(
+            (1 << EXP_DECAY_FIXED_POINT) * exp(-(double) i / tau));
+    }
+    for (uint32_t i = 0; i < COARSE_SIZE - 1; i++) {
+        coarse[i] = (int16_t) round(
+            (1 << EXP_DECAY_FIXED_POINT) *
+            exp(-(double) (i * FINE_SIZE) / tau));
+    }
+    coarse[COARSE_SIZE - 1] = 0;
+    return address + LUT_WORDS;
+}
+
+//! \brief writes a row of random plastic synapses, each with one of a few
+//!        dendritic delays, including the whole ring buffer, and an axonal
+//!        delay no more than it
+static void _write_row(
+        uint32_t *plastic_region, uint32_t *fixed_region) {
+    static const uint32_t dendritic_delays[] = {1, 2, 3, 16};
+    memset(plastic_region, 0, HISTORY_WORDS * sizeof(uint32_t));
+    fixed_region[0] = 0;
+    fixed_region[1] = N_SYNAPSES;
+    plastic_synapse_t *weights = _plastic_synapses(plastic_region);
+    control_t *controls = (control_t *) _plastic_controls(
+        plastic_region, fixed_region);
+    for (uint32_t i = 0; i < N_SYNAPSES; i++) {
+        uint32_t delay_dendritic = dendritic_delays[_random() & 3];
+        uint32_t max_axonal = MIN(
+            MIN(delay_dendritic, 16 - delay_dendritic),
+            SYNAPSE_AXONAL_DELAY_MASK);
+        uint32_t delay_axonal = _random() % (max_axonal + 1);
+        controls[i * PLASTIC_ROW_STRIDE] =
+            (delay_axonal << SYNAPSE_DELAY_TYPE_INDEX_BITS)
+            | ((delay_dendritic & SYNAPSE_DELAY_MASK)
+               << SYNAPSE_TYPE_INDEX_BITS)
+            | ((_random() & SYNAPSE_TYPE_MASK) << SYNAPSE_INDEX_BITS)
+            | (_random() % N_NEURONS);
+        weights[i * PLASTIC_ROW_STRIDE] = _random() & 0xFFF;
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        return 2;
+    }
+    uint32_t n_ticks = strtoul(argv[1], NULL, 0);
+    random_state = strtoul(argv[2], NULL, 0) | 1;
+
+    // The decay tables of tau+ and tau-, then the weight dependence of each
+    // synapse type
+    static uint32_t region[(2 * LUT_WORDS) + (4 * SYNAPSE_TYPE_COUNT)];
+    uint32_t *address = _write_lut(region, 16.7);
+    address = _write_lut(address, 33.7);
+    for (uint32_t s = 0; s < SYNAPSE_TYPE_COUNT; s++) {
+        *address++ = 0;
+        *address++ = 0x7FFF;
+        *address++ = 0x200 + (s * 0x80);
+        *address++ = 0x180;
+    }
+    uint32_t shifts[SYNAPSE_TYPE_COUNT] = {0};
+    if (!synapse_dynamics_initialise(region, N_NEURONS, shifts)) {
+        return 2;
+    }
+
+    static uint32_t rows[N_ROWS][ROW_WORDS];
+    uint32_t plastic_words = HISTORY_WORDS + (
+        (N_SYNAPSES * PLASTIC_ROW_STRIDE * sizeof(plastic_synapse_t) + 3) / 4);
+    for (uint32_t r = 0; r < N_ROWS; r++) {
+        _write_row(&rows[r][0], &rows[r][plastic_words]);
+    }
+
+    // Each tick, rows and neurons spike in a random order, some more than
+    // once, and the input to the ring buffers of the tick is printed and
+    // cleared, as the neurons would use it
+    static weight_t ring_buffers[N_RING_BUFFERS];
+    for (uint32_t t = 1; t <= n_ticks; t++) {
+        for (uint32_t e = 0; e < N_EVENTS_PER_TICK; e++) {
+            uint32_t source = _random() % (N_ROWS + N_NEURONS);
+            if (source < N_ROWS) {
+                plastic_write_back_t write_back;
+                synapse_dynamics_write_back_none(&write_back);
+                synapse_dynamics_process_plastic_synapses(
+                    &rows[source][0], &rows[source][plastic_words],
+                    ring_buffers, t, &write_back);
+            } else {
+                synapse_dynamics_process_post_synaptic_event(
+                    t, source - N_ROWS);
+            }
+        }
+        uint32_t first = synapses_get_ring_buffer_index_combined(t, 0);
+        for (uint32_t i = 0; i <= SYNAPSE_TYPE_INDEX_MASK; i++) {
+            if (ring_buffers[first + i] != 0) {
+                printf("%u input %u %u\n", t, i, ring_buffers[first + i]);
+                ring_buffers[first + i] = 0;
+            }
+        }
+    }
+
+    for (uint32_t r = 0; r < N_ROWS; r++) {
+        const pre_event_history_t *history = _plastic_event_history(rows[r]);
+        printf("row %u history %u %d\n",
+               r, history->prev_time, history->prev_trace);
+        const plastic_synapse_t *weights = _plastic_synapses(rows[r]);
+        for (uint32_t i = 0; i < N_SYNAPSES; i++) {
+            printf("row %u synapse %u weight %u\n",
+                   r, i, weights[i * PLASTIC_ROW_STRIDE]);
+        }
+    }
+    return 0;
+}
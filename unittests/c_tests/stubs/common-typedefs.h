@@ -0,0 +1,30 @@
+/*! \file
+ *
+ *  \brief host stand-in for the common types of spinnaker_tools, so that
+ *  the headers of the models can be compiled into tests on the host
+ */
+
+#ifndef _COMMON_TYPEDEFS_H_
+#define _COMMON_TYPEDEFS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef uint32_t *address_t;
+typedef uint32_t index_t;
+typedef uint32_t counter_t;
+typedef unsigned int uint;
+
+// The C library has its own timer_t, which the models don't use
+#define timer_t uint32_t
+
+#define __int_t(n) __int_t_(n)
+#define __int_t_(n) int##n##_t
+#define __uint_t(n) __uint_t_(n)
+#define __uint_t_(n) uint##n##_t
+
+#define __type_of__ __typeof__
+#define use(x) do {} while ((x) != (x))
+
+#endif // _COMMON_TYPEDEFS_H_
@@ -0,0 +1,31 @@
+/*! \file
+ *
+ *  \brief host stand-in for the logging of spinnaker_tools
+ */
+
+#ifndef _DEBUG_H_
+#define _DEBUG_H_
+
+#include <spin1_api.h>
+
+#define LOG_ERROR 10
+#define LOG_WARNING 20
+#define LOG_INFO 30
+#define LOG_DEBUG 40
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_INFO
+#endif
+
+// The log goes to stderr, so that the output of a test is only its results
+#define _log(...) do { \
+    fprintf(stderr, __VA_ARGS__); \
+    fprintf(stderr, "\n"); \
+} while (0)
+
+#define log_error(...) _log(__VA_ARGS__)
+#define log_warning(...) _log(__VA_ARGS__)
+#define log_info(...) _log(__VA_ARGS__)
+#define log_debug(...) do {} while (0)
+
+#endif // _DEBUG_H_
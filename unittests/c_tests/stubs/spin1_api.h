@@ -0,0 +1,59 @@
+/*! \file
+ *
+ *  \brief host stand-in for the parts of the spin1 API that the headers of
+ *  the models use
+ */
+
+#ifndef _SPIN1_API_H_
+#define _SPIN1_API_H_
+
+#include <common-typedefs.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IO_BUF 0
+#define IO_STD 1
+
+#define MC_PACKET_RECEIVED 0
+#define DMA_TRANSFER_DONE 1
+#define USER_EVENT 2
+#define TIMER_TICK 3
+#define SDP_PACKET_RX 4
+#define MCPL_PACKET_RECEIVED 7
+
+#define DMA_READ 0
+#define DMA_WRITE 1
+
+#define RTE_SWERR 1
+#define RTE_API 2
+
+#define T1_LOAD 0
+#define T1_COUNT 1
+#define T2_LOAD 8
+#define T2_COUNT 9
+#define T2_CONTROL 10
+
+#define spin1_malloc(size) malloc(size)
+#define spin1_memcpy(dst, src, n_bytes) memcpy(dst, src, n_bytes)
+#define io_printf(stream, ...) printf(__VA_ARGS__)
+
+// The timer registers and system variables; a test that uses them defines
+// them
+extern volatile uint tc[];
+typedef struct sv_t {
+    uint cpu_clk;
+} sv_t;
+extern sv_t *sv;
+
+// The API calls that a test that uses them defines
+uint spin1_int_disable(void);
+void spin1_mode_restore(uint cpsr);
+uint spin1_dma_transfer(
+    uint tag, void *system_address, void *tcm_address, uint direction,
+    uint length);
+uint spin1_trigger_user_event(uint arg0, uint arg1);
+void spin1_callback_on(uint event_id, void *callback, int priority);
+void rt_error(uint code, ...);
+
+#endif // _SPIN1_API_H_
@@ -0,0 +1,11 @@
+/*! \file
+ *
+ *  \brief host stand-in for the compile-time assertion of spinn_common
+ */
+
+#ifndef _STATIC_ASSERT_H_
+#define _STATIC_ASSERT_H_
+
+#define static_assert(condition, message) _Static_assert(condition, message)
+
+#endif // _STATIC_ASSERT_H_
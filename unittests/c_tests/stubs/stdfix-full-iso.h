@@ -0,0 +1,16 @@
+/*! \file
+ *
+ *  \brief host stand-in for the integer types of the fixed-point types,
+ *  which the models use to reinterpret the bits of a value even when they
+ *  are built with FLOATING_POINT
+ */
+
+#ifndef _STDFIX_FULL_ISO_H_
+#define _STDFIX_FULL_ISO_H_
+
+#include <common-typedefs.h>
+
+typedef int32_t s1615;
+typedef int32_t int_k_t;
+
+#endif // _STDFIX_FULL_ISO_H_
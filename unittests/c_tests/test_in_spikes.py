@@ -0,0 +1,29 @@
+import unittest
+from unittests.c_tests import c_harness
+
+
+class TestInSpikes(unittest.TestCase):
+
+    def _run(self, n_spikes, buffer_size):
+        output = c_harness.run(
+            "in_spikes_stress.c", [n_spikes, buffer_size],
+            libraries=["pthread"])
+        return [int(value) for value in output.split()]
+
+    def test_stress(self):
+
+        # A small buffer overflows; the program checks that the spikes
+        # taken and the overflows account for every spike sent, in order
+        n_taken, n_merged, n_overflows = self._run(2000000, 16)
+        self.assertEqual(n_taken + n_overflows, 2000000)
+        self.assertGreater(n_taken, 0)
+
+    def test_no_overflow(self):
+        n_taken, n_merged, n_overflows = self._run(1000, 2000)
+        self.assertEqual(n_taken, 1000)
+        self.assertEqual(n_overflows, 0)
+        self.assertLessEqual(n_merged, 500)
+
+
+if __name__ == '__main__':
+    unittest.main()
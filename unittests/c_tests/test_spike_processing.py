@@ -0,0 +1,41 @@
+import unittest
+from unittests.c_tests import c_harness
+
+
+def _process(*spikes):
+    """ Add spikes in ticks and process them, giving the (tick, key,\
+        multiplicity) of each row processed
+    """
+    output = c_harness.run(
+        "spike_processing_merge.c", spikes,
+        defines=["SYNAPSE_TYPE_BITS=1", "SYNAPSE_TYPE_COUNT=2"])
+    return [tuple(int(value) for value in line.split())
+            for line in output.splitlines()]
+
+
+class TestSpikeProcessing(unittest.TestCase):
+
+    def test_merge_equal_spikes(self):
+        self.assertEqual(
+            _process("t0", 5, 5, 5, 7, 5),
+            [(0, 5, 3), (0, 7, 1), (0, 5, 1)])
+
+    def test_merge_stops_at_tick_boundary(self):
+
+        # The copies of a spike on each side of a boundary are processed
+        # for the tick that each arrived in
+        self.assertEqual(
+            _process("t0", 5, 5, "t1", 5, 5, 7, "t2", 7),
+            [(0, 5, 2), (1, 5, 2), (1, 7, 1), (2, 7, 1)])
+
+    def test_merge_at_boundary_of_late_spike(self):
+
+        # Spikes from before the oldest tick remembered are processed for
+        # that tick, and the boundary after it still stops their merge
+        self.assertEqual(
+            _process("t0", 5, "t1", 5, "t2", "t3", "t4", 5, "t5", 5),
+            [(2, 5, 2), (4, 5, 1), (5, 5, 1)])
+
+
+if __name__ == '__main__':
+    unittest.main()
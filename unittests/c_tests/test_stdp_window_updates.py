@@ -0,0 +1,29 @@
+import unittest
+from unittests.c_tests import c_harness
+
+_DEFINES = ["SYNAPSE_TYPE_BITS=1", "SYNAPSE_TYPE_COUNT=2"]
+
+
+def _run(seed, *defines):
+    return c_harness.run(
+        "stdp_window_updates.c", [1000, seed],
+        defines=_DEFINES + list(defines), libraries=["m"])
+
+
+class TestSTDPWindowUpdates(unittest.TestCase):
+
+    def test_window_updates_match_per_synapse_loop(self):
+
+        # The input and weights of the window updates, and their cache, must
+        # be those of the loop over the events of each synapse, whichever way
+        # the events and rows are held
+        for seed in (1, 12345):
+            expected = _run(seed, "PER_SYNAPSE_LOOP")
+            self.assertIn("weight", expected)
+            self.assertEqual(_run(seed), expected)
+            self.assertEqual(_run(seed, "POST_EVENTS_COMPACT"), expected)
+            self.assertEqual(_run(seed, "PLASTIC_ROWS_INTERLEAVED"), expected)
+
+
+if __name__ == '__main__':
+    unittest.main()
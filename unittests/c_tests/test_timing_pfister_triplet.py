@@ -0,0 +1,19 @@
+import unittest
+from unittests.c_tests import c_harness
+
+
+class TestTimingPfisterTriplet(unittest.TestCase):
+
+    def test_packed_traces_are_bit_exact(self):
+
+        # The program compares each result of the packed traces with that
+        # of a structure of two traces, and fails on the first difference
+        for seed in (1, 12345):
+            output = c_harness.run(
+                "timing_pfister_triplet_packed.c", [200000, seed],
+                defines=["SYNAPSE_TYPE_BITS=1", "SYNAPSE_TYPE_COUNT=2"])
+            self.assertEqual(int(output), 200000)
+
+
+if __name__ == '__main__':
+    unittest.main()
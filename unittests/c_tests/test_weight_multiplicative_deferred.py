@@ -0,0 +1,20 @@
+import unittest
+from unittests.c_tests import c_harness
+
+
+class TestWeightMultiplicativeDeferred(unittest.TestCase):
+
+    def test_large_sums_are_exact(self):
+
+        # The program compares each final weight with the same maths in 64
+        # bits, and fails on the first difference
+        for seed in (1, 12345):
+            output = c_harness.run(
+                "weight_multiplicative_deferred.c", [20000, seed],
+                defines=["SYNAPSE_TYPE_BITS=1", "SYNAPSE_TYPE_COUNT=2",
+                         "WEIGHT_UPDATES_DEFERRED"])
+            self.assertEqual(int(output), 20000)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,199 @@
+//! \file
+//! \brief Checks that the triplet rule, which keeps each pair of traces
+//!        packed in a word and multiplies the halves in place, gives
+//!        bit-identical results to the same maths on a structure of two
+//!        16-bit traces, over random traces, times and decay tables,
+//!        including traces whose halves have overflowed 16 bits.
+//!
+//! usage: timing_pfister_triplet_packed n_cases seed
+
+#include <spin1_api.h>
+#include <stdfix-full-iso.h>
+#include <plasticity/stdp/weight_dependence/weight_additive_two_term_impl.h>
+#include <plasticity/stdp/timing_dependence/timing_pfister_triplet_impl.h>
+#include <plasticity/stdp/weight_dependence/weight_additive_two_term_impl.c>
+#include <plasticity/stdp/timing_dependence/timing_pfister_triplet_impl.c>
+
+#define FINE_SIZE 32
+#define COARSE_SIZE 9
+#define LUT_WORDS (3 + (FINE_SIZE / 2) + ((COARSE_SIZE + 1) / 2))
+
+//---------------------------------------
+// The rule on a structure of two traces
+//---------------------------------------
+typedef struct trace_pair_t {
+    int16_t first;
+    int16_t second;
+} trace_pair_t;
+
+static trace_pair_t _add_post_spike(
+        uint32_t time, uint32_t last_time, trace_pair_t last_trace) {
+    uint32_t delta_time = time - last_time;
+    int32_t decayed_o1 = STDP_FIXED_MUL_16X16(
+        last_trace.first, DECAY_LOOKUP_TAU_MINUS(delta_time));
+    int32_t new_o1 = decayed_o1 + STDP_FIXED_POINT_ONE;
+    int32_t new_o2 = (last_time == 0)? 0: STDP_FIXED_MUL_16X16(
+        last_trace.second + STDP_FIXED_POINT_ONE,
+        DECAY_LOOKUP_TAU_Y(delta_time));
+    return (trace_pair_t) {.first = new_o1, .second = new_o2};
+}
+
+static trace_pair_t _add_pre_spike(
+        uint32_t time, uint32_t last_time, trace_pair_t last_trace) {
+    uint32_t delta_time = time - last_time;
+    int32_t decayed_r1 = STDP_FIXED_MUL_16X16(
+        last_trace.first, DECAY_LOOKUP_TAU_PLUS(delta_time));
+    int32_t new_r1 = decayed_r1 + STDP_FIXED_POINT_ONE;
+    int32_t new_r2 = (last_time == 0)? 0: STDP_FIXED_MUL_16X16(
+        last_trace.second + STDP_FIXED_POINT_ONE,
+        DECAY_LOOKUP_TAU_X(delta_time));
+    return (trace_pair_t) {.first = new_r1, .second = new_r2};
+}
+
+static update_state_t _apply_pre_spike(
+        uint32_t time, trace_pair_t trace, uint32_t last_post_time,
+        trace_pair_t last_post_trace, update_state_t previous_state) {
+    uint32_t time_since_last_post = time - last_post_time;
+    if (time_since_last_post > 0) {
+        int32_t decayed_o1 = STDP_FIXED_MUL_16X16(
+            last_post_trace.first,
+            DECAY_LOOKUP_TAU_MINUS(time_since_last_post));
+        int32_t decayed_o1_r2 = STDP_FIXED_MUL_16X16(decayed_o1, trace.second);
+        return weight_two_term_apply_depression(
+            previous_state, decayed_o1, decayed_o1_r2);
+    }
+    return previous_state;
+}
+
+static update_state_t _apply_post_spike(
+        uint32_t time, trace_pair_t trace, uint32_t last_pre_time,
+        trace_pair_t last_pre_trace, update_state_t previous_state) {
+    uint32_t time_since_last_pre = time - last_pre_time;
+    if (time_since_last_pre > 0) {
+        int32_t decayed_r1 = STDP_FIXED_MUL_16X16(
+            last_pre_trace.first, DECAY_LOOKUP_TAU_PLUS(time_since_last_pre));
+        int32_t decayed_r1_o2 = STDP_FIXED_MUL_16X16(decayed_r1, trace.second);
+        return weight_two_term_apply_potentiation(
+            previous_state, decayed_r1, decayed_r1_o2);
+    }
+    return previous_state;
+}
+
+//---------------------------------------
+// Random inputs
+//---------------------------------------
+static uint32_t random_state;
+
+static uint32_t _random() {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+static trace_pair_t _unpack(uint32_t word) {
+    return (trace_pair_t) {.first = word, .second = word >> 16};
+}
+
+static uint32_t _pack(trace_pair_t pair) {
+    return maths_pair16_pack(pair.first, pair.second);
+}
+
+//! \brief writes a decay table of random entries, as the host lays it out
+static uint32_t *_write_lut(uint32_t *address) {
+    address[0] = _random() % 3;
+    address[1] = FINE_SIZE;
+    address[2] = COARSE_SIZE;
+    int16_t *entries = (int16_t *) &address[3];
+    for (uint32_t i = 0; i < FINE_SIZE + COARSE_SIZE - 1; i++) {
+        entries[i] = _random() % (1 << EXP_DECAY_FIXED_POINT);
+    }
+    int16_t *coarse = (int16_t *) &address[3 + (FINE_SIZE / 2)];
+    coarse[COARSE_SIZE - 1] = 0;
+    return address + LUT_WORDS;
+}
+
+//! \brief gets a random time since an event, mostly in the range of the
+//!        tables, sometimes past it, and sometimes 0
+static uint32_t _random_delta_time() {
+    switch (_random() & 7) {
+    case 0:
+        return 0;
+    case 1:
+        return _random();
+    default:
+        return _random() & 0x3FF;
+    }
+}
+
+static bool _check(const char *name, uint32_t case_id, uint32_t packed,
+        uint32_t reference) {
+    if (packed != reference) {
+        printf("%s case %u: 0x%08x != 0x%08x\n",
+               name, case_id, packed, reference);
+        return false;
+    }
+    return true;
+}
+
+static bool _check_state(const char *name, uint32_t case_id,
+        update_state_t packed, update_state_t reference) {
+    return _check(name, case_id, packed.a2_plus, reference.a2_plus) &&
+        _check(name, case_id, packed.a2_minus, reference.a2_minus) &&
+        _check(name, case_id, packed.a3_plus, reference.a3_plus) &&
+        _check(name, case_id, packed.a3_minus, reference.a3_minus);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        return 2;
+    }
+    uint32_t n_cases = strtoul(argv[1], NULL, 0);
+    random_state = strtoul(argv[2], NULL, 0) | 1;
+
+    static uint32_t region[4 * LUT_WORDS];
+    uint32_t *address = region;
+    for (uint32_t i = 0; i < 4; i++) {
+        address = _write_lut(address);
+    }
+    if (timing_initialise(region) == NULL) {
+        return 2;
+    }
+
+    for (uint32_t i = 0; i < n_cases; i++) {
+        uint32_t trace = _random();
+        uint32_t last_trace = _random();
+        uint32_t last_time = (_random() & 3) ? _random() : 0;
+        uint32_t time = last_time + _random_delta_time();
+        update_state_t state = weight_get_initial(_random(), 0);
+        state.a2_plus = _random() >> 8;
+        state.a2_minus = _random() >> 8;
+        state.a3_plus = _random() >> 8;
+        state.a3_minus = _random() >> 8;
+
+        if (!_check("add post spike", i,
+                timing_add_post_spike(time, last_time, last_trace),
+                _pack(_add_post_spike(
+                    time, last_time, _unpack(last_trace)))) ||
+            !_check("add pre spike", i,
+                timing_add_pre_spike(time, last_time, last_trace),
+                _pack(_add_pre_spike(
+                    time, last_time, _unpack(last_trace)))) ||
+            !_check_state("apply pre spike", i,
+                timing_apply_pre_spike(
+                    time, trace, 0, 0, last_time, last_trace, state),
+                _apply_pre_spike(
+                    time, _unpack(trace), last_time, _unpack(last_trace),
+                    state)) ||
+            !_check_state("apply post spike", i,
+                timing_apply_post_spike(
+                    time, trace, last_time, last_trace, 0, 0, state),
+                _apply_post_spike(
+                    time, _unpack(trace), last_time, _unpack(last_trace),
+                    state))) {
+            return 1;
+        }
+    }
+    printf("%u\n", n_cases);
+    return 0;
+}
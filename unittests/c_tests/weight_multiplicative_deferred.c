@@ -0,0 +1,91 @@
+//! \file
+//! \brief Checks that the deferred multiplicative weight dependence scales
+//!        sums of updates well beyond 16 bits exactly, comparing the final
+//!        weight with the same maths in 64 bits, over random weights,
+//!        learning rates and sums of updates.
+//!
+//! usage: weight_multiplicative_deferred n_cases seed
+
+#include <spin1_api.h>
+#include <stdfix-full-iso.h>
+#include <plasticity/stdp/weight_dependence/weight_multiplicative_impl.h>
+#include <plasticity/stdp/weight_dependence/weight_multiplicative_impl.c>
+
+//---------------------------------------
+// Random inputs
+//---------------------------------------
+static uint32_t random_state;
+
+static uint32_t _random() {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+//! \brief gets a mask of 12 to 24 bits
+static uint32_t _random_mask() {
+    return (1 << (12 + (_random() % 13))) - 1;
+}
+
+//! \brief the final weight, with the scaled sums found in 64 bits
+static int32_t _reference(
+        const plasticity_weight_region_data_t *region, int32_t weight,
+        int32_t a2_plus, int32_t a2_minus) {
+    int64_t scale_plus = ((region->max_weight - weight) * region->a2_plus)
+        >> region->weight_multiply_right_shift;
+    int64_t scale_minus = ((weight - region->min_weight) * region->a2_minus)
+        >> region->weight_multiply_right_shift;
+    int64_t new_weight = weight
+        + ((a2_plus * scale_plus) >> STDP_FIXED_POINT)
+        - ((a2_minus * scale_minus) >> STDP_FIXED_POINT);
+    return MIN(region->max_weight, MAX(new_weight, region->min_weight));
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        return 2;
+    }
+    uint32_t n_cases = strtoul(argv[1], NULL, 0);
+    random_state = strtoul(argv[2], NULL, 0) | 1;
+
+    for (uint32_t i = 0; i < n_cases; i++) {
+
+        // A learning rate below one in the weight format of the shift, so
+        // that the scales fit in 16 bits, as the host writes them
+        uint32_t shifts[SYNAPSE_TYPE_COUNT];
+        int32_t region[4 * SYNAPSE_TYPE_COUNT];
+        for (uint32_t s = 0; s < SYNAPSE_TYPE_COUNT; s++) {
+            shifts[s] = _random() % 6;
+            uint32_t one = 1 << (15 - shifts[s]);
+            region[(4 * s)] = 0;
+            region[(4 * s) + 1] = 1 + (_random() & 0x7FFE);
+            region[(4 * s) + 2] = _random() % one;
+            region[(4 * s) + 3] = _random() % one;
+        }
+        weight_initialise((uint32_t *) region, shifts);
+
+        uint32_t type = _random() % SYNAPSE_TYPE_COUNT;
+        const plasticity_weight_region_data_t *data =
+            &plasticity_weight_region_data[type];
+        weight_t weight = _random() % (data->max_weight + 1);
+        weight_state_t state = weight_get_initial(weight, type);
+
+        // Sums of up to 2^13 times the largest single update of 2^11, so
+        // that some clamp and some do not
+        state.a2_plus = _random() & _random_mask();
+        state.a2_minus = _random() & _random_mask();
+
+        int32_t reference = _reference(
+            data, weight, state.a2_plus, state.a2_minus);
+        int32_t final_weight = weight_get_final(state);
+        if (final_weight != reference) {
+            printf("case %u: weight %u, a2+ %d, a2- %d: %d != %d\n",
+                   i, weight, state.a2_plus, state.a2_minus, final_weight,
+                   reference);
+            return 1;
+        }
+    }
+    printf("%u\n", n_cases);
+    return 0;
+}
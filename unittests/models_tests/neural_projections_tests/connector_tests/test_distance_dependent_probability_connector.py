@@ -0,0 +1,116 @@
+#!/usr/bin/env python
+import unittest
+import numpy
+from pyNN.random import NumpyRNG
+from pyNN.space import Space
+from pacman.model.graph_mapper.slice import Slice
+from spynnaker.pyNN.models.neural_projections.connectors.\
+    distance_dependent_probability_connector import \
+    DistanceDependentProbabilityConnector
+
+
+class _LinePopulation(object):
+    """ A population with its neurons one unit apart along the x axis
+    """
+
+    def __init__(self, size, label):
+        self.size = size
+        self.label = label
+        self.positions = numpy.zeros((3, size))
+        self.positions[0] = numpy.arange(size)
+
+
+class TestingDistanceDependentProbabilityConnector(unittest.TestCase):
+
+    def _create_connector(self, d_expression, size=100, distinct=False,
+                          **kwargs):
+        connector = DistanceDependentProbabilityConnector(
+            d_expression, weights=1.0, delays=1, space=Space(), **kwargs)
+        pre_population = _LinePopulation(size, "line")
+        post_population = pre_population
+        if distinct:
+            post_population = _LinePopulation(size, "other_line")
+        connector.set_projection_information(
+            pre_population, post_population, NumpyRNG(seed=1), 1000)
+        return connector
+
+    def test_connections_within_support(self):
+        connector = self._create_connector("d < 2.5")
+        pre_slice = Slice(0, 49)
+        post_slice = Slice(40, 99)
+        block = connector.create_synaptic_block(
+            None, 0, None, 0, pre_slice, post_slice, 0)
+        self.assertGreater(len(block), 0)
+        self.assertTrue(numpy.all(
+            numpy.abs(block["source"].astype("int32") -
+                      block["target"].astype("int32")) <= 2))
+
+    def test_distant_slices_are_skipped(self):
+        connector = self._create_connector("d < 2.5")
+        pre_slice = Slice(0, 9)
+        post_slice = Slice(90, 99)
+        self.assertIsNone(connector._get_probs(pre_slice, post_slice))
+        self.assertEqual(
+            connector.get_n_connections_to_post_vertex_maximum(
+                None, 0, None, 0, pre_slice, post_slice), 0)
+        block = connector.create_synaptic_block(
+            None, 0, None, 0, pre_slice, post_slice, 0)
+        self.assertEqual(len(block), 0)
+
+    def test_unbounded_expression_is_not_skipped(self):
+        connector = self._create_connector("exp(-d)")
+        probs = connector._get_probs(Slice(0, 9), Slice(90, 99))
+        self.assertEqual(probs.shape, (10, 10))
+
+    def test_narrow_tail_is_not_skipped(self):
+
+        # Only distances within 0.0005 of 90 connect beyond 2.5, which the
+        # samples of the expression would miss
+        connector = self._create_connector(
+            "(d < 2.5) + ((d > 89.9995) & (d < 90.0005))")
+        pre_slice = Slice(0, 9)
+        post_slice = Slice(90, 99)
+        block = connector.create_synaptic_block(
+            None, 0, None, 0, pre_slice, post_slice, 0)
+        self.assertEqual(len(block), 10)
+        self.assertTrue(numpy.all(block["target"] - block["source"] == 90))
+
+    def test_distance_bounds(self):
+        for expression, bound in (
+                ("d < 2.5", 2.5), ("d <= 3", 3.0), ("4 > d", 4.0),
+                ("exp(-d) * (d < 5)", 5.0), ("(d < 5) & (d < 2 * 3)", 5.0),
+                ("(d < 5) | (d < 7)", 7.0), ("(d < 5) & (d > 1)", 5.0),
+                ("exp(-d)", None), ("(d < 5) + exp(-d)", None),
+                ("d > 5", None), ("1.0", None)):
+            self.assertEqual(
+                self._create_connector(expression)._max_distance, bound,
+                expression)
+
+    def test_constant_expression(self):
+        connector = self._create_connector("1.0")
+        block = connector.create_synaptic_block(
+            None, 0, None, 0, Slice(0, 9), Slice(20, 29), 0)
+        self.assertEqual(len(block), 100)
+
+    def test_no_self_connections(self):
+        connector = self._create_connector(
+            "1.0", allow_self_connections=False)
+        block = connector.create_synaptic_block(
+            None, 0, None, 0, Slice(0, 19), Slice(10, 29), 0)
+        self.assertEqual(len(block), 20 * 20 - 10)
+        self.assertFalse(numpy.any(block["source"] == block["target"]))
+
+    def test_no_self_connections_between_populations(self):
+
+        # Neurons of the same index in different populations are not the
+        # same neuron, so are still connected
+        connector = self._create_connector(
+            "1.0", distinct=True, allow_self_connections=False)
+        block = connector.create_synaptic_block(
+            None, 0, None, 0, Slice(0, 19), Slice(10, 29), 0)
+        self.assertEqual(len(block), 20 * 20)
+        self.assertEqual(numpy.sum(block["source"] == block["target"]), 10)
+
+
+if __name__ == '__main__':
+    unittest.main()
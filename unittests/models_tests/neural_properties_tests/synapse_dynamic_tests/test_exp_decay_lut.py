@@ -0,0 +1,77 @@
+import math
+import unittest
+from spynnaker.pyNN.models.neuron.plasticity.stdp.common \
+    import plasticity_helpers
+
+
+def _single_lut_lookup(time_constant, size, shift):
+    """ A lookup in a single table, as maths_lut_exponential_decay does
+    """
+    lut = [plasticity_helpers.float_to_fixed(
+               math.exp(-float(i << shift) / time_constant),
+               plasticity_helpers.STDP_FIXED_POINT_ONE)
+           for i in range(size)]
+
+    def lookup(time):
+        index = time >> shift
+        return lut[index] if index < size else 0
+    return lookup
+
+
+def _composed_lookup(time_constant):
+    fine_shift, fine, coarse = plasticity_helpers.get_exp_decay_luts(
+        time_constant)
+
+    def lookup(time):
+        return plasticity_helpers.exp_decay_lookup(
+            time, fine_shift, fine, coarse)
+    return lookup
+
+
+class TestExpDecayLut(unittest.TestCase):
+
+    def test_short_time_constant(self):
+        fine_shift, fine_size, coarse_size = \
+            plasticity_helpers.get_exp_decay_lut_shape(20.0)
+        self.assertEqual((fine_shift, fine_size, coarse_size), (0, 256, 2))
+
+        # As accurate as the single table it replaces, to within the
+        # rounding of the product
+        single_error = plasticity_helpers.get_exp_decay_lut_max_error(
+            20.0, 512, _single_lut_lookup(20.0, 256, 0))
+        composed_error = plasticity_helpers.get_exp_decay_lut_max_error(
+            20.0, 512, _composed_lookup(20.0))
+        self.assertLessEqual(composed_error, single_error + 1.0)
+
+    def test_long_time_constant(self):
+
+        # A single table of 256 entries cuts off long before the decay of
+        # a long time constant is zero, but the composed tables do not
+        single_error = plasticity_helpers.get_exp_decay_lut_max_error(
+            1000.0, 10000, _single_lut_lookup(1000.0, 256, 0))
+        composed_error = plasticity_helpers.get_exp_decay_lut_max_error(
+            1000.0, 10000, _composed_lookup(1000.0))
+        self.assertGreater(single_error, 1000.0)
+        self.assertLessEqual(composed_error, 2.0)
+
+    def test_coarse_table_is_bounded(self):
+        fine_shift, fine_size, coarse_size = \
+            plasticity_helpers.get_exp_decay_lut_shape(100000.0)
+        self.assertGreater(fine_shift, 0)
+        self.assertEqual(fine_size, plasticity_helpers.MAX_EXP_DECAY_FINE_SIZE)
+        self.assertLessEqual(
+            coarse_size, plasticity_helpers.MAX_EXP_DECAY_COARSE_SIZE)
+
+    def test_decays_to_zero(self):
+        fine_shift, fine, coarse = plasticity_helpers.get_exp_decay_luts(
+            20.0)
+        self.assertEqual(coarse[-1], 0)
+        self.assertEqual(plasticity_helpers.exp_decay_lookup(
+            100000, fine_shift, fine, coarse), 0)
+        self.assertEqual(
+            plasticity_helpers.get_exp_decay_lut_size_in_bytes(20.0),
+            4 * (3 + 128 + 1))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,67 @@
+import unittest
+from spynnaker.pyNN.models.neuron.synapse_dynamics.synapse_dynamics_stdp \
+    import SynapseDynamicsSTDP
+from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence\
+    .timing_dependence_spike_pair import TimingDependenceSpikePair
+from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence\
+    .timing_dependence_pfister_spike_triplet \
+    import TimingDependencePfisterSpikeTriplet
+from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence\
+    .weight_dependence_additive import WeightDependenceAdditive
+
+
+def _dynamics(timing_dependence, compact_post_history):
+    return SynapseDynamicsSTDP(
+        timing_dependence=timing_dependence,
+        weight_dependence=WeightDependenceAdditive(
+            A3_plus=0.01, A3_minus=0.01),
+        compact_post_history=compact_post_history)
+
+
+class TestSTDPCompactPostHistory(unittest.TestCase):
+
+    def test_executable_suffix(self):
+        self.assertEqual(
+            _dynamics(TimingDependenceSpikePair(), True)
+            .get_vertex_executable_suffix(),
+            "_stdp_mad_compact_pair_additive")
+        self.assertEqual(
+            _dynamics(TimingDependenceSpikePair(), False)
+            .get_vertex_executable_suffix(),
+            "_stdp_mad_pair_additive")
+
+    def test_size_matches_c(self):
+
+        # The epoch, the count, the number of the first event, a 16-bit time
+        # per event, the first and last traces and a trace per 8 events,
+        # padded to a word
+        self.assertEqual(
+            SynapseDynamicsSTDP.get_compact_post_history_bytes(2), 156)
+        self.assertEqual(
+            SynapseDynamicsSTDP.get_compact_post_history_bytes(4), 176)
+
+    def test_dtcm_saving(self):
+        for timing_dependence in (TimingDependenceSpikePair(),
+                                  TimingDependencePfisterSpikeTriplet(
+                                      16.8, 33.7, 101.0, 125.0)):
+            full = _dynamics(timing_dependence, False)
+            compact = _dynamics(timing_dependence, True)
+            per_neuron_full = (
+                full.get_dtcm_usage_in_bytes(256) -
+                full.get_dtcm_usage_in_bytes(0)) / 256.0
+            per_neuron_compact = (
+                compact.get_dtcm_usage_in_bytes(256) -
+                compact.get_dtcm_usage_in_bytes(0)) / 256.0
+            self.assertGreaterEqual(per_neuron_full, 2 * per_neuron_compact)
+            self.assertFalse(full.is_same_as(compact))
+
+    def test_needs_mad(self):
+        with self.assertRaises(NotImplementedError):
+            SynapseDynamicsSTDP(
+                timing_dependence=TimingDependenceSpikePair(),
+                weight_dependence=WeightDependenceAdditive(),
+                mad=False, compact_post_history=True)
+
+
+if __name__ == '__main__':
+    unittest.main()
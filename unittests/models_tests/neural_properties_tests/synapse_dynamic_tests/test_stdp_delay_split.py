@@ -0,0 +1,209 @@
+import math
+import random
+import unittest
+import numpy
+from pacman.model.graph_mapper.slice import Slice
+from spynnaker.pyNN.models.neural_projections.connectors.abstract_connector \
+    import AbstractConnector
+from spynnaker.pyNN.models.neuron.synapse_dynamics.synapse_dynamics_stdp \
+    import SynapseDynamicsSTDP
+from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence\
+    .timing_dependence_spike_pair import TimingDependenceSpikePair
+from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence\
+    .weight_dependence_additive import WeightDependenceAdditive
+
+TAU_PLUS = 20.0
+TAU_MINUS = 20.0
+A_PLUS = 0.1
+A_MINUS = 0.12
+N_SYNAPSE_TYPES = 2
+N_SYNAPSE_TYPE_BITS = 1
+
+
+def _dynamics(dendritic_delay_fraction):
+    return SynapseDynamicsSTDP(
+        timing_dependence=TimingDependenceSpikePair(TAU_PLUS, TAU_MINUS),
+        weight_dependence=WeightDependenceAdditive(
+            A_plus=A_PLUS, A_minus=A_MINUS),
+        dendritic_delay_fraction=dendritic_delay_fraction)
+
+
+def _encode(dynamics, delays):
+    """ Get the plastic control words and the round trip of the connections\
+        with the given delays, one per row
+    """
+    connections = numpy.zeros(
+        len(delays), dtype=AbstractConnector.NUMPY_SYNAPSES_DTYPE)
+    connections["source"] = numpy.arange(len(delays))
+    connections["target"] = numpy.arange(len(delays))
+    connections["weight"] = 0.5
+    connections["delay"] = delays
+    post_slice = Slice(0, len(delays) - 1)
+    fp_data, pp_data, fp_size, pp_size = dynamics.get_plastic_synaptic_data(
+        connections, connections["source"], len(delays), post_slice,
+        N_SYNAPSE_TYPES)
+    controls = numpy.array(
+        [row.view("uint16")[0] for row in fp_data], dtype="uint32")
+    read = dynamics.read_plastic_synaptic_data(
+        post_slice, N_SYNAPSE_TYPES, pp_size.reshape(-1), pp_data,
+        fp_size.reshape(-1), fp_data)
+    return controls, read
+
+
+def _decode_delays(control_word):
+    """ Decode the delays of a plastic control word, as\
+        synapse_dynamics_stdp_mad_impl.c does
+    """
+    control_word = int(control_word)
+    type_index_bits = N_SYNAPSE_TYPE_BITS + 8
+    axonal_bits = 16 - (4 + type_index_bits)
+    dendritic = (((control_word >> type_index_bits) & 0xF) - 1) & 0xF
+    axonal = (control_word >> (4 + type_index_bits)) & (
+        (1 << axonal_bits) - 1)
+    return dendritic + 1, axonal
+
+
+def _deferred_weight_change(pre_times, post_times, dendritic, axonal):
+    """ The weight change of a synapse updated as each pre-synaptic spike is\
+        processed, from the post-synaptic history seen so far, as\
+        synapse_dynamics_stdp_mad_impl.c does with the pair rule
+    """
+    post_times = sorted(post_times)
+    history = [(0, 0.0)]
+    n_posts_seen = 0
+    weight = 0.0
+    last_pre_time = 0
+    last_pre_trace = 0.0
+    for time in pre_times:
+
+        # Post-synaptic spikes are added to the history as they happen
+        while (n_posts_seen < len(post_times) and
+                post_times[n_posts_seen] < time):
+            last_time, last_trace = history[-1]
+            post_time = post_times[n_posts_seen]
+            history.append((post_time, 1.0 + last_trace * math.exp(
+                -(post_time - last_time) / TAU_MINUS)))
+            n_posts_seen += 1
+
+        new_pre_trace = 1.0 + last_pre_trace * math.exp(
+            -(time - last_pre_time) / TAU_PLUS)
+
+        # The window of post-synaptic events to process
+        delayed_last_pre_time = last_pre_time + axonal
+        delayed_pre_time = time + axonal
+        begin = max(delayed_last_pre_time - dendritic, 0)
+        end = max(delayed_pre_time - dendritic, 0)
+        prev_time, prev_trace = history[0]
+        window = list()
+        for post_time, post_trace in history[1:]:
+            if post_time <= begin:
+                prev_time, prev_trace = post_time, post_trace
+            elif post_time <= end:
+                window.append((post_time, post_trace))
+        prev_time += dendritic
+
+        for post_time, post_trace in window:
+            delayed_post_time = post_time + dendritic
+            weight += A_PLUS * last_pre_trace * math.exp(
+                -(delayed_post_time - delayed_last_pre_time) / TAU_PLUS)
+            prev_time, prev_trace = delayed_post_time, post_trace
+
+        if delayed_pre_time > prev_time:
+            weight -= A_MINUS * prev_trace * math.exp(
+                -(delayed_pre_time - prev_time) / TAU_MINUS)
+
+        last_pre_time = time
+        last_pre_trace = new_pre_trace
+    return weight
+
+
+def _event_driven_weight_change(pre_times, post_times, dendritic, axonal):
+    """ The weight change of a synapse which sees each spike in order as it\
+        arrives, up to the arrival of the last pre-synaptic spike
+    """
+    last_arrival = pre_times[-1] + axonal
+    events = [(time + axonal, 1) for time in pre_times]
+    events.extend(
+        (time + dendritic, 0) for time in post_times
+        if time + dendritic <= last_arrival)
+
+    weight = 0.0
+    pre_time = None
+    pre_trace = 0.0
+    post_time = None
+    post_trace = 0.0
+    for time, is_pre in sorted(events):
+        if is_pre:
+            if post_time is not None and time > post_time:
+                weight -= A_MINUS * post_trace * math.exp(
+                    -(time - post_time) / TAU_MINUS)
+            if pre_time is not None:
+                pre_trace *= math.exp(-(time - pre_time) / TAU_PLUS)
+            pre_trace += 1.0
+            pre_time = time
+        else:
+            if pre_time is not None:
+                weight += A_PLUS * pre_trace * math.exp(
+                    -(time - pre_time) / TAU_PLUS)
+            if post_time is not None:
+                post_trace *= math.exp(-(time - post_time) / TAU_MINUS)
+            post_trace += 1.0
+            post_time = time
+    return weight
+
+
+class TestSTDPDelaySplit(unittest.TestCase):
+
+    def test_split(self):
+        delays = numpy.arange(1, 17)
+        for fraction in (1.0, 0.9, 0.75, 0.5):
+            dendritic, axonal = _dynamics(fraction).split_delays(
+                delays, N_SYNAPSE_TYPE_BITS)
+            self.assertTrue(numpy.array_equal(dendritic + axonal, delays))
+            self.assertTrue(numpy.all(axonal <= dendritic))
+            self.assertTrue(numpy.all(axonal < 8))
+        dendritic, axonal = _dynamics(0.5).split_delays(
+            numpy.array([1, 2, 10]), N_SYNAPSE_TYPE_BITS)
+        self.assertEqual(list(axonal), [0, 1, 5])
+
+    def test_no_split_without_mad(self):
+        with self.assertRaises(NotImplementedError):
+            SynapseDynamicsSTDP(
+                timing_dependence=TimingDependenceSpikePair(),
+                weight_dependence=WeightDependenceAdditive(),
+                dendritic_delay_fraction=0.5, mad=False)
+
+    def test_encoding(self):
+        delays = numpy.arange(1, 17)
+        for fraction in (1.0, 0.75, 0.5):
+            dynamics = _dynamics(fraction)
+            dendritic, axonal = dynamics.split_delays(
+                delays, N_SYNAPSE_TYPE_BITS)
+            controls, read = _encode(dynamics, delays)
+            decoded = [_decode_delays(control) for control in controls]
+            self.assertEqual(
+                decoded, list(zip(list(dendritic), list(axonal))))
+            self.assertTrue(numpy.array_equal(read["delay"], delays))
+
+    def test_against_event_driven(self):
+        rng = random.Random(7)
+
+        # Pre-synaptic spikes on even and post-synaptic on odd time steps,
+        # so that no post-synaptic spike is in the same step as a
+        # pre-synaptic one, for which the order is up to the neuron
+        pre_times = sorted(rng.sample(range(2, 400, 2), 20))
+        post_times = sorted(rng.sample(range(1, 400, 2), 30))
+        delays = numpy.arange(1, 17)
+        for fraction in (1.0, 0.75, 0.5):
+            controls, _ = _encode(_dynamics(fraction), delays)
+            for control in controls:
+                dendritic, axonal = _decode_delays(control)
+                self.assertAlmostEqual(
+                    _deferred_weight_change(
+                        pre_times, post_times, dendritic, axonal),
+                    _event_driven_weight_change(
+                        pre_times, post_times, dendritic, axonal))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,112 @@
+import unittest
+import numpy
+from pacman.model.graph_mapper.slice import Slice
+from spynnaker.pyNN.models.neural_projections.connectors.abstract_connector \
+    import AbstractConnector
+from spynnaker.pyNN.models.neuron.synapse_dynamics.synapse_dynamics_stdp \
+    import SynapseDynamicsSTDP
+from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence\
+    .timing_dependence_spike_pair import TimingDependenceSpikePair
+from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence\
+    .weight_dependence_additive import WeightDependenceAdditive
+
+N_SYNAPSE_TYPES = 2
+N_ROWS = 5
+N_NEURONS = 100
+
+
+def _dynamics(interleaved_rows, mad=True):
+    return SynapseDynamicsSTDP(
+        timing_dependence=TimingDependenceSpikePair(),
+        weight_dependence=WeightDependenceAdditive(),
+        mad=mad, interleaved_rows=interleaved_rows)
+
+
+def _connections():
+    """ Connections of rows of different lengths, including an empty row
+    """
+    row_lengths = [0, 1, 2, 7, 40]
+    n_connections = sum(row_lengths)
+    connections = numpy.zeros(
+        n_connections, dtype=AbstractConnector.NUMPY_SYNAPSES_DTYPE)
+    connections["source"] = numpy.repeat(
+        numpy.arange(N_ROWS), row_lengths)
+    connections["target"] = numpy.arange(n_connections) % N_NEURONS
+    connections["weight"] = numpy.arange(n_connections) * 37 + 5
+    connections["delay"] = (numpy.arange(n_connections) % 16) + 1
+    connections["synapse_type"] = numpy.arange(n_connections) % 2
+    return connections, row_lengths
+
+
+def _encode(dynamics, connections):
+    return dynamics.get_plastic_synaptic_data(
+        connections, connections["source"], N_ROWS,
+        Slice(0, N_NEURONS - 1), N_SYNAPSE_TYPES)
+
+
+class TestSTDPInterleavedRows(unittest.TestCase):
+
+    def test_executable_suffix(self):
+        self.assertEqual(
+            _dynamics(True).get_vertex_executable_suffix(),
+            "_stdp_mad_interleaved_pair_additive")
+        self.assertFalse(_dynamics(True).is_same_as(_dynamics(False)))
+
+    def test_needs_mad(self):
+        with self.assertRaises(NotImplementedError):
+            _dynamics(True, mad=False)
+
+    def test_layout(self):
+        split = _dynamics(False)
+        interleaved = _dynamics(True)
+        connections, row_lengths = _connections()
+        fp_data, pp_data, fp_size, pp_size = _encode(split, connections)
+        i_fp_data, i_pp_data, i_fp_size, i_pp_size = _encode(
+            interleaved, connections)
+        n_header_words = interleaved._n_header_bytes // 4
+
+        for row, n_synapses in enumerate(row_lengths):
+
+            # The count of synapses stays in the fixed region, but none of
+            # the control words do
+            self.assertEqual(i_fp_size[row], n_synapses)
+            self.assertEqual(i_fp_data[row].size, 0)
+            self.assertEqual(i_pp_size[row], n_header_words + n_synapses)
+            self.assertEqual(
+                i_pp_size[row],
+                interleaved.get_n_words_for_plastic_connections(n_synapses))
+
+            # Each word holds the weight above the control word, as a fixed
+            # synapse word does
+            controls = fp_data[row].view("uint16")[0:n_synapses]
+            weights = pp_data[row][n_header_words:].view("uint16")[
+                0:n_synapses]
+            words = i_pp_data[row][n_header_words:]
+            self.assertTrue(numpy.array_equal(words & 0xFFFF, controls))
+            self.assertTrue(numpy.array_equal(words >> 16, weights))
+
+            # The row is no larger; it is a word smaller for an odd count
+            self.assertEqual(
+                (pp_size[row] + fp_data[row].size) -
+                (i_pp_size[row] + i_fp_data[row].size), n_synapses % 2)
+        self.assertTrue(numpy.array_equal(
+            interleaved.get_n_fixed_plastic_words_per_row(
+                i_fp_size.reshape(-1)), numpy.zeros(N_ROWS)))
+
+    def test_read_back(self):
+        for interleaved_rows in (False, True):
+            dynamics = _dynamics(interleaved_rows)
+            connections, _ = _connections()
+            fp_data, pp_data, fp_size, pp_size = _encode(
+                dynamics, connections)
+            read = dynamics.read_plastic_synaptic_data(
+                Slice(0, N_NEURONS - 1), N_SYNAPSE_TYPES,
+                pp_size.reshape(-1), pp_data, fp_size.reshape(-1), fp_data)
+            for field in ("source", "target", "weight", "delay"):
+                self.assertTrue(
+                    numpy.array_equal(read[field], connections[field]),
+                    field)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,197 @@
+import random
+import unittest
+from spynnaker.pyNN.models.neuron.plasticity.stdp.common \
+    import plasticity_helpers
+
+STDP_FIXED_POINT = 11
+TAU_PLUS = 20.0
+TAU_MINUS = 20.0
+A_PLUS = 400
+A_MINUS = 480
+MIN_WEIGHT = 0
+MAX_WEIGHT = 4000
+N_WINDOW_UPDATES = 32
+
+_TAU_PLUS_LUTS = plasticity_helpers.get_exp_decay_luts(TAU_PLUS)
+_TAU_MINUS_LUTS = plasticity_helpers.get_exp_decay_luts(TAU_MINUS)
+
+
+def _mul(a, b):
+    return (a * b) >> STDP_FIXED_POINT
+
+
+def _decay(time, luts):
+    return plasticity_helpers.exp_decay_lookup(time, *luts)
+
+
+def _add_spike(time, last_time, last_trace, luts):
+    return plasticity_helpers.STDP_FIXED_POINT_ONE + _mul(
+        last_trace, _decay(time - last_time, luts))
+
+
+def _get_window(history, delayed_last_pre_time, delayed_pre_time, dendritic):
+    """ The window of post-synaptic events of a synapse, as _get_post_window\
+        in synapse_dynamics_stdp_mad_impl.c finds it
+    """
+    begin = max(delayed_last_pre_time - dendritic, 0)
+    end = max(delayed_pre_time - dendritic, 0)
+    prev_time, prev_trace = history[0]
+    events = list()
+    for post_time, post_trace in history[1:]:
+        if post_time <= begin:
+            prev_time, prev_trace = post_time, post_trace
+        elif post_time <= end:
+            events.append((post_time, post_trace))
+    return prev_time + dendritic, prev_trace, events
+
+
+def _apply_window(window, delayed_last_pre_time, last_pre_trace, dendritic,
+                  potentiation):
+    """ Apply the events of a window with the pair rule, returning the\
+        potentiation and the last event of the window
+    """
+    prev_time, prev_trace, events = window
+    for post_time, post_trace in events:
+        delayed_post_time = post_time + dendritic
+        if delayed_post_time > delayed_last_pre_time:
+            potentiation += _mul(last_pre_trace, _decay(
+                delayed_post_time - delayed_last_pre_time, _TAU_PLUS_LUTS))
+        prev_time, prev_trace = delayed_post_time, post_trace
+    return potentiation, prev_time, prev_trace
+
+
+def _depression(delayed_pre_time, prev_time, prev_trace):
+    if delayed_pre_time > prev_time:
+        return _mul(prev_trace, _decay(
+            delayed_pre_time - prev_time, _TAU_MINUS_LUTS))
+    return 0
+
+
+def _final_weight(weight, potentiation, depression):
+    weight += _mul(potentiation, A_PLUS) - _mul(depression, A_MINUS)
+    return min(MAX_WEIGHT, max(weight, MIN_WEIGHT))
+
+
+class _Row(object):
+    """ A plastic row of (post-synaptic neuron, dendritic delay, axonal\
+        delay, weight) synapses, with its pre-synaptic event history
+    """
+
+    def __init__(self, synapses):
+        self.synapses = [list(synapse) for synapse in synapses]
+        self.last_pre_time = 0
+        self.last_pre_trace = 0
+
+    def add_pre_spike(self, time):
+        last = (self.last_pre_time, self.last_pre_trace)
+        self.last_pre_trace = _add_spike(
+            time, self.last_pre_time, self.last_pre_trace, _TAU_PLUS_LUTS)
+        self.last_pre_time = time
+        return last
+
+
+def _process_row_per_synapse(row, time, histories):
+    """ Process a row as the loop over synapses with a loop over the events\
+        of each window does
+    """
+    last_pre_time, last_pre_trace = row.add_pre_spike(time)
+    for synapse in row.synapses:
+        neuron, dendritic, axonal, weight = synapse
+        window = _get_window(
+            histories[neuron], last_pre_time + axonal, time + axonal,
+            dendritic)
+        potentiation, prev_time, prev_trace = _apply_window(
+            window, last_pre_time + axonal, last_pre_trace, dendritic, 0)
+        synapse[3] = _final_weight(
+            weight, potentiation,
+            _depression(time + axonal, prev_time, prev_trace))
+
+
+def _process_row_two_pass(row, time, histories, cache, counts):
+    """ Process a row as the two passes over blocks of synapses do, reusing\
+        the window updates cached for each neuron
+    """
+    last_pre_time, last_pre_trace = row.add_pre_spike(time)
+    for block in range(0, len(row.synapses), N_WINDOW_UPDATES):
+        synapses = row.synapses[block:block + N_WINDOW_UPDATES]
+
+        # The first pass finds the updates of the window of each synapse
+        updates = list()
+        for neuron, dendritic, axonal, _ in synapses:
+            key = (last_pre_time + axonal, max(time + axonal - dendritic, 0),
+                   dendritic, last_pre_trace)
+            if neuron in cache and cache[neuron][0] == key:
+                counts["reused"] += 1
+            else:
+                counts["found"] += 1
+                window = _get_window(
+                    histories[neuron], last_pre_time + axonal, time + axonal,
+                    dendritic)
+                cache[neuron] = (key, _apply_window(
+                    window, last_pre_time + axonal, last_pre_trace,
+                    dendritic, 0))
+            updates.append(cache[neuron][1])
+
+        # The second pass adds them to each synapse
+        for synapse, (potentiation, prev_time, prev_trace) in zip(
+                synapses, updates):
+            _, _, axonal, weight = synapse
+            synapse[3] = _final_weight(
+                weight, potentiation,
+                _depression(time + axonal, prev_time, prev_trace))
+
+
+def _simulate(two_pass, seed=3, n_steps=500):
+    rng = random.Random(seed)
+    n_neurons = 40
+
+    # Pairs of rows with the same spikes, so that their windows are the same,
+    # and rows with several synapses to the same neuron
+    synapses = list()
+    for _ in range(10):
+        row = list()
+        for _ in range(50):
+            dendritic = rng.randint(1, 8)
+            row.append((rng.randrange(n_neurons), dendritic,
+                        rng.randint(0, dendritic), rng.randint(0, 4000)))
+        synapses.append(row)
+    rows = [_Row(row) for row in synapses for _ in range(2)]
+    pre_times = [sorted(rng.sample(range(1, 500), 25)) for _ in synapses]
+
+    histories = [[(0, 0)] for _ in range(n_neurons)]
+    cache = dict()
+    counts = {"found": 0, "reused": 0}
+    for time in range(n_steps):
+        for neuron in range(n_neurons):
+            if rng.random() < 0.04:
+                last_time, last_trace = histories[neuron][-1]
+                histories[neuron].append((time, _add_spike(
+                    time, last_time, last_trace, _TAU_MINUS_LUTS)))
+                cache.pop(neuron, None)
+        for index, row in enumerate(rows):
+            if time in pre_times[index // 2]:
+                if two_pass:
+                    _process_row_two_pass(row, time, histories, cache, counts)
+                else:
+                    _process_row_per_synapse(row, time, histories)
+    return [[synapse[3] for synapse in row.synapses] for row in rows], counts
+
+
+def _initial_weights(seed=3):
+    rows, _ = _simulate(two_pass=False, seed=seed, n_steps=0)
+    return rows
+
+
+class TestSTDPWindowUpdates(unittest.TestCase):
+
+    def test_same_weights(self):
+        per_synapse, _ = _simulate(two_pass=False)
+        two_pass, counts = _simulate(two_pass=True)
+        self.assertNotEqual(per_synapse, _initial_weights())
+        self.assertEqual(per_synapse, two_pass)
+        self.assertGreater(counts["reused"], 0)
+        self.assertGreater(counts["found"], counts["reused"])
+
+
+if __name__ == '__main__':
+    unittest.main()
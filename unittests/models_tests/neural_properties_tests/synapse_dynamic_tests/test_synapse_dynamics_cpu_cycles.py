@@ -0,0 +1,143 @@
+import unittest
+from spynnaker.pyNN.models.neuron.synaptic_manager import SynapticManager
+from spynnaker.pyNN.models.neuron.synapse_dynamics.synapse_dynamics_static \
+    import SynapseDynamicsStatic
+from spynnaker.pyNN.models.neuron.synapse_dynamics.synapse_dynamics_stdp \
+    import SynapseDynamicsSTDP
+from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence\
+    .timing_dependence_spike_pair import TimingDependenceSpikePair
+from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence\
+    .timing_dependence_pfister_spike_triplet \
+    import TimingDependencePfisterSpikeTriplet
+from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence\
+    .weight_dependence_additive import WeightDependenceAdditive
+from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence\
+    .weight_dependence_multiplicative import WeightDependenceMultiplicative
+
+
+def _stdp(timing=None, weight=None, **kwargs):
+    return SynapseDynamicsSTDP(
+        timing_dependence=timing or TimingDependenceSpikePair(),
+        weight_dependence=weight or WeightDependenceMultiplicative(),
+        **kwargs)
+
+
+class _Edge(object):
+
+    def __init__(self, n_delay_stages):
+        self.pre_vertex = None
+        self.n_delay_stages = n_delay_stages
+
+
+class _SynapseInfo(object):
+
+    def __init__(self, synapse_dynamics):
+        self.synapse_dynamics = synapse_dynamics
+
+
+class _SynapseType(object):
+
+    def get_n_synapse_types(self):
+        return 2
+
+
+class _Slice(object):
+
+    def __init__(self, n_atoms):
+        self.n_atoms = n_atoms
+
+
+class TestSynapseDynamicsCPUCycles(unittest.TestCase):
+
+    def test_plastic_costs_more_than_static(self):
+        static = SynapseDynamicsStatic()
+        stdp = _stdp()
+        self.assertGreater(
+            stdp.get_n_cpu_cycles_per_row(),
+            static.get_n_cpu_cycles_per_row())
+        self.assertGreater(
+            stdp.get_n_cpu_cycles_per_synapse(),
+            static.get_n_cpu_cycles_per_synapse())
+
+    def test_mad_costs_less(self):
+        mad = _stdp(mad=True)
+        not_mad = _stdp(mad=False)
+        self.assertLess(
+            mad.get_n_cpu_cycles_per_row(),
+            not_mad.get_n_cpu_cycles_per_row())
+        self.assertLess(
+            mad.get_n_cpu_cycles_per_synapse(),
+            not_mad.get_n_cpu_cycles_per_synapse())
+
+    def test_timing_rule(self):
+        pair = _stdp()
+        triplet = _stdp(timing=TimingDependencePfisterSpikeTriplet(
+            tau_plus=16.8, tau_minus=33.7, tau_x=101, tau_y=125))
+        self.assertGreater(
+            triplet.get_n_cpu_cycles_per_synapse(),
+            pair.get_n_cpu_cycles_per_synapse())
+
+    def test_window_cache(self):
+
+        # Additive and deferred multiplicative updates are found once per
+        # window and added to each synapse; multiplicative ones are not
+        multiplicative = _stdp(weight=WeightDependenceMultiplicative())
+        deferred = _stdp(
+            weight=WeightDependenceMultiplicative(deferred=True))
+        additive = _stdp(weight=WeightDependenceAdditive())
+        self.assertLess(
+            deferred.get_n_cpu_cycles_per_synapse(),
+            multiplicative.get_n_cpu_cycles_per_synapse())
+        self.assertLess(
+            additive.get_n_cpu_cycles_per_synapse(),
+            multiplicative.get_n_cpu_cycles_per_synapse())
+
+        # Without MAD, there is no cache
+        self.assertGreater(
+            _stdp(weight=WeightDependenceAdditive(), mad=False)
+            .get_n_cpu_cycles_per_synapse(),
+            additive.get_n_cpu_cycles_per_synapse())
+
+    def test_compact_history(self):
+        self.assertGreater(
+            _stdp(compact_post_history=True).get_n_cpu_cycles_per_synapse(),
+            _stdp().get_n_cpu_cycles_per_synapse())
+        self.assertEqual(
+            _stdp(compact_post_history=True).get_n_cpu_cycles_per_row(),
+            _stdp().get_n_cpu_cycles_per_row())
+
+    def test_synaptic_manager_n_cpu_cycles(self):
+        static = SynapseDynamicsStatic()
+        stdp = _stdp()
+
+        # Stand in for the estimates of the incoming rows, as the cost is
+        # only the sum of the rows and synapses arriving each timestep
+        manager = SynapticManager.__new__(SynapticManager)
+        manager._synapse_type = _SynapseType()
+        manager._machine_time_step = 1000
+        manager._get_spikes_per_second = lambda vertex, vertex_slice: 10.0
+        edges = [
+            (_Edge(0), _Slice(100), _SynapseInfo(static), 20),
+            (_Edge(1), _Slice(50), _SynapseInfo(stdp), 8),
+            (_Edge(0), _Slice(30), _SynapseInfo(stdp), 0)]
+        manager._get_estimated_row_lengths = \
+            lambda vertex_slice, in_edges: edges
+        base = manager.get_n_cpu_cycles(_Slice(64), [])
+
+        # 100 sources at 10Hz spike once per 1ms timestep; 50 sources with
+        # delays send 2 rows per spike; rows with no synapses cost nothing
+        static_cycles = 1.0 * (
+            static.get_n_cpu_cycles_per_row() +
+            20 * static.get_n_cpu_cycles_per_synapse())
+        stdp_cycles = 0.5 * (
+            2 * stdp.get_n_cpu_cycles_per_row() +
+            8 * stdp.get_n_cpu_cycles_per_synapse())
+        manager._get_estimated_row_lengths = \
+            lambda vertex_slice, in_edges: []
+        self.assertEqual(
+            base - manager.get_n_cpu_cycles(_Slice(64), []),
+            int(static_cycles + stdp_cycles))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,125 @@
+import random
+import unittest
+from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence\
+    .weight_dependence_multiplicative import WeightDependenceMultiplicative
+
+STDP_FIXED_POINT = 11
+WEIGHT_MULTIPLY_RIGHT_SHIFT = 10
+WEIGHT_SCALE = 1 << 10
+MIN_WEIGHT = 0
+MAX_WEIGHT = 4 * WEIGHT_SCALE
+
+
+def _int16(x):
+    """ The bottom 16 bits of a value, as a signed value, as the 16-bit\
+        multiplies of maths.h use it
+    """
+    return ((x + 0x8000) & 0xFFFF) - 0x8000
+
+
+def _mul(a, b):
+    """ STDP_FIXED_MUL_16X16, which multiplies the bottom 16 bits of each
+    """
+    return (_int16(a) * _int16(b)) >> STDP_FIXED_POINT
+
+
+def _mul32x16(a, b):
+    """ STDP_FIXED_MUL_32X16, which multiplies all of a by the bottom 16 bits\
+        of b
+    """
+    return (a * _int16(b)) >> STDP_FIXED_POINT
+
+
+def _fixed_mul16(a, b):
+    return (_int16(a) * _int16(b)) >> WEIGHT_MULTIPLY_RIGHT_SHIFT
+
+
+def _per_event(weight, events, a2_plus, a2_minus):
+    """ Apply each (is_potentiation, amount) event in turn, as\
+        weight_multiplicative_impl.h does by default
+    """
+    for is_potentiation, amount in events:
+        if is_potentiation:
+            weight += _mul(_fixed_mul16(MAX_WEIGHT - weight, a2_plus), amount)
+        else:
+            weight -= _mul(_fixed_mul16(weight - MIN_WEIGHT, a2_minus), amount)
+    return weight
+
+
+def _deferred(weight, events, a2_plus, a2_minus):
+    """ Apply the events together, as weight_multiplicative_impl.h does with\
+        WEIGHT_UPDATES_DEFERRED
+    """
+    potentiation = sum(amount for is_pot, amount in events if is_pot)
+    depression = sum(amount for is_pot, amount in events if not is_pot)
+    new_weight = (
+        weight +
+        _mul32x16(potentiation, _fixed_mul16(MAX_WEIGHT - weight, a2_plus)) -
+        _mul32x16(depression, _fixed_mul16(weight - MIN_WEIGHT, a2_minus)))
+    return min(MAX_WEIGHT, max(new_weight, MIN_WEIGHT))
+
+
+class TestWeightMultiplicativeDeferred(unittest.TestCase):
+
+    def test_executable_suffix(self):
+        self.assertEqual(
+            WeightDependenceMultiplicative().vertex_executable_suffix,
+            "multiplicative")
+        deferred = WeightDependenceMultiplicative(deferred=True)
+        self.assertEqual(
+            deferred.vertex_executable_suffix, "multiplicative_deferred")
+        self.assertFalse(
+            deferred.is_same_as(WeightDependenceMultiplicative()))
+
+    def test_single_event_exact(self):
+        a2_plus = int(0.05 * WEIGHT_SCALE)
+        a2_minus = int(0.06 * WEIGHT_SCALE)
+        for weight in range(MIN_WEIGHT, MAX_WEIGHT + 1, 97):
+            for event in ((True, 2048), (False, 2048), (True, 300)):
+                self.assertEqual(
+                    _per_event(weight, [event], a2_plus, a2_minus),
+                    _deferred(weight, [event], a2_plus, a2_minus))
+
+    def test_close_to_per_event(self):
+        rng = random.Random(11)
+        learning_rate = 0.02
+        a2_plus = int(learning_rate * WEIGHT_SCALE)
+        a2_minus = int(learning_rate * WEIGHT_SCALE)
+        for _ in range(1000):
+            weight = rng.randint(MIN_WEIGHT, MAX_WEIGHT)
+            events = [(rng.random() < 0.5, rng.randint(0, 4096))
+                      for _ in range(rng.randint(1, 6))]
+            per_event = _per_event(weight, events, a2_plus, a2_minus)
+            deferred = _deferred(weight, events, a2_plus, a2_minus)
+            self.assertTrue(MIN_WEIGHT <= deferred <= MAX_WEIGHT)
+
+            # The difference is of the order of the square of the learning
+            # rate times the total of the events, plus the rounding of each
+            total = sum(amount for _, amount in events) / 2048.0
+            bound = (MAX_WEIGHT * (learning_rate * total) ** 2) + len(events)
+            self.assertLessEqual(abs(per_event - deferred), bound)
+
+    def test_large_sums(self):
+
+        # Many events sum to more than 16 bits, which must not wrap, so the
+        # result is that of the sum scaled in full
+        a2_plus = int(0.01 * WEIGHT_SCALE)
+        a2_minus = int(0.01 * WEIGHT_SCALE)
+        weight = MAX_WEIGHT // 2
+        events = [(True, 2048)] * 40
+        potentiation = 40 * 2048
+        self.assertGreater(potentiation, 0x7FFF)
+        scale = _fixed_mul16(MAX_WEIGHT - weight, a2_plus)
+        self.assertEqual(
+            _deferred(weight, events, a2_plus, a2_minus),
+            weight + ((potentiation * scale) >> STDP_FIXED_POINT))
+        self.assertGreater(
+            _deferred(weight, events, a2_plus, a2_minus),
+            _deferred(weight, events[:20], a2_plus, a2_minus))
+        self.assertEqual(
+            _deferred(weight, [(False, 2048)] * 40, a2_plus, a2_minus),
+            weight - ((potentiation * scale) >> STDP_FIXED_POINT))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,131 @@
+import unittest
+from spynnaker.pyNN.models.neuron import atoms_per_core_solver
+from spynnaker.pyNN.models.neuron.atoms_per_core_solver \
+    import AtomsPerCoreSolver
+
+# A 1ms timestep at 200MHz with all of it available gives 200000 cycles
+_CPU_BUDGET = 200000
+
+
+class _Vertex(object):
+    """ A vertex whose usage is a fixed amount plus an amount per atom
+    """
+
+    def __init__(self, n_atoms, max_atoms_per_core, dtcm=(0, 0),
+                 sdram=(0, 0), cpu=(0, 0)):
+        self.label = "test"
+        self.n_atoms = n_atoms
+        self._max_atoms_per_core = max_atoms_per_core
+        self._dtcm = dtcm
+        self._sdram = sdram
+        self._cpu = cpu
+        self.constraints = list()
+        self.n_atoms_used = list()
+
+    def _usage(self, usage, vertex_slice):
+        self.n_atoms_used.append(vertex_slice.n_atoms)
+        return usage[0] + (usage[1] * vertex_slice.n_atoms)
+
+    def get_max_atoms_per_core(self):
+        return self._max_atoms_per_core
+
+    def get_dtcm_usage_for_atoms(self, vertex_slice, graph):
+        return self._usage(self._dtcm, vertex_slice)
+
+    def get_sdram_usage_for_atoms_without_recording(
+            self, vertex_slice, graph):
+        return self._usage(self._sdram, vertex_slice)
+
+    def get_cpu_usage_for_atoms(self, vertex_slice, graph):
+        return self._usage(self._cpu, vertex_slice)
+
+    def add_constraint(self, constraint):
+        self.constraints.append(constraint)
+
+
+class TestAtomsPerCoreSolver(unittest.TestCase):
+
+    def setUp(self):
+        self.solver = AtomsPerCoreSolver(1000, 1, 1.0, sdram_bytes=1000000)
+
+    def test_budget(self):
+        self.assertEqual(
+            self.solver.budget[atoms_per_core_solver.CPU], _CPU_BUDGET)
+        self.assertEqual(
+            self.solver.budget[atoms_per_core_solver.SDRAM], 1000000)
+
+    def test_population_fits(self):
+        vertex = _Vertex(100, 256, cpu=(1000, 100))
+        solution = self.solver.solve(vertex, None)
+        self.assertEqual(solution.max_atoms_per_core, 100)
+        self.assertEqual(
+            solution.binding_resource, atoms_per_core_solver.POPULATION_SIZE)
+
+    def test_model_maximum_fits(self):
+        vertex = _Vertex(1000, 256, cpu=(1000, 100))
+        solution = self.solver.solve(vertex, None)
+        self.assertEqual(solution.max_atoms_per_core, 256)
+        self.assertEqual(
+            solution.binding_resource, atoms_per_core_solver.MODEL_MAXIMUM)
+
+    def test_cpu_binds(self):
+
+        # 1000 + 1000n <= 200000 for n <= 199
+        vertex = _Vertex(1000, 256, cpu=(1000, 1000), sdram=(0, 100))
+        solution = self.solver.solve(vertex, None)
+        self.assertEqual(solution.max_atoms_per_core, 199)
+        self.assertEqual(
+            solution.binding_resource, atoms_per_core_solver.CPU)
+        self.assertEqual(
+            solution.usage[atoms_per_core_solver.CPU], 1000 + 199 * 1000)
+
+    def test_tightest_resource_binds(self):
+
+        # SDRAM allows 99 atoms, CPU allows 199
+        vertex = _Vertex(
+            1000, 256, cpu=(1000, 1000), sdram=(10000, 10000))
+        solution = self.solver.solve(vertex, None)
+        self.assertEqual(solution.max_atoms_per_core, 99)
+        self.assertEqual(
+            solution.binding_resource, atoms_per_core_solver.SDRAM)
+
+        # DTCM allows 50 atoms
+        vertex = _Vertex(
+            1000, 256, cpu=(1000, 1000), sdram=(10000, 10000),
+            dtcm=(0, atoms_per_core_solver._DTCM_BYTES // 50))
+        solution = self.solver.solve(vertex, None)
+        self.assertEqual(solution.max_atoms_per_core, 50)
+        self.assertEqual(
+            solution.binding_resource, atoms_per_core_solver.DTCM)
+
+    def test_monotonic_search(self):
+
+        # The search only asks about numbers of atoms between 1 and the
+        # model maximum, and finds the largest that fits
+        for per_atom in (1, 7, 333, 1999, 100000):
+            vertex = _Vertex(1000, 256, cpu=(0, per_atom))
+            solution = self.solver.solve(vertex, None)
+            expected = min(256, _CPU_BUDGET // per_atom)
+            self.assertEqual(solution.max_atoms_per_core, expected)
+            self.assertTrue(all(
+                1 <= n <= 256 for n in vertex.n_atoms_used))
+
+    def test_one_atom_does_not_fit(self):
+        vertex = _Vertex(1000, 256, cpu=(_CPU_BUDGET, 1))
+        solution = self.solver.solve(vertex, None)
+        self.assertEqual(solution.max_atoms_per_core, 1)
+        self.assertEqual(
+            solution.binding_resource, atoms_per_core_solver.CPU)
+
+    def test_apply_constrains_smaller_solutions(self):
+        small = _Vertex(1000, 256, cpu=(0, 2000))
+        large = _Vertex(10, 256, cpu=(0, 2000))
+        solutions = self.solver.apply([small, large], None)
+        self.assertEqual(
+            [s.max_atoms_per_core for s in solutions], [100, 10])
+        self.assertEqual(len(small.constraints), 1)
+        self.assertEqual(len(large.constraints), 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
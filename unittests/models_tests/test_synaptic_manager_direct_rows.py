@@ -0,0 +1,169 @@
+import unittest
+import numpy
+from spynnaker.pyNN.models.neuron.synaptic_manager import SynapticManager
+from spynnaker.pyNN.models.neuron.synapse_io.synapse_io_row_based \
+    import SynapseIORowBased
+from spynnaker.pyNN.models.neuron.master_pop_table_generators\
+    .master_pop_table_as_binary_search import MasterPopTableAsBinarySearch
+from spynnaker.pyNN.models.neural_projections.connectors.abstract_connector \
+    import AbstractConnector
+from spynnaker.pyNN.models.neuron.synapse_dynamics.synapse_dynamics_static \
+    import SynapseDynamicsStatic
+from spynnaker.pyNN.models.neural_projections\
+    .projection_partitionable_edge import ProjectionPartitionableEdge
+from pacman.model.graph_mapper.slice import Slice
+
+
+class _SynapseIO(object):
+
+    def get_maximum_delay_supported_in_ms(self):
+        return 16
+
+
+class _Connector(object):
+    """ One synapse from each source with a delay of at most 16, and two\
+        from each with a longer delay
+    """
+
+    def get_n_connections_from_pre_vertex_maximum(
+            self, pre_slices, pre_slice_index, post_slices,
+            post_slice_index, pre_vertex_slice, post_vertex_slice,
+            min_delay=None, max_delay=None):
+        if max_delay <= 16:
+            return 1
+        return 2
+
+
+class _OneToOneConnector(object):
+    """ One synapse from each source to the target of the same index,\
+        the first with zero weight and a delay of 16, and none from the\
+        last source
+    """
+
+    def create_synaptic_block(
+            self, pre_slices, pre_slice_index, post_slices,
+            post_slice_index, pre_vertex_slice, post_vertex_slice,
+            synapse_type):
+        block = numpy.zeros(
+            pre_vertex_slice.n_atoms - 1,
+            dtype=AbstractConnector.NUMPY_SYNAPSES_DTYPE)
+        block["source"] = numpy.arange(len(block))
+        block["target"] = numpy.arange(len(block))
+        block["weight"] = numpy.arange(len(block))
+        block["delay"] = 16
+        block["delay"][1:] = 1
+        block["synapse_type"] = synapse_type
+        return block
+
+
+class _SynapseType(object):
+
+    def __init__(self, n_synapse_types):
+        self._n_synapse_types = n_synapse_types
+
+    def get_n_synapse_types(self):
+        return self._n_synapse_types
+
+
+class _SynapseInfo(object):
+
+    def __init__(self, connector=None):
+        self.synapse_dynamics = SynapseDynamicsStatic()
+        self.connector = connector or _Connector()
+        self.synapse_type = 0
+
+
+class _Edge(ProjectionPartitionableEdge):
+
+    def __init__(self, n_delay_stages):
+        self._synapse_information = [_SynapseInfo()]
+        self._n_delay_stages = n_delay_stages
+
+    @property
+    def n_delay_stages(self):
+        return self._n_delay_stages
+
+
+def _manager(direct_matrix_max_bytes, n_synapse_types=2):
+    manager = SynapticManager.__new__(SynapticManager)
+    manager._synapse_io = _SynapseIO()
+    manager._synapse_type = _SynapseType(n_synapse_types)
+    manager._direct_matrix_max_bytes = direct_matrix_max_bytes
+    manager._get_estimated_slices = lambda edge, post_slice: (
+        [Slice(0, 99)], [post_slice], 0)
+    return manager
+
+
+class TestSynapticManagerDirectRows(unittest.TestCase):
+
+    def test_estimated_blocks(self):
+        manager = _manager(400)
+        edge = _Edge(3)
+        blocks = list(manager._get_estimated_row_blocks(
+            Slice(0, 9), [edge]))
+        self.assertEqual(blocks, [
+            (edge.synapse_information[0], [(1, 100), (2, 300)])])
+
+    def test_undelayed_block_is_direct(self):
+
+        # The undelayed rows fit in the direct matrix on their own, and the
+        # delayed rows are too long to be direct, as when they are written
+        manager = _manager(400)
+        synapse_info, blocks = next(manager._get_estimated_row_blocks(
+            Slice(0, 9), [_Edge(3)]))
+        self.assertEqual(
+            manager._choose_direct_blocks(synapse_info, blocks, 0),
+            ([True, False], 100))
+
+    def test_direct_matrix_full(self):
+        manager = _manager(400)
+        synapse_info = _SynapseInfo()
+        self.assertEqual(
+            manager._choose_direct_blocks(
+                synapse_info, [(1, 60), (1, 60)], 0),
+            ([True, False], 60))
+        self.assertEqual(
+            manager._choose_direct_blocks(
+                synapse_info, [(1, 60), (0, 0), (1, 40)], 0),
+            ([True, False, True], 100))
+
+    def test_no_bit_for_empty_rows(self):
+
+        # With 16 synapse types, the delay, type and index fill the bits
+        # below the weight, so there is no word for an empty row
+        manager = _manager(400, n_synapse_types=16)
+        self.assertIsNone(manager._get_direct_row_empty())
+        self.assertEqual(
+            manager._choose_direct_blocks(_SynapseInfo(), [(1, 60)], 0),
+            ([False], 0))
+
+    def test_read_back_direct_rows(self):
+
+        # The synapse with zero weight, a delay of 16 and a target index of 0
+        # is written as the word 0, which must not be taken as an empty row
+        manager = _manager(400)
+        synapse_info = _SynapseInfo(_OneToOneConnector())
+        pre_slice = Slice(0, 9)
+        post_slice = Slice(0, 9)
+        synapse_io = SynapseIORowBased(1000)
+        row_data, row_length, _, _, _, _ = synapse_io.get_synapses(
+            synapse_info, [pre_slice], 0, [post_slice], 0, pre_slice,
+            post_slice, 0, MasterPopTableAsBinarySearch(), 2, [1, 1])
+        self.assertEqual(row_length, 1)
+        single_rows = manager._get_direct_rows(row_data)
+        self.assertEqual(single_rows[0], 0)
+        self.assertEqual(single_rows[9], manager._get_direct_row_empty())
+
+        block = manager._get_rows_from_direct_block(
+            bytearray(single_rows.tobytes()))
+        connections = synapse_io.read_synapses(
+            synapse_info, pre_slice, post_slice, 1, 0, 2, [1, 1], block,
+            None, 0)
+        self.assertEqual(list(connections["source"]), list(range(9)))
+        self.assertEqual(list(connections["target"]), list(range(9)))
+        self.assertEqual(list(connections["weight"]), list(range(9)))
+        self.assertEqual(list(connections["delay"]), [16] + [1] * 8)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,65 @@
+import threading
+import unittest
+from spynnaker.pyNN.utilities import batched_memory_reader
+from spynnaker.pyNN.utilities.batched_memory_reader import BatchedMemoryReader
+
+
+class _MockTransceiver(object):
+    """ Memory of each chip holding the low byte of each address
+    """
+
+    def __init__(self):
+        self.reads = list()
+        self._lock = threading.Lock()
+
+    def read_memory(self, x, y, address, n_bytes):
+        with self._lock:
+            self.reads.append((x, y, address, n_bytes))
+        return bytearray(
+            (x + y + i) & 0xFF for i in range(address, address + n_bytes))
+
+
+class TestBatchedMemoryReader(unittest.TestCase):
+
+    def test_coalesce_ranges(self):
+        reads = batched_memory_reader.coalesce_ranges(
+            [(1000, 100), (0, 100), (120, 80), (5000, 10)], 64, 4096)
+        self.assertEqual(reads, [
+            (0, 200, [(1, 0), (2, 120)]),
+            (1000, 100, [(0, 0)]),
+            (5000, 10, [(3, 0)])])
+
+    def test_coalesce_limits_read_size(self):
+        reads = batched_memory_reader.coalesce_ranges(
+            [(0, 100), (100, 100), (200, 300)], 0, 256)
+        self.assertEqual(reads, [
+            (0, 200, [(0, 0), (1, 100)]),
+            (200, 300, [(2, 0)])])
+
+    def test_read(self):
+        transceiver = _MockTransceiver()
+        reader = BatchedMemoryReader(256, 65536, 4)
+        ranges = [
+            (0, 0, 0x1000, 16), (0, 0, 0x1020, 32), (1, 0, 0x2000, 8),
+            (0, 0, 0x8000, 4), (1, 0, 0x2008, 8)]
+        range_ids = [reader.add_range(*r) for r in ranges]
+        reader.read(transceiver)
+
+        self.assertEqual(sorted(transceiver.reads), [
+            (0, 0, 0x1000, 64), (0, 0, 0x8000, 4), (1, 0, 0x2000, 16)])
+        for (x, y, address, n_bytes), range_id in zip(ranges, range_ids):
+            self.assertEqual(
+                reader.get_data(range_id),
+                transceiver.read_memory(x, y, address, n_bytes))
+
+    def test_map_over_chips(self):
+        chips = [(x, y) for x in range(4) for y in range(4)]
+        for n_threads in (1, 8):
+            self.assertEqual(
+                batched_memory_reader.map_over_chips(
+                    lambda chip: chip[0] * 10 + chip[1], chips, n_threads),
+                [x * 10 + y for (x, y) in chips])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,37 @@
+import unittest
+from spynnaker.pyNN.utilities import input_buffer_losses
+from spynnaker.pyNN.utilities.input_buffer_losses import InputBufferLosses
+
+
+class TestInputBufferLosses(unittest.TestCase):
+
+    def test_no_losses(self):
+        words = [256] + [0] * 4 + [0xFFFFFFFF] + \
+            [0] * (input_buffer_losses.N_REPORTED_RANGES + 1)
+        self.assertEqual(len(words), input_buffer_losses.N_PROVENANCE_WORDS)
+        losses = InputBufferLosses(words)
+        self.assertEqual(losses.buffer_size, 256)
+        self.assertEqual(losses.n_ticks_with_losses, 0)
+        self.assertIsNone(losses.first_tick_with_losses)
+
+    def test_decode(self):
+        range_losses = range(input_buffer_losses.N_REPORTED_RANGES)
+        words = [512, 10, 3, 40, 17, 12] + range_losses + [5]
+        losses = InputBufferLosses(words)
+        self.assertEqual(losses.buffer_size, 512)
+        self.assertEqual(losses.n_early_drops, 10)
+        self.assertEqual(losses.n_ticks_with_losses, 3)
+        self.assertEqual(losses.max_losses_in_a_tick, 40)
+        self.assertEqual(losses.tick_of_max_losses, 17)
+        self.assertEqual(losses.first_tick_with_losses, 12)
+        self.assertEqual(losses.range_losses, range_losses)
+        self.assertEqual(losses.other_losses, 5)
+
+    def test_policies_match_core(self):
+        self.assertEqual(
+            input_buffer_losses.POLICIES,
+            ["drop_newest", "drop_oldest", "priority"])
+
+
+if __name__ == '__main__':
+    unittest.main()
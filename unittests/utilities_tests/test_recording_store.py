@@ -0,0 +1,59 @@
+import shutil
+import tempfile
+import unittest
+import numpy
+from spynnaker.pyNN.utilities.recording_store import RecordingStore
+from spynnaker.pyNN.utilities.recording_store import RecordingStoreWriter
+
+
+def _expected_rows(cores, n_values):
+    """ Build the (atom, time, value...) rows of cores of\
+        (lo_atom, times, values) the way get_v and get_gsyn used to
+    """
+    rows = list()
+    for lo_atom, times, values in cores:
+        values = values.reshape((len(times), -1, n_values))
+        for row, time in enumerate(times):
+            for atom in range(values.shape[1]):
+                rows.append([lo_atom + atom, time] + list(values[row, atom]))
+    rows = numpy.array(rows, dtype="float64")
+    return rows[numpy.lexsort((rows[:, 1], rows[:, 0]))]
+
+
+class TestRecordingStore(unittest.TestCase):
+
+    def setUp(self):
+        self._directory = tempfile.mkdtemp()
+        times = numpy.arange(10) * 0.5
+        self._cores = [
+            (5, times, numpy.random.random((10, 3 * 2))),
+            (0, times, numpy.random.random((10, 5 * 2)))]
+        writer = RecordingStoreWriter(self._directory, 2)
+        for lo_atom, times, values in self._cores:
+            writer.add_core(lo_atom, times, values)
+        self._store = writer.close()
+
+    def tearDown(self):
+        shutil.rmtree(self._directory)
+
+    def test_read_all(self):
+        self.assertEqual(self._store.n_values, 2)
+        self.assertEqual(self._store.n_atoms, 8)
+        self.assertTrue(numpy.allclose(
+            self._store.read(), _expected_rows(self._cores, 2)))
+
+    def test_read_range(self):
+        expected = _expected_rows(self._cores, 2)
+        mask = ((expected[:, 0] >= 3) & (expected[:, 0] < 7) &
+                (expected[:, 1] >= 1.0) & (expected[:, 1] < 3.0))
+        store = RecordingStore(self._directory)
+        self.assertTrue(numpy.allclose(
+            store.read(min_atom=3, max_atom=7, min_time=1.0, max_time=3.0),
+            expected[mask]))
+
+    def test_read_empty_range(self):
+        self.assertEqual(self._store.read(min_time=100.0).shape, (0, 4))
+
+
+if __name__ == '__main__':
+    unittest.main()
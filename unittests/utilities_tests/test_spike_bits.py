@@ -0,0 +1,57 @@
+import unittest
+import numpy
+from spynnaker.pyNN.utilities import spike_bits
+
+
+def _decode_by_unpacking(words):
+    """ The bit expansion that spike_bits replaces
+    """
+    n_words = words.shape[1]
+    spikes = words.astype("<u4").byteswap().view("uint8")
+    bits = numpy.fliplr(numpy.unpackbits(spikes).reshape(
+        (-1, 32))).reshape((-1, n_words * 32))
+    return numpy.where(bits == 1)
+
+
+class TestSpikeBits(unittest.TestCase):
+
+    def test_single_bits(self):
+        words = numpy.zeros((32, 1), dtype="uint32")
+        for bit in range(32):
+            words[bit, 0] = 1 << bit
+        rows, ids = spike_bits.decode_spikes(words)
+        self.assertEqual(list(rows), range(32))
+        self.assertEqual(list(ids), range(32))
+
+    def test_matches_unpacking(self):
+        words = numpy.random.randint(
+            0, 0xFFFFFFFF, size=(50, 3)).astype("uint32")
+        words[10, :] = 0
+        words[11, :] = 0xFFFFFFFF
+        rows, ids = spike_bits.decode_spikes(words)
+        expected_rows, expected_ids = _decode_by_unpacking(words)
+        self.assertTrue(numpy.array_equal(rows, expected_rows))
+        self.assertTrue(numpy.array_equal(ids, expected_ids))
+
+    def test_chunks(self):
+        words = numpy.random.randint(
+            0, 0xFFFFFFFF, size=(20, 5)).astype("uint32")
+        chunk_words = spike_bits._CHUNK_WORDS
+        spike_bits._CHUNK_WORDS = 7
+        try:
+            rows, ids = spike_bits.decode_spikes(words)
+        finally:
+            spike_bits._CHUNK_WORDS = chunk_words
+        expected_rows, expected_ids = _decode_by_unpacking(words)
+        self.assertTrue(numpy.array_equal(rows, expected_rows))
+        self.assertTrue(numpy.array_equal(ids, expected_ids))
+
+    def test_no_spikes(self):
+        rows, ids = spike_bits.decode_spikes(
+            numpy.zeros((10, 2), dtype="uint32"))
+        self.assertEqual(len(rows), 0)
+        self.assertEqual(len(ids), 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,90 @@
+import os
+import shutil
+import tempfile
+import unittest
+import numpy
+from spynnaker.pyNN.utilities import spike_file
+
+
+_SPIKES = """# first_id = 0
+# n = 4
+2.0\t1.0
+1.0\t0.0
+5.0\t3.0
+3.0\t1.0
+0.5\t1.0
+
+7.0\t2.0
+"""
+
+_DATA = """# first_id = 0
+1.0\t1.0\t-60.0
+0.0\t1.0\t-65.0
+0.0\t0.0\t-64.0
+2.0\t2.0\t-50.0
+"""
+
+
+class TestSpikeFile(unittest.TestCase):
+
+    def setUp(self):
+        self._directory = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self._directory)
+
+    def _write(self, name, text):
+        path = os.path.join(self._directory, name)
+        with open(path, "w") as target:
+            target.write(text)
+        return path
+
+    def _check_spikes(self, spikes, expected):
+        self.assertEqual(len(spikes), len(expected))
+        for times, expected_times in zip(spikes, expected):
+            self.assertEqual(list(times), expected_times)
+
+    def test_read_all_spikes(self):
+        path = self._write("spikes.txt", _SPIKES)
+        self._check_spikes(
+            spike_file.read_spikes(path),
+            [[1.0], [2.0, 3.0, 0.5], [7.0], [5.0]])
+
+    def test_read_selected_spikes(self):
+        path = self._write("spikes.txt", _SPIKES)
+        self._check_spikes(
+            spike_file.read_spikes(
+                path, min_atom=1, max_atom=3, min_time=1.0, max_time=7.0),
+            [[], [2.0, 3.0], []])
+
+    def test_other_separator(self):
+        path = self._write("spikes.csv", _SPIKES.replace("\t", ","))
+        self._check_spikes(
+            spike_file.read_spikes(path, split_value=","),
+            [[1.0], [2.0, 3.0, 0.5], [7.0], [5.0]])
+
+    def test_binary_matches_text(self):
+        text_path = self._write("spikes.txt", _SPIKES)
+        binary_path = os.path.join(self._directory, "spikes.bin")
+        self.assertEqual(spike_file.convert_spike_file_to_binary(
+            text_path, binary_path), 6)
+        self.assertTrue(spike_file.is_binary_spike_file(binary_path))
+        self.assertFalse(spike_file.is_binary_spike_file(text_path))
+        self._check_spikes(
+            spike_file.read_spikes(binary_path, max_atom=2, max_time=3.0),
+            [[1.0], [2.0, 0.5]])
+
+    def test_inconsistent_records(self):
+        path = self._write("spikes.txt", "1.0\t2.0\n3.0\n")
+        with self.assertRaises(ValueError):
+            spike_file.read_spikes(path)
+
+    def test_read_data(self):
+        path = self._write("v.txt", _DATA)
+        data = spike_file.read_data(path, 0, 2, 0.0, 2.0)
+        self.assertTrue(numpy.array_equal(data, [
+            [0.0, 0.0, -64.0], [1.0, 0.0, -65.0], [1.0, 1.0, -60.0]]))
+
+
+if __name__ == '__main__':
+    unittest.main()
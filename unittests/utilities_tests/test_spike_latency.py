@@ -0,0 +1,52 @@
+import unittest
+from spynnaker.pyNN.utilities import log2_histogram
+from spynnaker.pyNN.utilities import spike_latency
+from spynnaker.pyNN.utilities.spike_latency import SpikeLatencies
+
+
+def _words(n_spikes, max_cycles, bin_index):
+    words = [n_spikes, 200]
+    for _ in spike_latency.STAGES:
+        histogram = [0] * log2_histogram.N_BINS
+        histogram[bin_index] = n_spikes
+        words.append(max_cycles)
+        words.extend(histogram)
+    return words
+
+
+class TestSpikeLatency(unittest.TestCase):
+
+    def test_not_measured(self):
+        words = [0] * spike_latency.N_PROVENANCE_WORDS
+        self.assertIsNone(SpikeLatencies.from_provenance_words(words))
+
+    def test_decode_and_merge(self):
+        words = _words(10, 4000, 3)
+        self.assertEqual(len(words), spike_latency.N_PROVENANCE_WORDS)
+        first = SpikeLatencies.from_provenance_words(words)
+        self.assertEqual(first.n_spikes, 10)
+        self.assertEqual(first.max_us("queued"), 20.0)
+
+        # 64 cycles at 200MHz is 0.32us, so bin 3 ends at 8 * 0.32us
+        self.assertAlmostEqual(first.percentile_us("total", 0.99), 2.56)
+
+        second = SpikeLatencies.from_provenance_words(_words(990, 100000, 15))
+        merged = SpikeLatencies.merge([first, second])
+        self.assertEqual(merged.n_spikes, 1000)
+        self.assertEqual(merged.histogram("dma")[3], 10)
+        self.assertEqual(merged.histogram("dma")[15], 990)
+
+        # The 99th percentile is in the unbounded last bin, so is the maximum
+        self.assertEqual(merged.percentile_us("dma", 0.99), 500.0)
+        self.assertAlmostEqual(merged.percentile_us("dma", 0.01), 2.56)
+
+    def test_bin_limits(self):
+        limits = log2_histogram.bin_limits(1)
+        self.assertEqual(limits[0], (0.0, 1.0))
+        self.assertEqual(limits[1], (1.0, 2.0))
+        self.assertEqual(limits[4], (8.0, 16.0))
+        self.assertEqual(limits[-1], (2.0 ** 14, None))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,40 @@
+import unittest
+from spynnaker.pyNN.utilities import tick_profile
+from spynnaker.pyNN.utilities.tick_profile import TickProfile
+
+
+class TestTickProfile(unittest.TestCase):
+
+    def test_not_profiled(self):
+        words = [0] * tick_profile.N_PROVENANCE_WORDS
+        self.assertIsNone(TickProfile.from_provenance_words(words))
+
+    def test_decode(self):
+        words = [100, 3, 7, 200]
+        for i in range(len(tick_profile.PHASES)):
+            histogram = [0] * tick_profile.N_HISTOGRAM_BINS
+            histogram[i] = 100
+            words.extend([200 * (i + 1), 400 * (i + 1), 300 * (i + 1)])
+            words.extend(histogram)
+        self.assertEqual(len(words), tick_profile.N_PROVENANCE_WORDS)
+
+        profile = TickProfile.from_provenance_words(words)
+        self.assertEqual(profile.n_ticks, 100)
+        self.assertEqual(profile.n_late_ticks, 3)
+        self.assertEqual(profile.n_spike_processing_busy_ticks, 7)
+        neurons = profile.phase("neurons")
+        self.assertEqual(neurons.min_us, 2.0)
+        self.assertEqual(neurons.max_us, 4.0)
+        self.assertEqual(neurons.mean_us, 3.0)
+        self.assertEqual(neurons.histogram[1], 100)
+
+        # 256 cycles at 200MHz is 1.28us
+        limits = neurons.histogram_bin_limits_us()
+        self.assertEqual(len(limits), tick_profile.N_HISTOGRAM_BINS)
+        self.assertAlmostEqual(limits[0][1], 1.28)
+        self.assertAlmostEqual(limits[2][0], 2.56)
+        self.assertIsNone(limits[-1][1])
+
+
+if __name__ == '__main__':
+    unittest.main()
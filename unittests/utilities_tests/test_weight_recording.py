@@ -0,0 +1,82 @@
+import struct
+import unittest
+from pacman.model.graph_mapper.slice import Slice
+from spynnaker.pyNN.models.common.weight_recorder import WeightRecorder
+from spynnaker.pyNN.utilities import weight_recording
+from spynnaker.pyNN.utilities.weight_recording import RecordedBlock
+
+
+def _entry(time, offset, synapses):
+    words = [time, offset, len(synapses)]
+    words.extend((weight << 16) | target for (target, weight) in synapses)
+    return words
+
+
+def _bytes(words):
+    return struct.pack("<{}I".format(len(words)), *words)
+
+
+class TestWeightRecording(unittest.TestCase):
+
+    def setUp(self):
+        self.first = object()
+        self.second = object()
+
+        # 10 sources of 16 bytes rows, with delayed rows of a second stage
+        self.blocks = [
+            RecordedBlock(
+                self.first, 64, 320, 16, Slice(10, 19), Slice(100, 199),
+                32.0),
+            RecordedBlock(
+                self.second, 1024, 80, 16, Slice(0, 4), Slice(100, 199),
+                1.0)]
+
+    def test_params_size(self):
+        self.assertEqual(weight_recording.get_params_size(0), 12)
+        self.assertEqual(weight_recording.get_params_size(3), 36)
+
+    def test_read_weight_changes(self):
+        data = _bytes(
+            _entry(5, 64 + 32, [(3, 64), (7, 96)]) +
+            _entry(6, 1024, [(1, 5)]) +
+            _entry(8, 64 + 240, [(0, 32)]))
+        changes = weight_recording.read_weight_changes(
+            data, self.blocks, self.first, 0.1)
+        self.assertEqual(len(changes), 3)
+        self.assertEqual(list(changes["source"]), [12, 12, 15])
+        self.assertEqual(list(changes["target"]), [103, 107, 100])
+        self.assertEqual(list(changes["weight"]), [2.0, 3.0, 1.0])
+        self.assertAlmostEqual(changes["time"][0], 0.5)
+        self.assertAlmostEqual(changes["time"][2], 0.8)
+
+        changes = weight_recording.read_weight_changes(
+            data, self.blocks, self.second, 0.1)
+        self.assertEqual(len(changes), 1)
+        self.assertEqual(changes["source"][0], 0)
+        self.assertEqual(changes["weight"][0], 5.0)
+
+    def test_read_no_changes(self):
+        changes = weight_recording.read_weight_changes(
+            b"", self.blocks, self.first, 1.0)
+        self.assertEqual(len(changes), 0)
+
+    def test_recorder_interval(self):
+        recorder = WeightRecorder(1000)
+        self.assertFalse(recorder.record_weights)
+        self.assertEqual(recorder.interval_ticks, 0)
+        self.assertEqual(recorder.get_sdram_usage_in_bytes(100), 0)
+
+        recorder.add_interval(10.0)
+        recorder.add_interval(20.0)
+        self.assertEqual(recorder.interval_ticks, 10)
+        recorder.add_interval(5.0)
+        self.assertEqual(recorder.interval_ticks, 5)
+
+        # A buffer for each of the 20 intervals and one for the end
+        self.assertEqual(
+            recorder.get_sdram_usage_in_bytes(100),
+            21 * weight_recording.BUFFER_BYTES)
+
+
+if __name__ == '__main__':
+    unittest.main()